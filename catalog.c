@@ -0,0 +1,732 @@
+/*
+ * The snapshot catalog of a module ("snapshot catalog" in rsyncd.conf).
+ *
+ * A file's versions are kept in its own <file>.backup/ directory (or in
+ * its directory's pack), which says nothing about which files the tree
+ * held at a given version.  With the catalog enabled the receiver appends
+ * one snapshot to <module>/.backup-catalog at the end of every backup
+ * run, and a restore reads the tree as of its version from there:
+ *
+ *	# rsync backup catalog 1
+ *	@ VERSION
+ *	+ ID SIZE MTIME MODE DIGEST PATH
+ *	- PATH
+ *	= VERSION COUNT
+ *
+ * A snapshot only records what changed since the one before it: a "+"
+ * line for each regular file whose version, size, mtime or mode changed
+ * (ID is the version_id() of the version a restore to VERSION gets, and
+ * SIZE and DIGEST are that version's, as in a MANIFEST), one for each
+ * directory whose contents the run sent (with ID 0), and a "-" line for
+ * each entry of such a directory that the run no longer had.  Entries of
+ * directories the run did not send are left as they were.  MODE is
+ * octal, PATH is relative to the module with "\" and newlines escaped,
+ * and COUNT is the number of lines in between; a snapshot without its
+ * "=" line (a run that died while writing it) is ignored.
+ *
+ * Replaying the snapshots up to a version gives the tree as of that
+ * version in one sequential read.  Snapshots are expected in version
+ * order, so a run with an older version than the newest snapshot does
+ * not add one.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, visit the http://fsf.org website.
+ */
+
+#include "rsync.h"
+#include "itypes.h"
+
+#define CATALOG_NAME ".backup-catalog"
+#define CATALOG_HEADER "# rsync backup catalog 1\n"
+#define CATALOG_LINE_MAX (2 * MAXPATHLEN + 256)
+
+extern char curr_dir[MAXPATHLEN];
+extern char *module_dir;
+extern char *backup_version;
+
+int snapshot_catalog = 0;
+
+static struct {
+	struct catalog_entry *ents;
+	int32 count, malloced;
+	struct hashtable *paths;	/* name_key() of path -> newest entry + 1 */
+	int64 last_id;			/* version id of the last snapshot */
+	int snapshots;			/* how many were replayed */
+	int sorted;			/* restore: ents sorted by entry_cmp() */
+} cat;
+
+/* The files and directories of this backup run, gathered from its file
+ * lists as the receiver finishes with them. */
+struct run_entry {
+	char *key;		/* path relative to the module */
+	char *fname;		/* path relative to the receiver */
+	OFF_T size;
+	time_t mtime;
+	uint32 mode;
+};
+
+static struct {
+	struct run_entry *ents;
+	int32 count, malloced;
+} run;
+
+/* The path of fname relative to the module, in buf; -1 if it is not in
+ * the module. */
+static int module_key(const char *fname, char *buf)
+{
+	char path[MAXPATHLEN];
+	int len;
+
+	if (!module_dir)
+		return -1;
+	if (*fname == '/')
+		strlcpy(path, fname, sizeof path);
+	else if (pathjoin(path, sizeof path, curr_dir, fname) >= sizeof path)
+		return -1;
+	clean_fname(path, CFN_COLLAPSE_DOT_DOT_DIRS);
+
+	len = strlen(module_dir);
+	while (len > 1 && module_dir[len-1] == '/')
+		len--;
+	if (len == 1 && *module_dir == '/')
+		len = 0;
+	if (strncmp(path, module_dir, len) != 0 || (path[len] != '/' && path[len] != '\0'))
+		return -1;
+	if (path[len] == '/')
+		len++;
+	if (strcmp(path + len, ".") == 0)
+		len = strlen(path);
+	strlcpy(buf, path + len, MAXPATHLEN);
+
+	return 0;
+}
+
+static void catalog_path(char *buf)
+{
+	pathjoin(buf, MAXPATHLEN, module_dir, CATALOG_NAME);
+}
+
+static void reset_catalog(void)
+{
+	int32 i;
+
+	for (i = 0; i < cat.count; i++)
+		free(cat.ents[i].path);
+	if (cat.ents)
+		free(cat.ents);
+	if (cat.paths)
+		hashtable_destroy(cat.paths);
+	memset(&cat, 0, sizeof cat);
+}
+
+/* The entry for path, or NULL (while snapshots are being replayed). */
+static struct catalog_entry *lookup(const char *path)
+{
+	struct ht_int64_node *node = hashtable_find(cat.paths, name_key(path), 0);
+	int32 i = node ? (int32)(long)node->data - 1 : -1;
+
+	while (i >= 0 && strcmp(cat.ents[i].path, path) != 0)
+		i = cat.ents[i].next;
+
+	return i >= 0 ? cat.ents + i : NULL;
+}
+
+/* The entry for path, added if it is new. */
+static struct catalog_entry *add_entry(const char *path)
+{
+	struct catalog_entry *e = lookup(path);
+	struct ht_int64_node *node;
+
+	if (e)
+		return e;
+	if (cat.count == cat.malloced) {
+		cat.malloced = cat.malloced ? cat.malloced * 2 : 1024;
+		if (!(cat.ents = realloc_array(cat.ents, struct catalog_entry, cat.malloced)))
+			out_of_memory("catalog add_entry");
+	}
+	e = cat.ents + cat.count;
+	memset(e, 0, sizeof e[0]);
+	if (!(e->path = strdup(path)))
+		out_of_memory("catalog add_entry");
+	e->csum_type = -1;
+	e->gone = 1;
+
+	node = hashtable_find(cat.paths, name_key(path), 1);
+	e->next = node->data ? (int32)(long)node->data - 1 : -1;
+	node->data = (void *)(long)++cat.count;
+
+	return e;
+}
+
+static void write_escaped(FILE *fp, const char *path)
+{
+	for ( ; *path; path++) {
+		if (*path == '\\')
+			fputs("\\\\", fp);
+		else if (*path == '\n')
+			fputs("\\n", fp);
+		else
+			putc(*path, fp);
+	}
+}
+
+/* Undo write_escaped() in place. */
+static int unescape(char *path)
+{
+	char *t = path;
+
+	for ( ; *path; path++) {
+		if (*path == '\\') {
+			if (*++path == 'n')
+				*t++ = '\n';
+			else if (*path == '\\')
+				*t++ = '\\';
+			else
+				return -1;
+		} else
+			*t++ = *path;
+	}
+	*t = '\0';
+
+	return 0;
+}
+
+static void write_entry(FILE *fp, const struct catalog_entry *e)
+{
+	int i;
+
+	fprintf(fp, "+ %s %s %s %o ", do_big_num(e->id, 0, NULL), do_big_num(e->size, 0, NULL),
+		do_big_num(e->mtime, 0, NULL), (unsigned)e->mode);
+	if (e->csum_type < 0)
+		fputs("-", fp);
+	else {
+		int len = csum_len_for_type(e->csum_type, 0);
+		fprintf(fp, "%d:", e->csum_type);
+		for (i = 0; i < len; i++)
+			fprintf(fp, "%02x", (uchar)e->digest[i]);
+	}
+	putc(' ', fp);
+	write_escaped(fp, e->path);
+	putc('\n', fp);
+}
+
+static int parse_number(const char *str, int64 *num)
+{
+	int neg = *str == '-';
+
+	if (neg)
+		str++;
+	if (!isDigit(str))
+		return -1;
+	for (*num = 0; isDigit(str); str++)
+		*num = *num * 10 + (*str - '0');
+	if (neg)
+		*num = -*num;
+	return *str ? -1 : 0;
+}
+
+static int parse_digest(const char *str, struct catalog_entry *e)
+{
+	char *cp;
+	int i, len;
+
+	e->csum_type = -1;
+	if (strcmp(str, "-") == 0)
+		return 0;
+	e->csum_type = strtol(str, &cp, 10);
+	if (*cp++ != ':' || (len = strlen(cp) / 2) > MAX_DIGEST_LEN)
+		return -1;
+	for (i = 0; i < len; i++) {
+		unsigned int byte;
+		if (sscanf(cp + i*2, "%2x", &byte) != 1)
+			return -1;
+		e->digest[i] = (char)byte;
+	}
+
+	return 0;
+}
+
+/* Apply one "+" or "-" line of a complete snapshot. */
+static int apply_line(char *line)
+{
+	char id_str[32], size_str[32], mtime_str[32], digest_str[2*MAX_DIGEST_LEN+16];
+	struct catalog_entry *e, tmp;
+	int64 id, size, mtime;
+	unsigned int mode;
+	int n = 0;
+
+	if (*line == '-' && line[1] == ' ') {
+		if (unescape(line + 2) < 0)
+			return -1;
+		if ((e = lookup(line + 2)) != NULL)
+			e->gone = 1;
+		return 0;
+	}
+	if (sscanf(line, "+ %31s %31s %31s %o %47s%n", id_str, size_str, mtime_str, &mode,
+		   digest_str, &n) != 5 || line[n] != ' ')
+		return -1;
+	if (parse_number(id_str, &id) < 0 || parse_number(size_str, &size) < 0
+	 || parse_number(mtime_str, &mtime) < 0 || parse_digest(digest_str, &tmp) < 0
+	 || unescape(line + n + 1) < 0)
+		return -1;
+
+	e = add_entry(line + n + 1);
+	e->id = id;
+	e->size = size;
+	e->mtime = (time_t)mtime;
+	e->mode = mode;
+	e->csum_type = tmp.csum_type;
+	memcpy(e->digest, tmp.digest, sizeof e->digest);
+	e->gone = 0;
+
+	return 0;
+}
+
+/* Replay the complete snapshots of fp, stopping at the first one newer
+ * than until.  Returns -1 if the catalog is not one. */
+static int replay(FILE *fp, int64 until)
+{
+	char line[CATALOG_LINE_MAX], version[BACKUP_VERSION_LEN];
+	char **pending = NULL;
+	int32 npending = 0, malloced = 0, i;
+	int64 id = -1;
+	int in_snapshot = 0, lineno = 0;
+	unsigned int count;
+
+	cat.paths = hashtable_create(1024, 1);
+	cat.last_id = -1;
+
+	while (fgets(line, sizeof line, fp)) {
+		int len = strlen(line);
+		if (lineno++ == 0) {
+			if (strcmp(line, CATALOG_HEADER) != 0)
+				return -1;
+			continue;
+		}
+		if (len == 0 || line[len-1] != '\n')
+			break;		/* cut short by a writer */
+		line[--len] = '\0';
+
+		if (*line == '@') {
+			/* A snapshot without its end was abandoned. */
+			for (i = 0; i < npending; i++)
+				free(pending[i]);
+			npending = 0;
+			if ((id = version_id(line + 2)) < 0 || id > until)
+				break;
+			in_snapshot = 1;
+		} else if (*line == '=') {
+			if (in_snapshot && sscanf(line, "= %31s %u", version, &count) == 2
+			 && (uint32)npending == count) {
+				for (i = 0; i < npending; i++) {
+					if (apply_line(pending[i]) < 0)
+						rprintf(FWARNING, "[yee-%s] catalog.c: bad line in %s: %s\n",
+							who_am_i(), CATALOG_NAME, pending[i]);
+				}
+				cat.last_id = id;
+				cat.snapshots++;
+			}
+			for (i = 0; i < npending; i++)
+				free(pending[i]);
+			npending = 0;
+			in_snapshot = 0;
+		} else if (in_snapshot) {
+			if (npending == malloced) {
+				malloced = malloced ? malloced * 2 : 1024;
+				if (!(pending = realloc_array(pending, char *, malloced)))
+					out_of_memory("catalog replay");
+			}
+			if (!(pending[npending++] = strdup(line)))
+				out_of_memory("catalog replay");
+		}
+	}
+
+	for (i = 0; i < npending; i++)
+		free(pending[i]);
+	if (pending)
+		free(pending);
+
+	return 0;
+}
+
+/* Entries are sorted by their parent directory's path, then by name, so
+ * that a directory's entries are next to each other. */
+static int parts_cmp(const char *a, const char *b)
+{
+	const char *sa = strrchr(a, '/'), *sb = strrchr(b, '/');
+	int la = sa ? sa - a : 0, lb = sb ? sb - b : 0;
+	int c = memcmp(a, b, MIN(la, lb));
+
+	if (c)
+		return c;
+	if (la != lb)
+		return la < lb ? -1 : 1;
+	return strcmp(sa ? sa + 1 : a, sb ? sb + 1 : b);
+}
+
+static int entry_cmp(const void *x, const void *y)
+{
+	return parts_cmp(((const struct catalog_entry *)x)->path, ((const struct catalog_entry *)y)->path);
+}
+
+static int path_cmp(const void *x, const void *y)
+{
+	return strcmp((*(struct catalog_entry * const *)x)->path, (*(struct catalog_entry * const *)y)->path);
+}
+
+/* Load the tree as of version for a restore.  Returns 1 if the catalog
+ * has a snapshot at or before version, else 0 (and the restore goes on
+ * without it). */
+int catalog_restore_open(const char *version)
+{
+	char path[MAXPATHLEN];
+	int32 i, j;
+	FILE *fp;
+
+	if (!snapshot_catalog || !version)
+		return 0;
+	catalog_path(path);
+	if (!(fp = fopen(path, "r")))
+		return 0;
+	if (replay(fp, version_id(version)) < 0 || !cat.snapshots) {
+		fclose(fp);
+		reset_catalog();
+		return 0;
+	}
+	fclose(fp);
+
+	/* Only what the version had is needed from here on. */
+	hashtable_destroy(cat.paths);
+	cat.paths = NULL;
+	for (i = j = 0; i < cat.count; i++) {
+		if (cat.ents[i].gone)
+			free(cat.ents[i].path);
+		else
+			cat.ents[j++] = cat.ents[i];
+	}
+	cat.count = j;
+	qsort(cat.ents, cat.count, sizeof cat.ents[0], entry_cmp);
+	cat.sorted = 1;
+
+	rprintf(FWARNING, "[yee-%s] catalog.c: %d snapshots, %d entries as of %s\n",
+		who_am_i(), cat.snapshots, cat.count, version);
+
+	return 1;
+}
+
+static struct catalog_entry *find_key(const char *key)
+{
+	struct catalog_entry tmp;
+
+	tmp.path = (char *)key;
+	return bsearch(&tmp, cat.ents, cat.count, sizeof cat.ents[0], entry_cmp);
+}
+
+/* The restore's entry for fname, or NULL.  *covered is set when the
+ * catalog knows fname's directory, so that a file it has no entry for
+ * did not exist at the restore's version. */
+struct catalog_entry *catalog_find(const char *fname, int *covered)
+{
+	char key[MAXPATHLEN];
+	struct catalog_entry *e, *dir;
+	char *slash;
+
+	*covered = 0;
+	if (!cat.sorted || module_key(fname, key) < 0)
+		return NULL;
+	e = find_key(key);
+	if ((slash = strrchr(key, '/')) != NULL)
+		*slash = '\0';
+	else
+		*key = '\0';
+	dir = find_key(key);
+	*covered = dir && S_ISDIR(dir->mode);
+
+	return e;
+}
+
+/* Fill in st for a regular file that the restore's version had but the
+ * module no longer does.  Returns -1 (with errno ENOENT) if there is no
+ * such file. */
+int catalog_stat(const char *fname, STRUCT_STAT *st)
+{
+	struct catalog_entry *e;
+	int covered;
+
+	if (!(e = catalog_find(fname, &covered)) || !S_ISREG(e->mode)) {
+		errno = ENOENT;
+		return -1;
+	}
+	memset(st, 0, sizeof st[0]);
+	st->st_mode = e->mode;
+	st->st_size = e->size;
+	st->st_mtime = e->mtime;
+	st->st_nlink = 1;
+	st->st_uid = getuid();
+	st->st_gid = getgid();
+
+	return 0;
+}
+
+/* Set *first to the entries of directory dir (relative to the current
+ * directory) and return how many there are, 0 if the catalog does not
+ * know dir. */
+int catalog_children(const char *dir, struct catalog_entry **first)
+{
+	char key[MAXPATHLEN];
+	struct catalog_entry *d;
+	int32 lo = 0, hi = cat.count, i;
+	int len;
+
+	if (!cat.sorted || module_key(dir, key) < 0
+	 || !(d = find_key(key)) || !S_ISDIR(d->mode))
+		return 0;
+	len = strlen(key);
+
+	/* The first entry whose parent sorts at or after dir. */
+	while (lo < hi) {
+		int32 mid = (lo + hi) / 2;
+		const char *p = cat.ents[mid].path, *s = strrchr(p, '/');
+		int plen = s ? s - p : 0;
+		int c = memcmp(p, key, MIN(plen, len));
+		if (c < 0 || (c == 0 && plen < len))
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo < cat.count && !*key && !*cat.ents[lo].path)
+		lo++;		/* the top directory itself */
+	for (i = lo; i < cat.count; i++) {
+		const char *p = cat.ents[i].path, *s = strrchr(p, '/');
+		int plen = s ? s - p : 0;
+		if (plen != len || memcmp(p, key, len) != 0)
+			break;
+	}
+	*first = cat.ents + lo;
+
+	return i - lo;
+}
+
+/* Gather the regular files and sent directories of flist, a file list
+ * the receiver of a backup run is done with. */
+void catalog_add_flist(struct file_list *flist)
+{
+	char fbuf[MAXPATHLEN], key[MAXPATHLEN];
+	int i;
+
+	if (!snapshot_catalog || !flist)
+		return;
+	for (i = 0; i < flist->used; i++) {
+		struct file_struct *file = flist->files[i];
+		struct run_entry *r;
+
+		if (!F_IS_ACTIVE(file) || !(S_ISREG(file->mode)
+		 || (S_ISDIR(file->mode) && file->flags & FLAG_CONTENT_DIR)))
+			continue;
+		f_name(file, fbuf);
+		if (module_key(fbuf, key) < 0)
+			continue;
+		if (run.count == run.malloced) {
+			run.malloced = run.malloced ? run.malloced * 2 : 1024;
+			if (!(run.ents = realloc_array(run.ents, struct run_entry, run.malloced)))
+				out_of_memory("catalog_add_flist");
+		}
+		r = run.ents + run.count++;
+		if (!(r->key = strdup(key)) || !(r->fname = strdup(fbuf)))
+			out_of_memory("catalog_add_flist");
+		r->size = F_LENGTH(file);
+		r->mtime = file->modtime;
+		r->mode = file->mode;
+	}
+}
+
+static void free_run(void)
+{
+	int32 i;
+
+	for (i = 0; i < run.count; i++) {
+		free(run.ents[i].key);
+		free(run.ents[i].fname);
+	}
+	if (run.ents)
+		free(run.ents);
+	memset(&run, 0, sizeof run);
+}
+
+static int lock_catalog(int fd)
+{
+	struct flock lock;
+
+	lock.l_type = F_WRLCK;
+	lock.l_whence = SEEK_SET;
+	lock.l_start = 0;
+	lock.l_len = 0;
+	lock.l_pid = 0;
+
+	while (fcntl(fd, F_SETLKW, &lock) < 0) {
+		if (errno != EINTR)
+			return -1;
+	}
+	return 0;
+}
+
+/* Write one file of this run to the snapshot if it changed. */
+static int write_run_file(FILE *fp, const struct run_entry *r)
+{
+	struct catalog_entry *e = lookup(r->key), now;
+	struct backup_version info;
+	STRUCT_STAT st;
+
+	/* Same size and mtime as last time: it kept its version. */
+	if (e && !e->gone && S_ISREG(e->mode) && e->size == r->size
+	 && e->mtime == r->mtime && e->mode == r->mode) {
+		e->seen = 1;
+		return 0;
+	}
+	if (backup_version_info(r->fname, backup_version, &info) < 0)
+		return 0;
+
+	/* The stored copy's mtime only matches the run's when it was
+	 * received, so a failed transfer is looked up again next time. */
+	memset(&now, 0, sizeof now);
+	now.id = info.id;
+	now.size = info.size;
+	now.mtime = do_stat(r->fname, &st) == 0 ? st.st_mtime : 0;
+	now.mode = r->mode;
+	now.csum_type = info.csum_type;
+	memcpy(now.digest, info.digest, sizeof now.digest);
+
+	e = add_entry(r->key);
+	e->seen = 1;
+	if (!e->gone && e->id == now.id && e->size == now.size && e->mtime == now.mtime
+	 && e->mode == now.mode && e->csum_type == now.csum_type
+	 && memcmp(e->digest, now.digest, sizeof e->digest) == 0)
+		return 0;
+	now.path = e->path;
+	now.next = e->next;
+	now.seen = 1;
+	*e = now;
+	write_entry(fp, e);
+
+	return 1;
+}
+
+/* Append this run's snapshot to the catalog.  Called by the receiver
+ * once all of the run's versions are stored. */
+int catalog_run_end(void)
+{
+	char path[MAXPATHLEN];
+	struct catalog_entry **order;
+	int64 run_id;
+	int32 i, n, lines = 0;
+	STRUCT_STAT st;
+	FILE *fp;
+	int fd, ret = 0;
+
+	if (!snapshot_catalog || !backup_version || !run.count) {
+		free_run();
+		return 0;
+	}
+	run_id = version_id(backup_version);
+
+	catalog_path(path);
+	if ((fd = do_open(path, O_RDWR|O_CREAT|O_APPEND, 0644)) < 0 || lock_catalog(fd) < 0
+	 || !(fp = fdopen(fd, "a+"))) {
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(path));
+		if (fd >= 0)
+			close(fd);
+		free_run();
+		return -1;
+	}
+
+	rewind(fp);
+	if (replay(fp, run_id) < 0 || cat.last_id > run_id) {
+		rprintf(FWARNING, "[yee-%s] catalog.c: not adding %s to %s, %s\n", who_am_i(), backup_version,
+			path, cat.last_id > run_id ? "it has newer snapshots" : "it is not a catalog");
+		fclose(fp);
+		reset_catalog();
+		free_run();
+		return -1;
+	}
+	/* A snapshot newer than run_id stops the replay before the end. */
+	fseeko(fp, 0, SEEK_END);
+	if (do_fstat(fd, &st) == 0 && st.st_size == 0)
+		fputs(CATALOG_HEADER, fp);
+	fprintf(fp, "@ %s\n", backup_version);
+
+	/* Directories first, so that their entries know they were sent. */
+	for (i = 0; i < run.count; i++) {
+		struct run_entry *r = run.ents + i;
+		struct catalog_entry *e;
+		if (!S_ISDIR(r->mode))
+			continue;
+		e = add_entry(r->key);
+		e->seen = 1;
+		if (!e->gone && e->id == 0 && e->mtime == r->mtime && e->mode == r->mode)
+			continue;
+		e->gone = 0;
+		e->id = 0;
+		e->size = 0;
+		e->mtime = r->mtime;
+		e->mode = r->mode;
+		e->csum_type = -1;
+		write_entry(fp, e);
+		lines++;
+	}
+	for (i = 0; i < run.count; i++) {
+		if (S_ISREG(run.ents[i].mode))
+			lines += write_run_file(fp, run.ents + i);
+	}
+
+	/* Whatever a sent directory (or a removed one) held that the run did
+	 * not have is gone; parents sort before their entries. */
+	if (!(order = new_array(struct catalog_entry *, cat.count + 1)))
+		out_of_memory("catalog_run_end");
+	for (i = n = 0; i < cat.count; i++) {
+		if (!cat.ents[i].gone && !cat.ents[i].seen && *cat.ents[i].path)
+			order[n++] = cat.ents + i;
+	}
+	qsort(order, n, sizeof order[0], path_cmp);
+	for (i = 0; i < n; i++) {
+		struct catalog_entry *e = order[i], *dir;
+		char *slash = strrchr(e->path, '/');
+		if (slash)
+			*slash = '\0';
+		dir = lookup(slash ? e->path : "");
+		if (slash)
+			*slash = '/';
+		if (!dir || !(dir->gone == 2 || (!dir->gone && dir->seen && S_ISDIR(dir->mode))))
+			continue;
+		e->gone = 2;
+		fputs("- ", fp);
+		write_escaped(fp, e->path);
+		putc('\n', fp);
+		lines++;
+	}
+	free(order);
+
+	fprintf(fp, "= %s %d\n", backup_version, lines);
+	if (fflush(fp) != 0 || ferror(fp)) {
+		rsyserr(FERROR_XFER, errno, "write %s", full_fname(path));
+		ret = -1;
+	}
+	if (fclose(fp) != 0)	/* drops the lock */
+		ret = -1;
+	rprintf(FWARNING, "[yee-%s] catalog.c: snapshot %s of %d entries, %d changed\n",
+		who_am_i(), backup_version, run.count, lines);
+
+	reset_catalog();
+	free_run();
+
+	return ret;
+}
@@ -24,6 +24,7 @@
 extern int checksum_seed;
 extern int protocol_version;
 extern int proper_seed_order;
+extern int fast_checksum;
 extern char *checksum_choice;
 
 #define CSUM_NONE 0
@@ -32,6 +33,7 @@ extern char *checksum_choice;
 #define CSUM_MD4_OLD 3
 #define CSUM_MD4 4
 #define CSUM_MD5 5
+#define CSUM_XXH3 7
 
 int xfersum_type = 0; /* used for the file transfer checksums */
 int checksum_type = 0; /* used for the pre-transfer (--checksum) checksums */
@@ -45,6 +47,15 @@ int parse_checksum_choice(void)
 		checksum_type = parse_csum_name(cp+1, -1);
 	} else
 		xfersum_type = checksum_type = parse_csum_name(checksum_choice, -1);
+
+	/* When both sides can do XXH3 (see setup_protocol()), "auto" picks it
+	 * over MD5 for the block and file checksums. */
+	if (fast_checksum && protocol_version >= 30) {
+		if (!checksum_choice || strncasecmp(checksum_choice, "auto", 4) == 0)
+			xfersum_type = CSUM_XXH3;
+		if (!checksum_choice || strcasecmp(cp ? cp+1 : checksum_choice, "auto") == 0)
+			checksum_type = CSUM_XXH3;
+	}
 	return xfersum_type == CSUM_NONE;
 }
 
@@ -66,6 +77,8 @@ int parse_csum_name(const char *name, int len)
 		return CSUM_MD4;
 	if (len == 3 && strncasecmp(name, "md5", 3) == 0)
 		return CSUM_MD5;
+	if (len == 4 && strncasecmp(name, "xxh3", 4) == 0)
+		return CSUM_XXH3;
 	if (len == 4 && strncasecmp(name, "none", 4) == 0)
 		return CSUM_NONE;
 
@@ -88,6 +101,8 @@ int csum_len_for_type(int cst, BOOL flist_csum)
 		return MD4_DIGEST_LEN;
 	  case CSUM_MD5:
 		return MD5_DIGEST_LEN;
+	  case CSUM_XXH3:
+		return XXH3_DIGEST_LEN;
 	  default: /* paranoia to prevent missing case values */
 		exit_cleanup(RERR_UNSUPPORTED);
 	}
@@ -110,7 +125,12 @@ uint32 get_checksum1(char *buf1, int32 len)
     schar *buf = (schar *)buf1;
 
     s1 = s2 = 0;
-    for (i = 0; i < (len-4); i+=4) {
+#ifdef SIMD_CHECKSUM
+    i = get_checksum1_blocks(buf, len, &s1, &s2);
+#else
+    i = 0;
+#endif
+    for (; i < (len-4); i+=4) {
 	s2 += 4*(s1 + buf[i]) + 3*buf[i+1] + 2*buf[i+2] + buf[i+3] +
 	  10*CHAR_OFFSET;
 	s1 += (buf[i+0] + buf[i+1] + buf[i+2] + buf[i+3] + 4*CHAR_OFFSET);
@@ -145,49 +165,92 @@ void get_checksum2(char *buf, int32 len, char *sum)
 		md5_result(&m, (uchar *)sum);
 		break;
 	  }
+	  case CSUM_XXH3:
+		SIVAL64(sum, 0, xxh3_64((uchar *)buf, len, (uint32)checksum_seed));
+		break;
 	  case CSUM_MD4:
 	  case CSUM_MD4_OLD:
 	  case CSUM_MD4_BUSTED:
-	  case CSUM_MD4_ARCHAIC: {
-		int32 i;
-		static char *buf1;
-		static int32 len1;
+	  case CSUM_MD4_ARCHAIC:
+		get_checksum2_multi(&buf, &len, 1, sum);
+		break;
+	  default: /* paranoia to prevent missing case values */
+		exit_cleanup(RERR_UNSUPPORTED);
+	}
+}
 
-		mdfour_begin(&m);
+/* Fill in the strong checksums of cnt blocks, MAX_DIGEST_LEN bytes apart
+ * in sums.  The MD4 and MD5 sums of up to MD_LANES blocks are computed
+ * side by side, with the seed hashed in place instead of being copied
+ * after (or before) each block. */
+void get_checksum2_multi(char **bufs, int32 *lens, int cnt, char *sums)
+{
+	md_message msgs[MD_LANES];
+	int i, j, n;
 
-		if (len > len1) {
-			if (buf1)
-				free(buf1);
-			buf1 = new_array(char, len+4);
-			len1 = len;
-			if (!buf1)
-				out_of_memory("get_checksum2");
-		}
+	switch (xfersum_type) {
+	  case CSUM_MD5:
+	  case CSUM_MD4:
+	  case CSUM_MD4_OLD:
+	  case CSUM_MD4_BUSTED:
+	  case CSUM_MD4_ARCHAIC:
+		break;
+	  default:
+		for (i = 0; i < cnt; i++)
+			get_checksum2(bufs[i], lens[i], sums + i * MAX_DIGEST_LEN);
+		return;
+	}
 
-		memcpy(buf1, buf, len);
-		if (checksum_seed) {
-			SIVAL(buf1,len,checksum_seed);
-			len += 4;
+	for (i = 0; i < cnt; i += n) {
+		uchar digests[MD_LANES * MD5_DIGEST_LEN];
+
+		n = MIN(cnt - i, MD_LANES);
+		for (j = 0; j < n; j++) {
+			msgs[j].in = (uchar *)bufs[i + j];
+			msgs[j].len = lens[i + j];
+			msgs[j].seed = checksum_seed;
+			if (!checksum_seed)
+				msgs[j].seed_at = MD_SEED_NONE;
+			else if (xfersum_type == CSUM_MD5 && proper_seed_order)
+				msgs[j].seed_at = MD_SEED_BEFORE;
+			else
+				msgs[j].seed_at = MD_SEED_AFTER;
 		}
 
-		for (i = 0; i + CSUM_CHUNK <= len; i += CSUM_CHUNK)
-			mdfour_update(&m, (uchar *)(buf1+i), CSUM_CHUNK);
-
 		/*
 		 * Prior to version 27 an incorrect MD4 checksum was computed
 		 * by failing to call mdfour_tail() for block sizes that
-		 * are multiples of 64.  This is fixed by calling mdfour_update()
-		 * even when there are no more bytes.
+		 * are multiples of 64 (see mdfour_multi()).
 		 */
-		if (len - i > 0 || xfersum_type > CSUM_MD4_BUSTED)
-			mdfour_update(&m, (uchar *)(buf1+i), len-i);
+		if (xfersum_type == CSUM_MD5)
+			md5_multi(msgs, n, digests);
+		else
+			mdfour_multi(msgs, n, xfersum_type <= CSUM_MD4_BUSTED, digests);
 
-		mdfour_result(&m, (uchar *)sum);
-		break;
-	  }
-	  default: /* paranoia to prevent missing case values */
-		exit_cleanup(RERR_UNSUPPORTED);
+		for (j = 0; j < n; j++)
+			memcpy(sums + (i + j) * MAX_DIGEST_LEN, digests + j * MD5_DIGEST_LEN, MD5_DIGEST_LEN);
+	}
+}
+
+/* Compute both checksums of the blocks of blength bytes (the last one may
+ * be short) that make up the len bytes at buf, at most MD_LANES of them,
+ * and return how many blocks there were. */
+int get_block_sums(char *buf, int32 len, int32 blength, uint32 *sum1s, char *sums)
+{
+	char *bufs[MD_LANES];
+	int32 lens[MD_LANES];
+	int cnt;
+
+	for (cnt = 0; cnt < MD_LANES && len > 0; cnt++) {
+		bufs[cnt] = buf;
+		lens[cnt] = MIN(len, blength);
+		sum1s[cnt] = get_checksum1(buf, lens[cnt]);
+		buf += lens[cnt];
+		len -= lens[cnt];
 	}
+	get_checksum2_multi(bufs, lens, cnt, sums);
+
+	return cnt;
 }
 
 void file_checksum(const char *fname, const STRUCT_STAT *st_p, char *sum)
@@ -221,6 +284,20 @@ void file_checksum(const char *fname, const STRUCT_STAT *st_p, char *sum)
 
 		md5_result(&m, (uchar *)sum);
 		break;
+	  case CSUM_XXH3: {
+		xxh3_context x;
+		xxh3_begin(&x, 0);
+
+		for (i = 0; i + CHUNK_SIZE <= len; i += CHUNK_SIZE)
+			xxh3_update(&x, (uchar *)map_ptr(buf, i, CHUNK_SIZE), CHUNK_SIZE);
+
+		remainder = (int32)(len - i);
+		if (remainder > 0)
+			xxh3_update(&x, (uchar *)map_ptr(buf, i, remainder), remainder);
+
+		SIVAL64(sum, 0, xxh3_result(&x));
+		break;
+	  }
 	  case CSUM_MD4:
 	  case CSUM_MD4_OLD:
 	  case CSUM_MD4_BUSTED:
@@ -253,6 +330,7 @@ void file_checksum(const char *fname, const STRUCT_STAT *st_p, char *sum)
 
 static int32 sumresidue;
 static md_context md;
+static xxh3_context xxh3;
 static int cursum_type;
 
 void sum_init(int csum_type, int seed)
@@ -267,6 +345,9 @@ void sum_init(int csum_type, int seed)
 	  case CSUM_MD5:
 		md5_begin(&md);
 		break;
+	  case CSUM_XXH3:
+		xxh3_begin(&xxh3, 0);
+		break;
 	  case CSUM_MD4:
 		mdfour_begin(&md);
 		sumresidue = 0;
@@ -300,6 +381,9 @@ void sum_update(const char *p, int32 len)
 	  case CSUM_MD5:
 		md5_update(&md, (uchar *)p, len);
 		break;
+	  case CSUM_XXH3:
+		xxh3_update(&xxh3, (uchar *)p, len);
+		break;
 	  case CSUM_MD4:
 	  case CSUM_MD4_OLD:
 	  case CSUM_MD4_BUSTED:
@@ -345,6 +429,9 @@ int sum_end(char *sum)
 	  case CSUM_MD5:
 		md5_result(&md, (uchar *)sum);
 		break;
+	  case CSUM_XXH3:
+		SIVAL64(sum, 0, xxh3_result(&xxh3));
+		break;
 	  case CSUM_MD4:
 	  case CSUM_MD4_OLD:
 		mdfour_update(&md, (uchar *)md.buffer, sumresidue);
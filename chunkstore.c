@@ -0,0 +1,969 @@
+/*
+ * A module-wide store of content-defined chunks ("chunk store" in
+ * rsyncd.conf), shared by the full versions of every file in a module.
+ *
+ * A full version is cut into chunks wherever a gear hash of the last 32
+ * bytes matches CHUNK_CUT_MASK, so an insertion or deletion only changes
+ * the chunks around it, and data that is copied, renamed or shared by
+ * many clients is cut the same way everywhere.  Each chunk is kept once,
+ * keyed by its MD5 digest.  The store directory holds:
+ *
+ *	index	records of CHUNK_RECORD_LEN bytes, only ever appended:
+ *		'C' digest pack offset len refs	  a chunk was added
+ *		'R' digest refs			  its reference count changed
+ *	pack.N	chunk data, appended under the index lock
+ *	gc.lock	held shared by every reader, so that reclaiming space
+ *		never moves a chunk that someone is reading
+ *
+ * A full version that lives in the store is a chunk list at the usual
+ * <file>.full.<version> path:
+ *
+ *	magic		4 bytes, "RSCL"
+ *	version		1 byte, CHUNK_LIST_VERSION
+ *	reserved	1 byte
+ *	store_len	2 bytes
+ *	file_size	8 bytes, little-endian
+ *	count		4 bytes
+ *	reserved	4 bytes
+ *	store		store_len bytes, the store's path relative to the
+ *			list's directory (so it works in and out of a chroot)
+ *	count entries:	digest 16 bytes, len 4 bytes
+ *
+ * Readers get at it through a delta_chain (see delta_chain_open()), so
+ * restores, compaction and differential basis files work unchanged.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, visit the http://fsf.org website.
+ */
+
+#include "rsync.h"
+#include "inums.h"
+
+#define CHUNK_LIST_MAGIC "RSCL"
+#define CHUNK_LIST_VERSION 1
+#define CHUNK_LIST_HEADER_LEN 24
+#define CHUNK_ENTRY_LEN (CHUNK_DIGEST_LEN + 4)
+#define CHUNK_RECORD_LEN 40
+
+#define CHUNK_MIN_SIZE (2*1024)
+#define CHUNK_MAX_SIZE (64*1024)
+#define CHUNK_CUT_MASK 0xFFF80000	/* 13 bits: a cut every ~8K past the minimum */
+#define CHUNK_READ_SIZE (256*1024)
+
+/* A pack is closed to new chunks at this size. */
+#define CHUNK_PACK_MAX ((OFF_T)256*1024*1024)
+
+struct chunk_ref {
+	char digest[CHUNK_DIGEST_LEN];
+	int32 len;
+	OFF_T pos;		/* where the chunk starts in the version */
+	int32 pack;
+	OFF_T offset;		/* where its data starts in the pack */
+};
+
+struct chunk_entry {
+	char digest[CHUNK_DIGEST_LEN];
+	int32 pack;		/* -1 marks an empty slot */
+	int32 len;
+	OFF_T offset;
+	int32 refs;
+};
+
+static struct {
+	char dir[MAXPATHLEN];	/* absolute, "" when no store is open */
+	dev_t dev;
+	ino_t ino;
+	int index_fd, gc_fd;
+	OFF_T index_len;	/* bytes of the index applied to tab */
+	struct chunk_entry *tab;
+	uint32 tab_size, used;
+	int32 last_pack;
+	int *pack_fds;
+	int pack_fds_size;
+	int readers;		/* open chunk lists, which hold gc.lock */
+} store = { "", 0, 0, -1, -1, 0, NULL, 0, 0, -1, NULL, 0, 0 };
+
+static char write_store_dir[MAXPATHLEN];	/* the module's store, for new versions */
+static uint32 gear[256];
+
+static int open_store(const char *dir, int create);
+
+static void init_gear(void)
+{
+	uint32 x = 0x2545F491;
+	int i;
+
+	/* These values decide every cut point, so they must never change. */
+	for (i = 0; i < 256; i++) {
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		gear[i] = x;
+	}
+}
+
+/* Called by a daemon once it is in the module's directory; dir is the
+ * "chunk store" parameter, relative to the module unless absolute. */
+void chunk_store_setup(const char *dir)
+{
+	extern char *module_dir;
+
+	if (!dir || !*dir)
+		return;
+	if (*dir == '/')
+		strlcpy(write_store_dir, dir, sizeof write_store_dir);
+	else
+		pathjoin(write_store_dir, sizeof write_store_dir, module_dir, dir);
+}
+
+static int lock_fd(int fd, int type, int wait)
+{
+	struct flock lock;
+
+	lock.l_type = type;
+	lock.l_whence = SEEK_SET;
+	lock.l_start = 0;
+	lock.l_len = 0;
+	lock.l_pid = 0;
+
+	while (fcntl(fd, wait ? F_SETLKW : F_SETLK, &lock) < 0) {
+		if (errno != EINTR)
+			return -1;
+	}
+	return 0;
+}
+
+/* Forget what was read from the index and the open packs. */
+static void reset_index(void)
+{
+	int i;
+
+	if (store.index_fd >= 0)
+		close(store.index_fd);
+	for (i = 0; i < store.pack_fds_size; i++) {
+		if (store.pack_fds[i] >= 0)
+			close(store.pack_fds[i]);
+	}
+	if (store.pack_fds)
+		free(store.pack_fds);
+	if (store.tab)
+		free(store.tab);
+	store.index_fd = -1;
+	store.index_len = 0;
+	store.tab = NULL;
+	store.tab_size = store.used = 0;
+	store.last_pack = -1;
+	store.pack_fds = NULL;
+	store.pack_fds_size = 0;
+}
+
+static void close_store(void)
+{
+	reset_index();
+	if (store.gc_fd >= 0)
+		close(store.gc_fd);	/* drops our lock on it */
+	store.gc_fd = -1;
+	store.readers = 0;
+	*store.dir = '\0';
+}
+
+static int open_index(void)
+{
+	char path[MAXPATHLEN];
+
+	pathjoin(path, sizeof path, store.dir, "index");
+	if ((store.index_fd = open(path, O_RDWR|O_CREAT|O_APPEND, 0644)) < 0) {
+		rsyserr(FERROR_XFER, errno, "open %s", path);
+		return -1;
+	}
+	return 0;
+}
+
+static struct chunk_entry *find_entry(const char *digest)
+{
+	static struct chunk_entry none = { "", -1, 0, 0, 0 };
+	uint32 mask = store.tab_size - 1;
+	uint32 i = IVAL(digest, 0) & mask;
+
+	if (!store.tab_size)
+		return &none;
+
+	while (store.tab[i].pack >= 0) {
+		if (memcmp(store.tab[i].digest, digest, CHUNK_DIGEST_LEN) == 0)
+			break;
+		i = (i + 1) & mask;
+	}
+
+	return store.tab + i;
+}
+
+static struct chunk_entry *add_entry(const char *digest)
+{
+	struct chunk_entry *e;
+
+	if ((store.used + 1) * 2 > store.tab_size) {
+		struct chunk_entry *old = store.tab;
+		uint32 i, old_size = store.tab_size;
+
+		store.tab_size = old_size ? old_size * 2 : 4096;
+		if (!(store.tab = new_array(struct chunk_entry, store.tab_size)))
+			out_of_memory("add_entry");
+		for (i = 0; i < store.tab_size; i++)
+			store.tab[i].pack = -1;
+		for (i = 0; i < old_size; i++) {
+			if (old[i].pack >= 0)
+				*find_entry(old[i].digest) = old[i];
+		}
+		if (old)
+			free(old);
+	}
+
+	e = find_entry(digest);
+	if (e->pack < 0) {
+		memcpy(e->digest, digest, CHUNK_DIGEST_LEN);
+		e->refs = 0;
+		store.used++;
+	}
+
+	return e;
+}
+
+static void apply_record(const char *rec)
+{
+	struct chunk_entry *e = add_entry(rec + 4);
+
+	if (*rec == 'C') {
+		e->pack = IVAL(rec, 20);
+		e->offset = (OFF_T)IVAL64(rec, 24);
+		e->len = IVAL(rec, 32);
+		e->refs += (int32)IVAL(rec, 36);
+		if (e->pack > store.last_pack)
+			store.last_pack = e->pack;
+	} else
+		e->refs += (int32)IVAL(rec, 20);
+	if (e->pack < 0) {	/* a stray 'R' record */
+		e->pack = 0;
+		e->len = 0;
+	}
+}
+
+/* Apply whatever other processes appended to the index since we last
+ * looked.  A reclaim replaces the index, so then start over. */
+static int refresh_index(void)
+{
+	char buf[CHUNK_RECORD_LEN * 256];
+	STRUCT_STAT st1, st2;
+	char path[MAXPATHLEN];
+	int n, i;
+
+	pathjoin(path, sizeof path, store.dir, "index");
+	if (do_stat(path, &st1) == 0 && do_fstat(store.index_fd, &st2) == 0
+	 && (st1.st_ino != st2.st_ino || st1.st_dev != st2.st_dev)) {
+		reset_index();
+		if (open_index() < 0)
+			return -1;
+	}
+
+	while (1) {
+		if (do_lseek(store.index_fd, store.index_len, SEEK_SET) != store.index_len)
+			return -1;
+		if ((n = read(store.index_fd, buf, sizeof buf)) < 0) {
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		n -= n % CHUNK_RECORD_LEN;	/* stop short of an append in progress */
+		if (n == 0)
+			break;
+		for (i = 0; i < n; i += CHUNK_RECORD_LEN)
+			apply_record(buf + i);
+		store.index_len += n;
+	}
+
+	return 0;
+}
+
+/* Make dir the open store; only a writer creates it. */
+static int open_store(const char *dir, int create)
+{
+	char path[MAXPATHLEN];
+	STRUCT_STAT st;
+
+	if (do_stat(dir, &st) < 0) {
+		if (!create || errno != ENOENT || do_mkdir((char *)dir, 0755) < 0 || do_stat(dir, &st) < 0) {
+			rsyserr(FERROR_XFER, errno, "chunk store %s", dir);
+			return -1;
+		}
+	}
+	if (*store.dir) {
+		if (st.st_dev == store.dev && st.st_ino == store.ino)
+			return 0;
+		if (store.readers) {
+			rprintf(FERROR_XFER, "chunk store %s: another store is in use\n", dir);
+			return -1;
+		}
+		close_store();
+	}
+	if (!gear[0])
+		init_gear();
+
+	if (*dir == '/')
+		strlcpy(store.dir, dir, sizeof store.dir);
+	else {
+		char cwd[MAXPATHLEN];
+		if (!getcwd(cwd, sizeof cwd)) {
+			rsyserr(FERROR_XFER, errno, "getcwd");
+			return -1;
+		}
+		pathjoin(store.dir, sizeof store.dir, cwd, dir);
+	}
+	store.dev = st.st_dev;
+	store.ino = st.st_ino;
+
+	if (open_index() < 0) {
+		close_store();
+		return -1;
+	}
+	pathjoin(path, sizeof path, store.dir, "gc.lock");
+	if ((store.gc_fd = open(path, O_RDWR|O_CREAT, 0644)) < 0) {
+		rsyserr(FERROR_XFER, errno, "open %s", path);
+		close_store();
+		return -1;
+	}
+
+	return refresh_index();
+}
+
+static int pack_fd(int32 pack, int for_append)
+{
+	char path[MAXPATHLEN], name[32];
+
+	if (pack >= store.pack_fds_size) {
+		int i, size = pack + 16;
+		if (!(store.pack_fds = realloc_array(store.pack_fds, int, size)))
+			out_of_memory("pack_fd");
+		for (i = store.pack_fds_size; i < size; i++)
+			store.pack_fds[i] = -1;
+		store.pack_fds_size = size;
+	}
+	if (store.pack_fds[pack] >= 0 && for_append
+	 && (fcntl(store.pack_fds[pack], F_GETFL) & O_ACCMODE) == O_RDONLY) {
+		close(store.pack_fds[pack]);
+		store.pack_fds[pack] = -1;
+	}
+	if (store.pack_fds[pack] < 0) {
+		snprintf(name, sizeof name, "pack.%d", (int)pack);
+		pathjoin(path, sizeof path, store.dir, name);
+		if ((store.pack_fds[pack] = open(path, for_append ? O_RDWR|O_CREAT|O_APPEND : O_RDONLY, 0644)) < 0)
+			rsyserr(FERROR_XFER, errno, "open %s", path);
+	}
+
+	return store.pack_fds[pack];
+}
+
+static int read_fully(int fd, OFF_T offset, char *buf, int32 len)
+{
+	if (do_lseek(fd, offset, SEEK_SET) != offset)
+		return -1;
+	while (len > 0) {
+		int32 n = read(fd, buf, len);
+		if (n <= 0) {
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n == 0)
+				errno = ENODATA;
+			return -1;
+		}
+		buf += n;
+		len -= n;
+	}
+	return 0;
+}
+
+static int write_records(const char *buf, int len)
+{
+	if (len && full_write(store.index_fd, buf, len) != len) {
+		rsyserr(FERROR_XFER, errno, "write %s/index", store.dir);
+		return -1;
+	}
+	store.index_len += len;
+	return 0;
+}
+
+/* Read the header and entries of the chunk list open on fd.  Returns 1
+ * if it is one, 0 if fd holds a plain file, -1 on error. */
+static int read_list(const char *fname, int fd, struct chunk_list *cl, char *store_dir)
+{
+	char hdr[CHUNK_LIST_HEADER_LEN], rel[MAXPATHLEN], *buf, *p;
+	int store_len, i;
+	OFF_T pos = 0;
+
+	if (do_lseek(fd, 0, SEEK_SET) != 0)
+		return -1;
+	if (read(fd, hdr, sizeof hdr) != sizeof hdr || memcmp(hdr, CHUNK_LIST_MAGIC, 4) != 0
+	 || hdr[4] != CHUNK_LIST_VERSION)
+		return do_lseek(fd, 0, SEEK_SET) == 0 ? 0 : -1;
+
+	store_len = CVAL(hdr, 6) | CVAL(hdr, 7) << 8;
+	cl->size = (OFF_T)IVAL64(hdr, 8);
+	cl->count = IVAL(hdr, 16);
+	if (store_len >= MAXPATHLEN || cl->count < 0 || read_fully(fd, sizeof hdr, rel, store_len) < 0) {
+		rprintf(FERROR_XFER, "bad chunk list %s\n", full_fname(fname));
+		return -1;
+	}
+	rel[store_len] = '\0';
+	if (*rel == '/' || !(p = strrchr(fname, '/')))
+		strlcpy(store_dir, rel, MAXPATHLEN);
+	else {
+		char dir[MAXPATHLEN];
+		strlcpy(dir, fname, MIN(p - fname + 1, MAXPATHLEN));
+		pathjoin(store_dir, MAXPATHLEN, dir, rel);
+	}
+
+	if (!(cl->refs = new_array(struct chunk_ref, cl->count ? cl->count : 1))
+	 || !(buf = new_array(char, cl->count * CHUNK_ENTRY_LEN + 1)))
+		out_of_memory("read_list");
+	if (read_fully(fd, sizeof hdr + store_len, buf, cl->count * CHUNK_ENTRY_LEN) < 0) {
+		rsyserr(FERROR_XFER, errno, "read %s", full_fname(fname));
+		free(buf);
+		return -1;
+	}
+	for (i = 0; i < cl->count; i++) {
+		struct chunk_ref *r = cl->refs + i;
+		memcpy(r->digest, buf + i * CHUNK_ENTRY_LEN, CHUNK_DIGEST_LEN);
+		r->len = IVAL(buf, i * CHUNK_ENTRY_LEN + CHUNK_DIGEST_LEN);
+		r->pos = pos;
+		pos += r->len;
+	}
+	free(buf);
+	if (pos != cl->size) {
+		rprintf(FERROR_XFER, "bad chunk list %s\n", full_fname(fname));
+		return -1;
+	}
+
+	return 1;
+}
+
+/* If fd (open on fname) is a chunk list, set *clp to it, ready for
+ * chunk_list_read(), and return 1.  Returns 0 for a plain file and -1
+ * on error. */
+int chunk_list_open(const char *fname, int fd, struct chunk_list **clp)
+{
+	char store_dir[MAXPATHLEN];
+	struct chunk_list *cl;
+	int i, ret;
+
+	if (!(cl = new0(struct chunk_list)))
+		out_of_memory("chunk_list_open");
+	if ((ret = read_list(fname, fd, cl, store_dir)) <= 0) {
+		if (cl->refs)
+			free(cl->refs);
+		free(cl);
+		return ret;
+	}
+
+	if (open_store(store_dir, 0) < 0)
+		goto error;
+	if (!store.readers && lock_fd(store.gc_fd, F_RDLCK, 1) < 0) {
+		rsyserr(FERROR_XFER, errno, "lock %s/gc.lock", store.dir);
+		goto error;
+	}
+	store.readers++;
+	if (refresh_index() < 0) {
+		rsyserr(FERROR_XFER, errno, "read %s/index", store.dir);
+		chunk_list_close(cl);
+		return -1;
+	}
+
+	for (i = 0; i < cl->count; i++) {
+		struct chunk_ref *r = cl->refs + i;
+		struct chunk_entry *e = find_entry(r->digest);
+		if (e->pack < 0 || e->len != r->len) {
+			rprintf(FERROR_XFER, "%s: chunk %d is missing from %s\n",
+				full_fname(fname), i, store.dir);
+			chunk_list_close(cl);
+			return -1;
+		}
+		r->pack = e->pack;
+		r->offset = e->offset;
+	}
+	*clp = cl;
+
+	return 1;
+
+  error:
+	free(cl->refs);
+	free(cl);
+	return -1;
+}
+
+/* Read up to len bytes of the version at offset.  Returns the number of
+ * bytes read (short only at the end) or -1 on error. */
+int32 chunk_list_read(struct chunk_list *cl, OFF_T offset, char *buf, int32 len)
+{
+	int lo = 0, hi = cl->count - 1;
+	int32 done = 0;
+
+	if (offset >= cl->size || len <= 0)
+		return 0;
+
+	while (lo < hi) {
+		int mid = (lo + hi + 1) / 2;
+		if (cl->refs[mid].pos <= offset)
+			lo = mid;
+		else
+			hi = mid - 1;
+	}
+	for ( ; lo < cl->count && done < len; lo++) {
+		struct chunk_ref *r = cl->refs + lo;
+		OFF_T skip = offset - r->pos;
+		int32 n = (int32)MIN(r->len - skip, len - done);
+		int fd = pack_fd(r->pack, 0);
+		if (fd < 0 || read_fully(fd, r->offset + skip, buf + done, n) < 0)
+			return -1;
+		done += n;
+		offset += n;
+	}
+
+	return done;
+}
+
+void chunk_list_close(struct chunk_list *cl)
+{
+	if (--store.readers == 0)
+		lock_fd(store.gc_fd, F_UNLCK, 0);
+	free(cl->refs);
+	free(cl);
+}
+
+/* Append 'R' records dropping the references that the chunk list at
+ * fname holds.  The caller holds the index lock. */
+static int release_list(const char *fname)
+{
+	char store_dir[MAXPATHLEN], *buf;
+	struct chunk_list cl;
+	int fd, i, len = 0, ret;
+
+	if ((fd = do_open(fname, O_RDONLY, 0)) < 0)
+		return errno == ENOENT ? 0 : -1;
+	memset(&cl, 0, sizeof cl);
+	ret = read_list(fname, fd, &cl, store_dir);
+	close(fd);
+	if (ret <= 0) {
+		if (cl.refs)
+			free(cl.refs);
+		return ret;
+	}
+
+	if (!(buf = new_array0(char, cl.count * CHUNK_RECORD_LEN + 1)))
+		out_of_memory("release_list");
+	for (i = 0; i < cl.count; i++) {
+		char *rec = buf + len;
+		struct chunk_entry *e = find_entry(cl.refs[i].digest);
+		if (e->pack < 0)
+			continue;
+		e->refs--;
+		rec[0] = 'R';
+		memcpy(rec + 4, cl.refs[i].digest, CHUNK_DIGEST_LEN);
+		SIVAL(rec, 20, (uint32)-1);
+		len += CHUNK_RECORD_LEN;
+	}
+	ret = write_records(buf, len);
+	free(buf);
+	free(cl.refs);
+
+	return ret;
+}
+
+/* Unlink a stored full or delta file, first giving back the chunks it
+ * holds if it is a chunk list.  Returns like do_unlink(). */
+int chunk_list_unlink(const char *fname)
+{
+	char store_dir[MAXPATHLEN];
+	struct chunk_list cl;
+	int fd, ret;
+
+	if ((fd = do_open(fname, O_RDONLY, 0)) >= 0) {
+		memset(&cl, 0, sizeof cl);
+		ret = read_list(fname, fd, &cl, store_dir);
+		close(fd);
+		if (cl.refs)
+			free(cl.refs);
+		if (ret > 0 && open_store(store_dir, 0) == 0) {
+			if (lock_fd(store.index_fd, F_WRLCK, 1) < 0 || refresh_index() < 0
+			 || release_list(fname) < 0)
+				rprintf(FWARNING, "[yee-%s] chunkstore.c: releasing the chunks of %s failed\n", who_am_i(), fname);
+			lock_fd(store.index_fd, F_UNLCK, 0);
+		}
+	}
+
+	return do_unlink(fname);
+}
+
+/* Put the path of the store relative to the directory of fname into rel. */
+static int store_path_from(const char *fname, char *rel, int size)
+{
+	char from[MAXPATHLEN], to[MAXPATHLEN], *p;
+	int i, common = 0, len = 0;
+
+	if (*fname == '/')
+		strlcpy(from, fname, sizeof from);
+	else {
+		char cwd[MAXPATHLEN];
+		if (!getcwd(cwd, sizeof cwd))
+			return -1;
+		pathjoin(from, sizeof from, cwd, fname);
+	}
+	if ((p = strrchr(from, '/')) != NULL)
+		p[p == from] = '\0';
+	strlcpy(to, store.dir, sizeof to);
+	clean_fname(from, CFN_COLLAPSE_DOT_DOT_DIRS);
+	clean_fname(to, CFN_COLLAPSE_DOT_DOT_DIRS);
+	if (from[strlen(from) - 1] != '/')
+		strlcat(from, "/", sizeof from);
+	if (to[strlen(to) - 1] != '/')
+		strlcat(to, "/", sizeof to);
+
+	for (i = 0; from[i] && from[i] == to[i]; i++) {
+		if (from[i] == '/')
+			common = i + 1;
+	}
+	*rel = '\0';
+	for (p = from + common; *p; p++) {
+		if (*p == '/')
+			strlcat(rel, "../", size);
+	}
+	len = strlcat(rel, to + common, size);
+	if (len >= size)
+		return -1;
+	if (len > 1 && rel[len-1] == '/')
+		rel[--len] = '\0';
+	if (!*rel)
+		strlcpy(rel, ".", size);
+
+	return 0;
+}
+
+/* Find the next cut point in buf[0..len); eof says that no more data
+ * follows, so the end of buf is a cut too. */
+static int32 find_cut(const uchar *buf, int32 len, int eof)
+{
+	uint32 h = 0;
+	int32 i, max = MIN(len, CHUNK_MAX_SIZE);
+
+	if (len <= CHUNK_MIN_SIZE)
+		return eof || len >= CHUNK_MAX_SIZE ? len : 0;
+	for (i = CHUNK_MIN_SIZE - 32; i < CHUNK_MIN_SIZE; i++)
+		h = (h << 1) + gear[buf[i]];
+	for ( ; i < max; i++) {
+		h = (h << 1) + gear[buf[i]];
+		if (!(h & CHUNK_CUT_MASK))
+			return i + 1;
+	}
+
+	return max == CHUNK_MAX_SIZE || eof ? max : 0;
+}
+
+/* Store one chunk: append its data to a pack if the store lacks it, and
+ * add its reference to recs. */
+static int store_chunk(const char *data, int32 len, char *digest, char *rec)
+{
+	struct chunk_entry *e;
+	md_context ctx;
+
+	md5_begin(&ctx);
+	md5_update(&ctx, (const uchar *)data, len);
+	md5_result(&ctx, (uchar *)digest);
+
+	memset(rec, 0, CHUNK_RECORD_LEN);
+	memcpy(rec + 4, digest, CHUNK_DIGEST_LEN);
+
+	e = add_entry(digest);
+	if (e->pack >= 0 && e->len == len) {
+		e->refs++;
+		rec[0] = 'R';
+		SIVAL(rec, 20, 1);
+		return 0;
+	}
+
+	{
+		int32 pack = store.last_pack < 0 ? 0 : store.last_pack;
+		STRUCT_STAT st;
+		int fd;
+
+		if ((fd = pack_fd(pack, 1)) < 0 || do_fstat(fd, &st) < 0)
+			return -1;
+		if (st.st_size >= CHUNK_PACK_MAX) {
+			if ((fd = pack_fd(++pack, 1)) < 0 || do_fstat(fd, &st) < 0)
+				return -1;
+		}
+		if (full_write(fd, data, len) != len) {
+			rsyserr(FERROR_XFER, errno, "write %s/pack.%d", store.dir, (int)pack);
+			return -1;
+		}
+		e->pack = pack;
+		e->offset = st.st_size;
+		e->len = len;
+		e->refs = 1;
+		store.last_pack = pack;
+	}
+	rec[0] = 'C';
+	SIVAL(rec, 20, e->pack);
+	SIVAL64(rec, 24, (int64)e->offset);
+	SIVAL(rec, 32, len);
+	SIVAL(rec, 36, 1);
+
+	return 0;
+}
+
+static int write_list(const char *dest_fname, OFF_T size, const char *entries, int count)
+{
+	char hdr[CHUNK_LIST_HEADER_LEN], rel[MAXPATHLEN];
+	int fd, rel_len, ret = 0;
+
+	if (store_path_from(dest_fname, rel, sizeof rel) < 0) {
+		rprintf(FERROR_XFER, "chunk store %s: path too long\n", store.dir);
+		return -1;
+	}
+	rel_len = strlen(rel);
+
+	memset(hdr, 0, sizeof hdr);
+	memcpy(hdr, CHUNK_LIST_MAGIC, 4);
+	hdr[4] = CHUNK_LIST_VERSION;
+	hdr[6] = (char)(rel_len & 0xFF);
+	hdr[7] = (char)(rel_len >> 8);
+	SIVAL64(hdr, 8, (int64)size);
+	SIVAL(hdr, 16, count);
+
+	if ((fd = do_open(dest_fname, O_WRONLY|O_CREAT|O_TRUNC, 0600)) < 0) {
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(dest_fname));
+		return -1;
+	}
+	if (full_write(fd, hdr, sizeof hdr) != sizeof hdr
+	 || full_write(fd, rel, rel_len) != rel_len
+	 || full_write(fd, entries, count * CHUNK_ENTRY_LEN) != count * CHUNK_ENTRY_LEN) {
+		rsyserr(FERROR_XFER, errno, "write %s", full_fname(dest_fname));
+		ret = -1;
+	}
+	if (close(fd) < 0 && ret == 0) {
+		rsyserr(FERROR_XFER, errno, "close failed on %s", full_fname(dest_fname));
+		ret = -1;
+	}
+	if (ret < 0)
+		do_unlink(dest_fname);
+
+	return ret;
+}
+
+/* Write the version described by dc to dest_fname as a chunk list, into
+ * the store its basis came from or else the module's store.  Returns 1
+ * (writing nothing) when there is no store to use, so that the caller
+ * writes a plain file instead, 0 on success and -1 on error. */
+int chunk_store_chain(struct delta_chain *dc, const char *dest_fname)
+{
+	char *buf, *entries, *recs, digest[CHUNK_DIGEST_LEN];
+	int count = 0, malloced = 256, nrecs = 0, ret = 0;
+	int32 fill = 0, cut;
+	OFF_T offset = 0;
+
+	if (dc->list) {
+		if (open_store(store.dir, 0) < 0)
+			return -1;
+	} else if (!*write_store_dir)
+		return 1;
+	else if (open_store(write_store_dir, 1) < 0)
+		return -1;
+
+	if (lock_fd(store.index_fd, F_WRLCK, 1) < 0) {
+		rsyserr(FERROR_XFER, errno, "lock %s/index", store.dir);
+		return -1;
+	}
+	if (refresh_index() < 0 || release_list(dest_fname) < 0) {
+		rsyserr(FERROR_XFER, errno, "update %s/index", store.dir);
+		lock_fd(store.index_fd, F_UNLCK, 0);
+		return -1;
+	}
+
+	if (!(buf = new_array(char, CHUNK_READ_SIZE + CHUNK_MAX_SIZE))
+	 || !(entries = new_array(char, malloced * CHUNK_ENTRY_LEN))
+	 || !(recs = new_array(char, 256 * CHUNK_RECORD_LEN)))
+		out_of_memory("chunk_store_chain");
+
+	while (1) {
+		int eof = offset >= dc->size;
+		if (!eof && fill < CHUNK_MAX_SIZE) {
+			int32 n = delta_chain_read(dc, offset, buf + fill, CHUNK_READ_SIZE);
+			if (n <= 0) {
+				rsyserr(FERROR_XFER, n < 0 ? errno : ENODATA, "read for %s", full_fname(dest_fname));
+				ret = -1;
+				break;
+			}
+			fill += n;
+			offset += n;
+			continue;
+		}
+		if (fill == 0)
+			break;
+		if ((cut = find_cut((uchar *)buf, fill, eof)) == 0)
+			cut = fill;
+		if (count == malloced) {
+			malloced *= 2;
+			if (!(entries = realloc_array(entries, char, malloced * CHUNK_ENTRY_LEN)))
+				out_of_memory("chunk_store_chain");
+		}
+		if (store_chunk(buf, cut, digest, recs + nrecs * CHUNK_RECORD_LEN) < 0) {
+			ret = -1;
+			break;
+		}
+		memcpy(entries + count * CHUNK_ENTRY_LEN, digest, CHUNK_DIGEST_LEN);
+		SIVAL(entries, count * CHUNK_ENTRY_LEN + CHUNK_DIGEST_LEN, cut);
+		count++;
+		if (++nrecs == 256) {
+			if (write_records(recs, nrecs * CHUNK_RECORD_LEN) < 0) {
+				ret = -1;
+				break;
+			}
+			nrecs = 0;
+		}
+		memmove(buf, buf + cut, fill - cut);
+		fill -= cut;
+	}
+
+	if (ret == 0 && write_records(recs, nrecs * CHUNK_RECORD_LEN) < 0)
+		ret = -1;
+	if (ret == 0)
+		ret = write_list(dest_fname, dc->size, entries, count);
+	lock_fd(store.index_fd, F_UNLCK, 0);
+
+	free(buf);
+	free(entries);
+	free(recs);
+
+	return ret;
+}
+
+/* Give back the space of chunks that no version uses any more: every
+ * pack that is mostly dead has its live chunks moved to a new pack, and
+ * the index is rewritten.  Skipped while anyone is reading the store. */
+void chunk_store_reclaim(void)
+{
+	char path[MAXPATHLEN], tmp[MAXPATHLEN], name[32], rec[CHUNK_RECORD_LEN];
+	OFF_T *live = NULL, *dead = NULL;
+	int32 npacks, new_pack, i;
+	int index_fd = -1, fd;
+	char *data = NULL;
+	uint32 j;
+
+	if (!*store.dir) {
+		STRUCT_STAT st;
+		if (!*write_store_dir || do_stat(write_store_dir, &st) < 0
+		 || open_store(write_store_dir, 0) < 0)
+			return;
+	}
+	if (store.readers || lock_fd(store.gc_fd, F_WRLCK, 0) < 0)
+		return;
+	if (lock_fd(store.index_fd, F_WRLCK, 1) < 0 || refresh_index() < 0)
+		goto done;
+
+	npacks = store.last_pack + 1;
+	if (npacks <= 0)
+		goto done;
+	if (!(live = new_array0(OFF_T, npacks)) || !(dead = new_array0(OFF_T, npacks)))
+		out_of_memory("chunk_store_reclaim");
+	for (j = 0; j < store.tab_size; j++) {
+		struct chunk_entry *e = store.tab + j;
+		if (e->pack < 0 || e->pack >= npacks)
+			continue;
+		if (e->refs > 0)
+			live[e->pack] += e->len;
+		else
+			dead[e->pack] += e->len;
+	}
+	for (i = 0; i < npacks; i++) {
+		if (dead[i] > live[i])
+			break;
+	}
+	if (i == npacks)
+		goto done;
+
+	/* Move the live chunks of the mostly-dead packs into a new one. */
+	new_pack = npacks;
+	if ((fd = pack_fd(new_pack, 1)) < 0)
+		goto done;
+	if (!(data = new_array(char, CHUNK_MAX_SIZE)))
+		out_of_memory("chunk_store_reclaim");
+	for (j = 0; j < store.tab_size; j++) {
+		struct chunk_entry *e = store.tab + j;
+		STRUCT_STAT st;
+		int src;
+		if (e->pack < 0 || e->pack >= npacks || dead[e->pack] <= live[e->pack] || e->refs <= 0)
+			continue;
+		if ((src = pack_fd(e->pack, 0)) < 0 || e->len > CHUNK_MAX_SIZE
+		 || read_fully(src, e->offset, data, e->len) < 0
+		 || do_fstat(fd, &st) < 0 || full_write(fd, data, e->len) != e->len) {
+			rsyserr(FERROR_XFER, errno, "reclaim %s", store.dir);
+			goto done;
+		}
+		e->pack = new_pack;
+		e->offset = st.st_size;
+	}
+
+	pathjoin(path, sizeof path, store.dir, "index");
+	pathjoin(tmp, sizeof tmp, store.dir, "index.tmp");
+	if ((index_fd = do_open(tmp, O_WRONLY|O_CREAT|O_TRUNC, 0644)) < 0) {
+		rsyserr(FERROR_XFER, errno, "open %s", tmp);
+		goto done;
+	}
+	for (j = 0; j < store.tab_size; j++) {
+		struct chunk_entry *e = store.tab + j;
+		/* Dead chunks stay listed until their pack is rewritten, so
+		 * that the pack's dead bytes keep counting. */
+		if (e->pack < 0 || (e->refs <= 0 && (e->pack >= npacks || dead[e->pack] > live[e->pack])))
+			continue;
+		memset(rec, 0, sizeof rec);
+		rec[0] = 'C';
+		memcpy(rec + 4, e->digest, CHUNK_DIGEST_LEN);
+		SIVAL(rec, 20, e->pack);
+		SIVAL64(rec, 24, (int64)e->offset);
+		SIVAL(rec, 32, e->len);
+		SIVAL(rec, 36, e->refs);
+		if (full_write(index_fd, rec, sizeof rec) != sizeof rec) {
+			rsyserr(FERROR_XFER, errno, "write %s", tmp);
+			close(index_fd);
+			do_unlink(tmp);
+			goto done;
+		}
+	}
+	if (close(index_fd) < 0 || do_rename(tmp, path) < 0) {
+		rsyserr(FERROR_XFER, errno, "replace %s", path);
+		do_unlink(tmp);
+		goto done;
+	}
+	for (i = 0; i < npacks; i++) {
+		if (dead[i] <= live[i])
+			continue;
+		snprintf(name, sizeof name, "pack.%d", (int)i);
+		pathjoin(path, sizeof path, store.dir, name);
+		do_unlink(path);
+	}
+
+  done:
+	if (live)
+		free(live);
+	if (dead)
+		free(dead);
+	if (data)
+		free(data);
+	/* Closing drops both locks; the next use reads the new index. */
+	close_store();
+}
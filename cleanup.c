@@ -203,6 +203,7 @@ NORETURN void _exit_cleanup(int code, const char *file, int line)
 			do_unlink(cleanup_fname);
 		if (exit_code)
 			kill_all(SIGUSR1);
+		prefetch_cleanup();
 		if (cleanup_pid && cleanup_pid == getpid()) {
 			char *pidf = lp_pid_file();
 			if (pidf && *pidf)
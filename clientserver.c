@@ -67,6 +67,15 @@ extern char *backup_version;
 extern int source_is_remote_or_local;
 extern int backup_type;
 extern int backup_version_num;
+extern int checkpoint_ratio;
+extern int checksum_workers;
+extern int backup_compression;
+extern int pack_threshold;
+extern int restore_workers;
+extern int signature_sidecars;
+extern int snapshot_catalog;
+extern int checksum_seed;
+extern int restore_prefetch_limit;
 
 char *auth_user;
 int read_only = 0;
@@ -743,6 +752,15 @@ static int rsync_module(int f_in, int f_out, int i, const char *addr, const char
 		   XFLG_ABS_IF_SLASH | XFLG_DIR2WILD3 | XFLG_OLD_PREFIXES);
 
 	log_init(1);
+	retention_daemon_setup(i, use_chroot ? module_chdir : NULL);
+	checkpoint_ratio = lp_checkpoint_ratio(i);
+	checksum_workers = lp_checksum_workers(i);
+	backup_compression = MIN(MAX(lp_backup_compression(i), 0), 9);
+	pack_threshold = lp_pack_threshold(i);
+	restore_workers = lp_restore_workers(i);
+	signature_sidecars = lp_signature_sidecars(i);
+	snapshot_catalog = lp_snapshot_catalog(i);
+	restore_prefetch_limit = lp_restore_prefetch_limit(i);
 
 #ifdef HAVE_PUTENV
 	if (*lp_prexfer_exec(i) || *lp_postxfer_exec(i)) {
@@ -853,6 +871,8 @@ static int rsync_module(int f_in, int f_out, int i, const char *addr, const char
 
 	if (!change_dir(module_chdir, CD_NORMAL))
 		return path_failure(f_out, module_chdir, True);
+	chunk_store_setup(lp_chunk_store(i));
+	version_cache_setup(lp_version_cache(i), lp_version_cache_size(i));
 	if (module_dirlen || (!use_chroot && !*lp_daemon_chroot()))
 		sanitize_paths = 1;
 
@@ -955,6 +975,9 @@ static int rsync_module(int f_in, int f_out, int i, const char *addr, const char
 		ignore_errors = 1;
 	if (write_batch < 0)
 		dry_run = 1;
+	// 块签名文件依赖强校验和的种子, 客户端未指定时使用模块固定的种子
+	if (signature_sidecars && !checksum_seed)
+		checksum_seed = signature_seed(lp_name(i));
 
 	if (lp_fake_super(i)) {
 		if (preserve_xattrs > 1)
@@ -28,6 +28,8 @@ int compat_flags = 0;
 int use_safe_inc_flist = 0;
 int want_xattr_optim = 0;
 int proper_seed_order = 0;
+int fast_checksum = 0;		/* both sides can use XXH3 checksums */
+int checkpoint_stats = 0;	/* the backup's checkpoint count is sent to the client */
 
 extern int am_server;
 extern int am_sender;
@@ -80,6 +82,8 @@ int filesfrom_convert = 0;
 #define CF_SAFE_FLIST	 (1<<3)
 #define CF_AVOID_XATTR_OPTIM (1<<4)
 #define CF_CHKSUM_SEED_FIX (1<<5)
+#define CF_FAST_CHECKSUM (1<<6)
+#define CF_CHECKPOINT_STATS (1<<7)
 
 static const char *client_info;
 
@@ -275,6 +279,10 @@ void setup_protocol(int f_out,int f_in)
 				compat_flags |= CF_AVOID_XATTR_OPTIM;
 			if (local_server || strchr(client_info, 'C') != NULL)
 				compat_flags |= CF_CHKSUM_SEED_FIX;
+			if (local_server || strchr(client_info, 'H') != NULL)
+				compat_flags |= CF_FAST_CHECKSUM;
+			if (local_server || strchr(client_info, 'K') != NULL)
+				compat_flags |= CF_CHECKPOINT_STATS;
 			write_byte(f_out, compat_flags);
 		} else
 			compat_flags = read_byte(f_in);
@@ -282,6 +290,8 @@ void setup_protocol(int f_out,int f_in)
 		inc_recurse = compat_flags & CF_INC_RECURSE ? 1 : 0;
 		want_xattr_optim = protocol_version >= 31 && !(compat_flags & CF_AVOID_XATTR_OPTIM);
 		proper_seed_order = compat_flags & CF_CHKSUM_SEED_FIX ? 1 : 0;
+		fast_checksum = compat_flags & CF_FAST_CHECKSUM ? 1 : 0;
+		checkpoint_stats = compat_flags & CF_CHECKPOINT_STATS ? 1 : 0;
 		if (am_sender) {
 			receiver_symlink_times = am_server
 			    ? strchr(client_info, 'L') != NULL
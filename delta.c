@@ -0,0 +1,1571 @@
+/*
+ * Reading, writing, and applying the delta files that the receiver keeps
+ * in each <file>.backup/ directory.
+ *
+ * A delta file describes how to rebuild one version of a file from a
+ * basis file (the previous version for incremental backups, the newest
+ * full version for differential ones).  The current format is binary:
+ *
+ *	magic		4 bytes, "RSDL"
+ *	version		1 byte, DELTA_FORMAT_VERSION
+ *	flags		1 byte
+ *	reserved	2 bytes
+ *	file_size	8 bytes, little-endian
+ *	content_size	8 bytes
+ *	block_size	4 bytes
+ *	block_count	4 bytes
+ *	remainder	4 bytes
+ *	reserved	4 bytes
+ *
+ * followed by a stream of ops, each a single opcode byte and varints:
+ *
+ *	COPY	src_offset len		copy len bytes of the basis file
+ *	LITERAL	len <len bytes>		copy the bytes that follow
+ *	END
+ *
+ * Matched blocks that are adjacent in both files are written as a single
+ * COPY, so an unchanged stretch of any length is one op.
+ *
+ * A header with DELTA_FLAG_INDEXED set has an offset index after the END
+ * op, which readers that only apply the delta never look at:
+ *
+ *	entries		16 bytes each: version offset 8, op offset 8
+ *	index_offset	8 bytes, where the entries start
+ *	count		4 bytes
+ *	magic		4 bytes, "RSDX"
+ *
+ * An entry is made for the first op that starts at least
+ * DELTA_INDEX_STEP bytes into the version after the previous entry, so a
+ * reader after a byte range (see delta_chain_open_lazy()) parses only
+ * the ops near it.
+ *
+ * Older backups were written as text lines ("[delta file metadata] ...",
+ * "match token = ...", "unmatch data length = ...").  Those files are
+ * still understood by delta_open(), which presents them through the same
+ * op interface.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, visit the http://fsf.org website.
+ */
+
+#include "rsync.h"
+#include "inums.h"
+
+extern int backup_compression;
+
+#define DELTA_MAGIC "RSDL"
+#define DELTA_HEADER_LEN 40
+#define DELTA_TEXT_LINE_MAX 1024
+
+#define DELTA_OPCODE_END	0x00
+#define DELTA_OPCODE_COPY	0x01
+#define DELTA_OPCODE_LITERAL	0x02
+
+#define DELTA_INDEX_MAGIC "RSDX"
+#define DELTA_INDEX_ENTRY_LEN 16	/* the trailer is this long too */
+#define DELTA_INDEX_STEP (256*1024)
+
+struct delta_index_entry {
+	OFF_T pos;		/* where the op's bytes start in the version */
+	OFF_T op;		/* where the op starts in the delta */
+};
+
+/* Data that is not handed to copy_file_range() is moved through a
+ * buffer of this size when a delta is applied, however long the op. */
+#define DELTA_IO_SIZE (256*1024)
+
+/* Literal data is gathered into LITERAL ops of up to this much, so that
+ * a rewritten region becomes a few long ops (which delta_apply() hands to
+ * copy_file_range()) rather than one op per token received. */
+#define DELTA_LITERAL_MAX (1024*1024)
+
+#if defined HAVE_SYS_IOCTL_H && defined __linux__ && !defined FICLONE
+#define FICLONE _IOW(0x94, 9, int)
+#endif
+
+static int df_write(struct delta_file *df, const void *buf, int32 len)
+{
+	if (df->zf) {
+		df->zpos += len;
+		return zframe_write(df->zf, buf, len);
+	}
+	return fwrite(buf, 1, len, df->fp) == (size_t)len ? 0 : -1;
+}
+
+static int df_getc(struct delta_file *df)
+{
+	char ch;
+
+	if (!df->zf)
+		return getc(df->fp);
+	if (zframe_read(df->zf, df->zpos, &ch, 1) != 1)
+		return EOF;
+	df->zpos++;
+	return (uchar)ch;
+}
+
+static int32 df_read(struct delta_file *df, char *buf, int32 len)
+{
+	int32 n;
+
+	if (!df->zf)
+		return fread(buf, 1, len, df->fp);
+	if ((n = zframe_read(df->zf, df->zpos, buf, len)) > 0)
+		df->zpos += n;
+	return n;
+}
+
+static OFF_T df_tell(struct delta_file *df)
+{
+	return df->zf ? df->zpos : ftello(df->fp);
+}
+
+static int df_skip(struct delta_file *df, OFF_T len)
+{
+	if (!df->zf)
+		return fseeko(df->fp, len, SEEK_CUR);
+	df->zpos += len;
+	return 0;
+}
+
+static int df_seek(struct delta_file *df, OFF_T pos)
+{
+	df->literal_left = 0;
+	if (!df->zf)
+		return fseeko(df->fp, pos, SEEK_SET);
+	df->zpos = pos;
+	return 0;
+}
+
+static int write_varint64(struct delta_file *df, int64 x)
+{
+	char b[10];
+	int cnt = 0;
+
+	do {
+		b[cnt] = x & 0x7F;
+		x >>= 7;
+		if (x)
+			b[cnt] |= 0x80;
+		cnt++;
+	} while (x);
+
+	return df_write(df, b, cnt);
+}
+
+static int read_varint64(struct delta_file *df, int64 *xp)
+{
+	int64 x = 0;
+	int shift, ch;
+
+	for (shift = 0; shift < 63; shift += 7) {
+		if ((ch = df_getc(df)) == EOF)
+			return -1;
+		x |= (int64)(ch & 0x7F) << shift;
+		if (!(ch & 0x80)) {
+			*xp = x;
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+/* Create fname and write the binary header, compressed at level if it
+ * is not 0.  Returns NULL (after reporting the problem) if the file
+ * can't be created. */
+static struct delta_file *create_delta(const char *fname, const struct delta_header *hdr, int level)
+{
+	struct delta_file *df;
+	char buf[DELTA_HEADER_LEN];
+
+	if (!(df = new0(struct delta_file)))
+		out_of_memory("delta_create");
+
+	if (!(df->fp = fopen(fname, "wb"))) {
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(fname));
+		free(df);
+		return NULL;
+	}
+	if (level && !(df->zf = zframe_create(fileno(df->fp), level))) {
+		rsyserr(FERROR_XFER, errno, "write %s", full_fname(fname));
+		fclose(df->fp);
+		free(df);
+		return NULL;
+	}
+	df->writing = 1;
+	df->hdr = *hdr;
+	df->hdr.format = DELTA_FORMAT_BINARY;
+	df->flags = DELTA_FLAG_INDEXED;
+	df->ops_start = DELTA_HEADER_LEN;
+
+	memset(buf, 0, sizeof buf);
+	memcpy(buf, DELTA_MAGIC, 4);
+	CVAL(buf, 4) = DELTA_FORMAT_VERSION;
+	CVAL(buf, 5) = df->flags;
+	SIVAL64(buf, 8, (int64)hdr->file_size);
+	SIVAL64(buf, 16, (int64)hdr->content_size);
+	SIVAL(buf, 24, hdr->block_size);
+	SIVAL(buf, 28, hdr->block_count);
+	SIVAL(buf, 32, hdr->remainder);
+
+	if (df_write(df, buf, sizeof buf) < 0) {
+		rsyserr(FERROR_XFER, errno, "write %s", full_fname(fname));
+		if (df->zf)
+			zframe_close(df->zf);
+		fclose(df->fp);
+		free(df);
+		return NULL;
+	}
+
+	return df;
+}
+
+/* Create a delta file for a new backup version, compressed when the
+ * module has "backup compression" set. */
+struct delta_file *delta_create(const char *fname, const struct delta_header *hdr)
+{
+	return create_delta(fname, hdr, backup_compression);
+}
+
+/* Add an index entry for the op about to be written if the last one is
+ * DELTA_INDEX_STEP or more bytes of the version behind. */
+static void index_op(struct delta_file *df)
+{
+	struct delta_index_entry *e;
+	OFF_T last = df->index_count ? df->index[df->index_count - 1].pos : 0;
+
+	if (df->out_pos < last + DELTA_INDEX_STEP)
+		return;
+
+	if (df->index_count == df->index_malloced) {
+		df->index_malloced = df->index_malloced ? df->index_malloced * 2 : 64;
+		if (!(df->index = realloc_array(df->index, struct delta_index_entry, df->index_malloced)))
+			out_of_memory("index_op");
+	}
+	e = df->index + df->index_count++;
+	e->pos = df->out_pos;
+	e->op = df_tell(df);
+}
+
+static int write_index(struct delta_file *df)
+{
+	char buf[DELTA_INDEX_ENTRY_LEN];
+	OFF_T index_offset = df_tell(df);
+	int32 i;
+
+	for (i = 0; i < df->index_count; i++) {
+		SIVAL64(buf, 0, (int64)df->index[i].pos);
+		SIVAL64(buf, 8, (int64)df->index[i].op);
+		if (df_write(df, buf, sizeof buf) < 0)
+			return -1;
+	}
+	SIVAL64(buf, 0, (int64)index_offset);
+	SIVAL(buf, 8, df->index_count);
+	memcpy(buf + 12, DELTA_INDEX_MAGIC, 4);
+
+	return df_write(df, buf, sizeof buf);
+}
+
+static int flush_copy(struct delta_file *df)
+{
+	char op = DELTA_OPCODE_COPY;
+
+	if (!df->copy_len)
+		return 0;
+	index_op(df);
+	if (df_write(df, &op, 1) < 0
+	 || write_varint64(df, (int64)df->copy_offset) < 0
+	 || write_varint64(df, (int64)df->copy_len) < 0)
+		return -1;
+	df->out_pos += df->copy_len;
+	df->copy_len = 0;
+	df->op_count++;
+	return 0;
+}
+
+static int flush_literal(struct delta_file *df)
+{
+	char op = DELTA_OPCODE_LITERAL;
+
+	if (!df->lit_len)
+		return 0;
+	index_op(df);
+	if (df_write(df, &op, 1) < 0
+	 || write_varint64(df, (int64)df->lit_len) < 0
+	 || df_write(df, df->lit_buf, df->lit_len) < 0)
+		return -1;
+	df->out_pos += df->lit_len;
+	df->lit_len = 0;
+	df->op_count++;
+	return 0;
+}
+
+/* Record that len bytes at offset in the basis file come next.  A copy
+ * that starts where the pending one ends just extends it, so a run of
+ * matched blocks turns into a single COPY op. */
+int delta_write_copy(struct delta_file *df, OFF_T offset, OFF_T len)
+{
+	if (flush_literal(df) < 0)
+		return -1;
+	if (df->copy_len && df->copy_offset + df->copy_len == offset) {
+		df->copy_len += len;
+		return 0;
+	}
+	if (flush_copy(df) < 0)
+		return -1;
+	df->copy_offset = offset;
+	df->copy_len = len;
+	return 0;
+}
+
+/* Record len bytes of data that were not found in the basis file.  It
+ * is added to the pending LITERAL, which is written out when a COPY
+ * follows or it reaches DELTA_LITERAL_MAX. */
+int delta_write_literal(struct delta_file *df, const char *buf, int32 len)
+{
+	if (flush_copy(df) < 0)
+		return -1;
+	if (!df->lit_buf && !(df->lit_buf = new_array(char, DELTA_LITERAL_MAX)))
+		out_of_memory("delta_write_literal");
+	while (len > 0) {
+		int32 n = MIN(len, DELTA_LITERAL_MAX - df->lit_len);
+		memcpy(df->lit_buf + df->lit_len, buf, n);
+		df->lit_len += n;
+		df->literal_bytes += n;
+		buf += n;
+		len -= n;
+		if (df->lit_len == DELTA_LITERAL_MAX && flush_literal(df) < 0)
+			return -1;
+	}
+	return 0;
+}
+
+/* The deflate level for a backup file made from the version dc
+ * describes.  One made from a compressed version stays compressed, so a
+ * module keeps its format when deferred compaction (which never reads
+ * rsyncd.conf) rewrites it. */
+static int output_level(const struct delta_chain *dc)
+{
+	if (backup_compression || !dc)
+		return backup_compression;
+	return dc->zfs[0] ? ZFRAME_DEFAULT_LEVEL : 0;
+}
+
+/* The legacy text header is a single line; everything after it is ops. */
+static int read_text_header(struct delta_file *df)
+{
+	char line[DELTA_TEXT_LINE_MAX];
+	long file_size, content_size;
+	int block_size, block_count, remainder;
+
+	if (!fgets(line, sizeof line, df->fp))
+		return -1;
+	if (sscanf(line, "[delta file metadata] file_size = %ld, content_size = %ld, block_size = %d, block_count = %d, remainder_block = %d",
+		   &file_size, &content_size, &block_size, &block_count, &remainder) != 5)
+		return -1;
+
+	df->hdr.file_size = file_size;
+	df->hdr.content_size = content_size;
+	df->hdr.block_size = block_size;
+	df->hdr.block_count = block_count;
+	df->hdr.remainder = remainder;
+	df->hdr.format = DELTA_FORMAT_TEXT;
+
+	return 0;
+}
+
+static int read_binary_header(struct delta_file *df)
+{
+	char buf[DELTA_HEADER_LEN];
+
+	if (df_read(df, buf, sizeof buf) != sizeof buf
+	 || memcmp(buf, DELTA_MAGIC, 4) != 0)
+		return -1;
+
+	if (CVAL(buf, 4) > DELTA_FORMAT_VERSION) {
+		rprintf(FERROR_XFER, "delta file version %d is newer than this rsync supports\n",
+			CVAL(buf, 4));
+		return -1;
+	}
+
+	df->hdr.file_size = (OFF_T)IVAL64(buf, 8);
+	df->hdr.content_size = (OFF_T)IVAL64(buf, 16);
+	df->hdr.block_size = IVAL(buf, 24);
+	df->hdr.block_count = IVAL(buf, 28);
+	df->hdr.remainder = IVAL(buf, 32);
+	df->hdr.format = DELTA_FORMAT_BINARY;
+	df->flags = CVAL(buf, 5);
+
+	return 0;
+}
+
+/* Open a delta file of either format for reading.  The header is
+ * available in df->hdr once this returns. */
+struct delta_file *delta_open(const char *fname)
+{
+	struct delta_file *df;
+	int ch, ret;
+
+	if (!(df = new0(struct delta_file)))
+		out_of_memory("delta_open");
+
+	if (!(df->fp = fopen(fname, "rb"))) {
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(fname));
+		free(df);
+		return NULL;
+	}
+
+	/* Only binary deltas are ever compressed. */
+	if ((ret = zframe_open(fname, fileno(df->fp), &df->zf)) == 0) {
+		rewind(df->fp);
+		if ((ch = getc(df->fp)) != EOF)
+			ungetc(ch, df->fp);
+		ret = ch == '[' ? read_text_header(df) : read_binary_header(df);
+	} else if (ret > 0)
+		ret = read_binary_header(df);
+	if (ret < 0) {
+		rprintf(FERROR_XFER, "invalid delta file header in %s\n", full_fname(fname));
+		if (df->zf)
+			zframe_close(df->zf);
+		fclose(df->fp);
+		free(df);
+		return NULL;
+	}
+	df->ops_start = df_tell(df);
+
+	return df;
+}
+
+static int read_text_op(struct delta_file *df, struct delta_op *op)
+{
+	char line[DELTA_TEXT_LINE_MAX];
+	long offset, offset2, len;
+	int token;
+
+	while (fgets(line, sizeof line, df->fp)) {
+		if (*line == '\n' || (*line == '\r' && line[1] == '\n'))
+			continue;
+		if (sscanf(line, "match token = %d, offset = %ld, offset2 = %ld",
+			   &token, &offset, &offset2) == 3) {
+			op->type = DELTA_OP_COPY;
+			op->offset = offset2;
+			if (token == df->hdr.block_count - 1 && df->hdr.remainder)
+				op->len = df->hdr.remainder;
+			else
+				op->len = df->hdr.block_size;
+			return 1;
+		}
+		if (sscanf(line, "unmatch data length = %ld, offset = %ld",
+			   &len, &offset) == 2) {
+			op->type = DELTA_OP_LITERAL;
+			op->offset = ftello(df->fp);
+			op->len = len;
+			df->literal_left = len;
+			return 1;
+		}
+		return -1;
+	}
+
+	return ferror(df->fp) ? -1 : 0;
+}
+
+static int read_binary_op(struct delta_file *df, struct delta_op *op)
+{
+	int64 offset, len;
+	int ch;
+
+	switch ((ch = df_getc(df))) {
+	case DELTA_OPCODE_END:
+		return 0;
+	case DELTA_OPCODE_COPY:
+		if (read_varint64(df, &offset) < 0 || read_varint64(df, &len) < 0)
+			return -1;
+		op->type = DELTA_OP_COPY;
+		op->offset = (OFF_T)offset;
+		op->len = (OFF_T)len;
+		return 1;
+	case DELTA_OPCODE_LITERAL:
+		if (read_varint64(df, &len) < 0)
+			return -1;
+		op->type = DELTA_OP_LITERAL;
+		op->offset = df_tell(df);
+		op->len = (OFF_T)len;
+		df->literal_left = op->len;
+		return 1;
+	default:
+		return -1;
+	}
+}
+
+/* Fetch the next op.  Returns 1 for an op, 0 at the end of the delta,
+ * and -1 if the file is damaged.  Any literal data that the caller did
+ * not consume with delta_read_literal() is skipped. */
+int delta_read_op(struct delta_file *df, struct delta_op *op)
+{
+	int ret;
+
+	if (df->literal_left) {
+		if (df_skip(df, df->literal_left) < 0)
+			return -1;
+		df->literal_left = 0;
+	}
+
+	if (df->hdr.format == DELTA_FORMAT_TEXT)
+		ret = read_text_op(df, op);
+	else
+		ret = read_binary_op(df, op);
+	if (ret > 0) {
+		df->op_count++;
+		df->out_pos += op->len;
+		if (op->type == DELTA_OP_LITERAL)
+			df->literal_bytes += op->len;
+	}
+
+	return ret;
+}
+
+/* Read up to len bytes of the current literal op's data. */
+int32 delta_read_literal(struct delta_file *df, char *buf, int32 len)
+{
+	int32 n;
+
+	if (len > df->literal_left)
+		len = (int32)df->literal_left;
+	if (len <= 0)
+		return 0;
+
+	if ((n = df_read(df, buf, len)) > 0)
+		df->literal_left -= n;
+
+	return n == len ? len : -1;
+}
+
+/* Write out the COPY or LITERAL that is still being gathered, after
+ * which op_count and literal_bytes are the totals of the whole file. */
+int delta_flush(struct delta_file *df)
+{
+	if (!df->writing)
+		return 0;
+	return flush_literal(df) < 0 || flush_copy(df) < 0 ? -1 : 0;
+}
+
+/* Finish a delta file.  For a file being written this adds the END op
+ * and reports any write error that stdio has been holding on to. */
+int delta_close(struct delta_file *df)
+{
+	char op = DELTA_OPCODE_END;
+	int ret = 0;
+
+	if (df->writing && (delta_flush(df) < 0
+			 || df_write(df, &op, 1) < 0 || write_index(df) < 0))
+		ret = -1;
+	if (df->zf && zframe_close(df->zf) < 0)
+		ret = -1;
+	if (fclose(df->fp) != 0)
+		ret = -1;
+	if (df->index)
+		free(df->index);
+	if (df->lit_buf)
+		free(df->lit_buf);
+	free(df);
+
+	return ret;
+}
+
+/* Read the offset index of an indexed delta.  One without an index (or
+ * with a damaged one) is simply scanned from its first op. */
+static void load_index(struct delta_file *df)
+{
+	char buf[DELTA_INDEX_ENTRY_LEN];
+	OFF_T end, index_offset;
+	int32 i, count;
+
+	df->index_loaded = 1;
+	if (!(df->flags & DELTA_FLAG_INDEXED))
+		return;
+
+	if (df->zf)
+		end = df->zf->size;
+	else if (fseeko(df->fp, 0, SEEK_END) < 0 || (end = ftello(df->fp)) < 0)
+		return;
+	if (end < df->ops_start + DELTA_INDEX_ENTRY_LEN
+	 || df_seek(df, end - DELTA_INDEX_ENTRY_LEN) < 0
+	 || df_read(df, buf, sizeof buf) != sizeof buf
+	 || memcmp(buf + 12, DELTA_INDEX_MAGIC, 4) != 0)
+		return;
+	index_offset = (OFF_T)IVAL64(buf, 0);
+	count = IVAL(buf, 8);
+	if (count <= 0 || index_offset < df->ops_start
+	 || index_offset + (OFF_T)count * DELTA_INDEX_ENTRY_LEN != end - DELTA_INDEX_ENTRY_LEN
+	 || df_seek(df, index_offset) < 0)
+		return;
+
+	if (!(df->index = new_array(struct delta_index_entry, count)))
+		out_of_memory("load_index");
+	for (i = 0; i < count; i++) {
+		if (df_read(df, buf, sizeof buf) != sizeof buf) {
+			free(df->index);
+			df->index = NULL;
+			return;
+		}
+		df->index[i].pos = (OFF_T)IVAL64(buf, 0);
+		df->index[i].op = (OFF_T)IVAL64(buf, 8);
+	}
+	df->index_count = df->index_malloced = count;
+}
+
+/* Position df so that delta_read_op() goes on from an op no later than
+ * the one holding byte pos of the version.  The index keeps that within
+ * DELTA_INDEX_STEP bytes of pos, and a read that moves forward simply
+ * carries on from where the last one stopped. */
+static int seek_op(struct delta_file *df, OFF_T pos)
+{
+	const struct delta_index_entry *e = NULL;
+	int lo = 0, hi, keep = df->index_loaded && df->out_pos <= pos;
+
+	if (!df->index_loaded)
+		load_index(df);
+
+	for (hi = df->index_count - 1; lo <= hi; ) {
+		int mid = (lo + hi) / 2;
+		if (df->index[mid].pos <= pos) {
+			e = df->index + mid;
+			lo = mid + 1;
+		} else
+			hi = mid - 1;
+	}
+	if (keep && (!e || e->pos <= df->out_pos))
+		return 0;
+
+	if (df_seek(df, e ? e->op : df->ops_start) < 0)
+		return -1;
+	df->out_pos = e ? e->pos : 0;
+
+	return 0;
+}
+
+/* Copy len bytes at offset in src_fd to the current position of
+ * dest_fd.  A whole COPY run is handed to copy_file_range() when we have
+ * it, so a long unchanged stretch costs a few syscalls and no copying
+ * through user space; otherwise (or if the kernel refuses this pair of
+ * files, e.g. across filesystems) it goes through buf in DELTA_IO_SIZE
+ * pieces.  Only a kernel without the call turns it off for good: other
+ * pairs of files may still be copied by it. */
+static int copy_fd_range(int src_fd, OFF_T offset, OFF_T len, int dest_fd, char *buf)
+{
+#ifdef HAVE_COPY_FILE_RANGE
+	static int no_copy_range = 0;
+
+	while (len > 0 && !no_copy_range) {
+		loff_t off = offset;
+		ssize_t n = copy_file_range(src_fd, &off, dest_fd, NULL, (size_t)MIN(len, (OFF_T)1 << 30), 0);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			if (errno == ENOSYS)
+				no_copy_range = 1;
+			else if (errno != EXDEV && errno != EINVAL
+			      && errno != EOPNOTSUPP && errno != EBADF)
+				return -1;
+			break;
+		}
+		if (n == 0) {
+			errno = ENODATA;
+			return -1;
+		}
+		offset += n;
+		len -= n;
+	}
+	if (len == 0)
+		return 0;
+#endif
+
+	if (do_lseek(src_fd, offset, SEEK_SET) != offset)
+		return -1;
+	while (len > 0) {
+		ssize_t n = read(src_fd, buf, (size_t)MIN(len, DELTA_IO_SIZE));
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		if (n == 0) {
+			errno = ENODATA;
+			return -1;
+		}
+		if (full_write(dest_fd, buf, n) != n)
+			return -1;
+		len -= n;
+	}
+
+	return 0;
+}
+
+/* Write the rest of the current literal op of df to the current position
+ * of dest_fd.  A long op in an uncompressed delta file goes straight from
+ * the delta's fd to copy_fd_range() (the stdio stream is repositioned past
+ * it afterwards); anything else is read through buf. */
+static int copy_literal(struct delta_file *df, int dest_fd, char *buf)
+{
+	OFF_T len = df->literal_left;
+
+	if (!df->zf && len >= DELTA_IO_SIZE) {
+		OFF_T pos = ftello(df->fp);
+		if (pos < 0 || copy_fd_range(fileno(df->fp), pos, len, dest_fd, buf) < 0
+		 || fseeko(df->fp, pos + len, SEEK_SET) < 0)
+			return -1;
+		df->literal_left = 0;
+		return 0;
+	}
+
+	while (len > 0) {
+		int32 n = delta_read_literal(df, buf, (int32)MIN(len, DELTA_IO_SIZE));
+		if (n <= 0) {
+			errno = ENODATA;
+			return -1;
+		}
+		if (full_write(dest_fd, buf, n) != n)
+			return -1;
+		len -= n;
+	}
+
+	return 0;
+}
+
+/* Rebuild a version of a file: read the ops in delta_fname and write
+ * the result to dest_fname, taking matched data from basis_fname.
+ * Returns 0 on success, -1 on error. */
+int delta_apply(const char *basis_fname, const char *delta_fname, const char *dest_fname)
+{
+	struct delta_file *df;
+	struct delta_op op;
+	STRUCT_STAT st;
+	OFF_T run_offset = 0, run_len = 0;
+	char *buf;
+	int basis_fd, dest_fd, ret;
+
+	if (!(df = delta_open(delta_fname)))
+		return -1;
+
+	if ((basis_fd = do_open(basis_fname, O_RDONLY, 0)) < 0) {
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(basis_fname));
+		delta_close(df);
+		return -1;
+	}
+	if (do_fstat(basis_fd, &st) < 0) {
+		rsyserr(FERROR_XFER, errno, "fstat %s", full_fname(basis_fname));
+		close(basis_fd);
+		delta_close(df);
+		return -1;
+	}
+
+	if ((dest_fd = do_open(dest_fname, O_WRONLY|O_CREAT|O_TRUNC, 0600)) < 0) {
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(dest_fname));
+		close(basis_fd);
+		delta_close(df);
+		return -1;
+	}
+
+	if (!(buf = new_array(char, DELTA_IO_SIZE)))
+		out_of_memory("delta_apply");
+
+	/* Adjacent COPY ops (every matched block in an old text delta) are
+	 * gathered into one run before anything is copied. */
+	while ((ret = delta_read_op(df, &op)) >= 0) {
+		OFF_T len = op.len;
+		if (ret > 0 && op.type == DELTA_OP_COPY) {
+			if (op.offset < 0 || op.offset + len > st.st_size) {
+				rprintf(FERROR_XFER, "%s refers past the end of %s\n",
+					full_fname(delta_fname), full_fname(basis_fname));
+				ret = -1;
+				goto done;
+			}
+			if (run_len && run_offset + run_len == op.offset) {
+				run_len += len;
+				continue;
+			}
+		}
+		if (run_len && copy_fd_range(basis_fd, run_offset, run_len, dest_fd, buf) < 0) {
+			rsyserr(FERROR_XFER, errno, "copy from %s to %s",
+				full_fname(basis_fname), full_fname(dest_fname));
+			ret = -1;
+			goto done;
+		}
+		run_len = 0;
+		if (ret == 0)
+			break;
+		if (op.type == DELTA_OP_COPY) {
+			run_offset = op.offset;
+			run_len = len;
+			continue;
+		}
+		if (copy_literal(df, dest_fd, buf) < 0)
+			goto literal_error;
+	}
+	if (ret < 0)
+		rprintf(FERROR_XFER, "invalid op in delta file %s\n", full_fname(delta_fname));
+	goto done;
+
+  literal_error:
+	rsyserr(FERROR_XFER, errno, "copy literal data from %s to %s",
+		full_fname(delta_fname), full_fname(dest_fname));
+	ret = -1;
+
+  done:
+	free(buf);
+	close(basis_fd);
+	delta_close(df);
+	if (close(dest_fd) < 0 && ret >= 0) {
+		rsyserr(FERROR_XFER, errno, "close failed on %s", full_fname(dest_fname));
+		ret = -1;
+	}
+
+	return ret < 0 ? -1 : 0;
+}
+
+/* Like delta_apply(), but dest_fname starts as a reflink clone of
+ * basis_fname, so only the ranges that the delta moves or replaces are
+ * written; a COPY of a block to its own offset costs nothing.  Returns 1
+ * (and leaves no dest_fname) when the filesystem can't clone, so that
+ * the caller can fall back to delta_apply(). */
+int delta_apply_cloned(const char *basis_fname, const char *delta_fname, const char *dest_fname)
+{
+#ifdef FICLONE
+	static int no_clone = 0;
+	struct delta_file *df;
+	struct delta_op op;
+	STRUCT_STAT st;
+	OFF_T pos = 0, dest_pos = 0;
+	char *buf;
+	int basis_fd, dest_fd, ret;
+
+	if (no_clone)
+		return 1;
+
+	if ((basis_fd = do_open(basis_fname, O_RDONLY, 0)) < 0) {
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(basis_fname));
+		return -1;
+	}
+	if (do_fstat(basis_fd, &st) < 0) {
+		rsyserr(FERROR_XFER, errno, "fstat %s", full_fname(basis_fname));
+		close(basis_fd);
+		return -1;
+	}
+	if ((dest_fd = do_open(dest_fname, O_WRONLY|O_CREAT|O_TRUNC, 0600)) < 0) {
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(dest_fname));
+		close(basis_fd);
+		return -1;
+	}
+	if (ioctl(dest_fd, FICLONE, basis_fd) < 0) {
+		if (errno == EOPNOTSUPP || errno == ENOTTY || errno == EXDEV
+		 || errno == EINVAL || errno == ENOSYS || errno == EPERM)
+			no_clone = 1;
+		else
+			rsyserr(FERROR_XFER, errno, "clone %s", full_fname(basis_fname));
+		close(dest_fd);
+		close(basis_fd);
+		do_unlink(dest_fname);
+		return no_clone ? 1 : -1;
+	}
+
+	if (!(df = delta_open(delta_fname))) {
+		close(dest_fd);
+		close(basis_fd);
+		do_unlink(dest_fname);
+		return -1;
+	}
+	if (!(buf = new_array(char, DELTA_IO_SIZE)))
+		out_of_memory("delta_apply_cloned");
+
+	while ((ret = delta_read_op(df, &op)) > 0) {
+		OFF_T len = op.len;
+		if (op.type == DELTA_OP_COPY) {
+			if (op.offset < 0 || op.offset + len > st.st_size) {
+				rprintf(FERROR_XFER, "%s refers past the end of %s\n",
+					full_fname(delta_fname), full_fname(basis_fname));
+				ret = -1;
+				break;
+			}
+			if (op.offset == pos) {	/* already there in the clone */
+				pos += len;
+				continue;
+			}
+		}
+		if (dest_pos != pos && do_lseek(dest_fd, pos, SEEK_SET) != pos)
+			goto write_error;
+		if (op.type == DELTA_OP_COPY) {
+			if (copy_fd_range(basis_fd, op.offset, len, dest_fd, buf) < 0)
+				goto write_error;
+			pos += len;
+		} else {
+			if (copy_literal(df, dest_fd, buf) < 0) {
+				rsyserr(FERROR_XFER, errno, "copy literal data from %s to %s",
+					full_fname(delta_fname), full_fname(dest_fname));
+				ret = -1;
+				goto done;
+			}
+			pos += len;
+		}
+		dest_pos = pos;
+	}
+	if (ret < 0)
+		rprintf(FERROR_XFER, "invalid op in delta file %s\n", full_fname(delta_fname));
+	else if (do_ftruncate(dest_fd, pos) < 0)
+		goto write_error;
+	goto done;
+
+  write_error:
+	rsyserr(FERROR_XFER, errno, "write %s", full_fname(dest_fname));
+	ret = -1;
+
+  done:
+	free(buf);
+	close(basis_fd);
+	delta_close(df);
+	if (close(dest_fd) < 0 && ret >= 0) {
+		rsyserr(FERROR_XFER, errno, "close failed on %s", full_fname(dest_fname));
+		ret = -1;
+	}
+	if (ret < 0) {
+		do_unlink(dest_fname);
+		return -1;
+	}
+
+	return 0;
+#else
+	return 1;
+#endif
+}
+
+struct invert_copy {
+	OFF_T old_offset;	/* where the data is in the old version */
+	OFF_T new_offset;	/* where the forward delta put it */
+	OFF_T len;
+};
+
+static int invert_copy_cmp(const void *a, const void *b)
+{
+	const struct invert_copy *x = a, *y = b;
+
+	if (x->old_offset != y->old_offset)
+		return x->old_offset < y->old_offset ? -1 : 1;
+	return x->len > y->len ? -1 : x->len < y->len;
+}
+
+static int write_old_literal(struct delta_file *out, struct delta_chain *old, OFF_T offset, OFF_T len, char *buf)
+{
+	while (len > 0) {
+		int32 n = delta_chain_read(old, offset, buf, (int32)MIN(len, DELTA_IO_SIZE));
+		if (n <= 0) {
+			if (n == 0)
+				errno = ENODATA;
+			return -1;
+		}
+		if (delta_write_literal(out, buf, n) < 0)
+			return -1;
+		offset += n;
+		len -= n;
+	}
+	return 0;
+}
+
+/* Turn fwd_fname, which rebuilds a new version from old_fname, around:
+ * write to dest_fname a delta that rebuilds old_fname from the new
+ * version.  Every part of the old version that the forward delta copied
+ * becomes a COPY from the new version; the rest becomes literal data
+ * read from old_fname.  Returns 0 on success, -1 on error. */
+int delta_invert(const char *fwd_fname, const char *old_fname, const char *dest_fname)
+{
+	struct invert_copy *copies = NULL;
+	int count = 0, malloced = 0, i, ret;
+	struct delta_file *fwd, *out;
+	struct delta_chain *old;
+	struct delta_header hdr;
+	struct delta_op op;
+	OFF_T pos = 0, cur, old_size;
+	char *buf;
+
+	if (!(fwd = delta_open(fwd_fname)))
+		return -1;
+	while ((ret = delta_read_op(fwd, &op)) > 0) {
+		if (op.type == DELTA_OP_COPY) {
+			if (count == malloced) {
+				malloced = malloced ? malloced * 2 : 256;
+				if (!(copies = realloc_array(copies, struct invert_copy, malloced)))
+					out_of_memory("delta_invert");
+			}
+			copies[count].old_offset = op.offset;
+			copies[count].new_offset = pos;
+			copies[count].len = op.len;
+			count++;
+		}
+		pos += op.len;
+	}
+	hdr = fwd->hdr;
+	delta_close(fwd);
+	if (ret < 0) {
+		rprintf(FERROR_XFER, "invalid op in delta file %s\n", full_fname(fwd_fname));
+		free(copies);
+		return -1;
+	}
+	if (count > 1)
+		qsort(copies, count, sizeof copies[0], invert_copy_cmp);
+
+	/* Read the old version through a chain so that it may also be a
+	 * chunk list. */
+	if (!(old = delta_chain_open(old_fname, NULL, 0))) {
+		free(copies);
+		return -1;
+	}
+	old_size = old->size;
+
+	hdr.content_size = pos;
+	hdr.file_size = old_size;
+	if (!(out = create_delta(dest_fname, &hdr, output_level(old)))) {
+		delta_chain_close(old);
+		free(copies);
+		return -1;
+	}
+	if (!(buf = new_array(char, DELTA_IO_SIZE)))
+		out_of_memory("delta_invert");
+
+	/* Walk the old version in order.  A copy that overlaps ones already
+	 * used only contributes the part beyond them. */
+	ret = 0;
+	for (i = 0, cur = 0; i < count && ret == 0; i++) {
+		struct invert_copy *c = copies + i;
+		OFF_T end = MIN(c->old_offset + c->len, old_size);
+		if (end <= cur)
+			continue;
+		if (c->old_offset > cur) {
+			if (write_old_literal(out, old, cur, c->old_offset - cur, buf) < 0)
+				ret = -1;
+			cur = c->old_offset;
+		}
+		if (ret == 0 && delta_write_copy(out, c->new_offset + (cur - c->old_offset), end - cur) < 0)
+			ret = -1;
+		cur = end;
+	}
+	if (ret == 0 && write_old_literal(out, old, cur, old_size - cur, buf) < 0)
+		ret = -1;
+
+	if (ret < 0)
+		rsyserr(FERROR_XFER, errno, "write %s", full_fname(dest_fname));
+	if (delta_close(out) < 0 && ret == 0) {
+		rsyserr(FERROR_XFER, errno, "close failed on %s", full_fname(dest_fname));
+		ret = -1;
+	}
+	free(buf);
+	free(copies);
+	delta_chain_close(old);
+	if (ret < 0)
+		do_unlink(dest_fname);
+
+	return ret;
+}
+
+static void add_extent(struct delta_chain *dc, int src, OFF_T offset, OFF_T len)
+{
+	struct delta_extent *e;
+
+	if (len <= 0)
+		return;
+
+	if (dc->count) {
+		e = dc->ext + dc->count - 1;
+		if (e->src == src && e->offset + e->len == offset) {
+			e->len += len;
+			dc->size += len;
+			return;
+		}
+	}
+
+	if (dc->count == dc->malloced) {
+		dc->malloced = dc->malloced ? dc->malloced * 2 : 64;
+		if (!(dc->ext = realloc_array(dc->ext, struct delta_extent, dc->malloced)))
+			out_of_memory("add_extent");
+	}
+	e = dc->ext + dc->count++;
+	e->pos = dc->size;
+	e->len = len;
+	e->offset = offset;
+	e->src = src;
+	dc->size += len;
+}
+
+/* Index of the extent holding byte pos of the version. */
+static int find_extent(const struct delta_chain *dc, OFF_T pos)
+{
+	int lo = 0, hi = dc->count - 1;
+
+	while (lo < hi) {
+		int mid = (lo + hi + 1) / 2;
+		if (dc->ext[mid].pos <= pos)
+			lo = mid;
+		else
+			hi = mid - 1;
+	}
+
+	return lo;
+}
+
+/* Rewrite dc (which describes the basis of delta number src) so that it
+ * describes the version that delta produces.  A COPY turns into the
+ * pieces of the old extents it covers and a LITERAL into a reference to
+ * the data in the delta file, so nothing but offsets is read. */
+static int compose_delta(struct delta_chain *dc, const char *delta_fname, int src)
+{
+	struct delta_chain out;
+	struct delta_file *df;
+	struct delta_op op;
+	int ret;
+
+	if (!(df = delta_open(delta_fname)))
+		return -1;
+
+	memset(&out, 0, sizeof out);
+	while ((ret = delta_read_op(df, &op)) > 0) {
+		OFF_T pos = op.offset, len = op.len;
+		int i;
+
+		if (op.type == DELTA_OP_LITERAL) {
+			add_extent(&out, src, op.offset, len);
+			continue;
+		}
+		if (pos < 0 || pos + len > dc->size) {
+			rprintf(FERROR_XFER, "%s refers past the end of its basis\n",
+				full_fname(delta_fname));
+			ret = -1;
+			goto done;
+		}
+		for (i = find_extent(dc, pos); len > 0; i++) {
+			struct delta_extent *e = dc->ext + i;
+			OFF_T skip = pos - e->pos;
+			OFF_T n = MIN(e->len - skip, len);
+			add_extent(&out, e->src, e->offset + skip, n);
+			pos += n;
+			len -= n;
+		}
+	}
+	if (ret < 0)
+		rprintf(FERROR_XFER, "invalid op in delta file %s\n", full_fname(delta_fname));
+	else if (out.size != df->hdr.file_size) {
+		rprintf(FERROR_XFER, "%s produced %s bytes instead of %s\n",
+			full_fname(delta_fname), big_num(out.size), big_num(df->hdr.file_size));
+		ret = -1;
+	}
+
+  done:
+	delta_close(df);
+
+	if (ret < 0) {
+		if (out.ext)
+			free(out.ext);
+		return -1;
+	}
+
+	if (dc->ext)
+		free(dc->ext);
+	dc->ext = out.ext;
+	dc->count = out.count;
+	dc->malloced = out.malloced;
+	dc->size = out.size;
+
+	return 0;
+}
+
+static struct delta_chain *chain_open(const char *basis_fname, char *const *delta_fnames,
+				      int ndeltas, int stored, int lazy)
+{
+	struct delta_chain *dc;
+	STRUCT_STAT st;
+	int i;
+
+	if (!(dc = new0(struct delta_chain)))
+		out_of_memory("delta_chain_open");
+	if (!(dc->fds = new_array(int, ndeltas + 1))
+	 || !(dc->zfs = new_array0(struct zframe_file *, ndeltas + 1))
+	 || (lazy && !(dc->dfs = new_array0(struct delta_file *, ndeltas + 1))))
+		out_of_memory("delta_chain_open");
+	for (i = 0; i <= ndeltas; i++)
+		dc->fds[i] = -1;
+	dc->nsrc = ndeltas + 1;
+
+	if ((dc->fds[0] = do_open(basis_fname, O_RDONLY, 0)) < 0
+	 || do_fstat(dc->fds[0], &st) < 0) {
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(basis_fname));
+		delta_chain_close(dc);
+		return NULL;
+	}
+	switch (stored ? chunk_list_open(basis_fname, dc->fds[0], &dc->list) : 0) {
+	case -1:
+		delta_chain_close(dc);
+		return NULL;
+	case 1:
+		st.st_size = dc->list->size;
+		break;
+	case 0:
+		if (!stored)
+			break;
+		switch (zframe_open(basis_fname, dc->fds[0], &dc->zfs[0])) {
+		case -1:
+			delta_chain_close(dc);
+			return NULL;
+		case 1:
+			st.st_size = dc->zfs[0]->size;
+			break;
+		}
+		break;
+	}
+	add_extent(dc, 0, 0, st.st_size);
+
+	for (i = 0; i < ndeltas; i++) {
+		if (lazy ? !(dc->dfs[i] = delta_open(delta_fnames[i]))
+			 : compose_delta(dc, delta_fnames[i], i + 1) < 0) {
+			delta_chain_close(dc);
+			return NULL;
+		}
+		if ((dc->fds[i+1] = do_open(delta_fnames[i], O_RDONLY, 0)) < 0) {
+			rsyserr(FERROR_XFER, errno, "open %s", full_fname(delta_fnames[i]));
+			delta_chain_close(dc);
+			return NULL;
+		}
+		if (zframe_open(delta_fnames[i], dc->fds[i+1], &dc->zfs[i+1]) < 0) {
+			delta_chain_close(dc);
+			return NULL;
+		}
+	}
+	if (lazy && ndeltas)
+		dc->size = dc->dfs[ndeltas - 1]->hdr.file_size;
+
+	return dc;
+}
+
+/* Describe the version reached by applying delta_fnames[0..ndeltas-1] in
+ * turn to the stored version basis_fname (a plain file or a chunk list),
+ * without writing any intermediate files.  The chain's cost grows with
+ * the number of changed extents, not with the length of the chain times
+ * the size of the file. */
+struct delta_chain *delta_chain_open(const char *basis_fname, char *const *delta_fnames, int ndeltas)
+{
+	return chain_open(basis_fname, delta_fnames, ndeltas, 1, 0);
+}
+
+/* Like delta_chain_open(), but nothing is composed up front: each read
+ * looks up the ops covering its range through the deltas' offset
+ * indexes and follows their COPY ops down the chain for just those
+ * bytes.  Opening costs the same however large the version is, which
+ * suits pulling a few ranges out of a big file. */
+struct delta_chain *delta_chain_open_lazy(const char *basis_fname, char *const *delta_fnames, int ndeltas)
+{
+	return chain_open(basis_fname, delta_fnames, ndeltas, 1, 1);
+}
+
+/* A chain over fname as it is, for files outside the backup directories
+ * (whose data could look like anything, a chunk list included). */
+struct delta_chain *delta_chain_open_file(const char *fname)
+{
+	return chain_open(fname, NULL, 0, 0, 0);
+}
+
+/* A chain over the len bytes at offset in fname, which is how a version
+ * kept whole in a small-file pack (see packfile.c) is read. */
+struct delta_chain *delta_chain_open_range(const char *fname, OFF_T offset, OFF_T len)
+{
+	struct delta_chain *dc = chain_open(fname, NULL, 0, 0, 0);
+
+	if (!dc)
+		return NULL;
+	if (offset < 0 || len < 0 || offset + len > dc->size) {
+		rprintf(FERROR_XFER, "%s is shorter than its index says\n", full_fname(fname));
+		delta_chain_close(dc);
+		return NULL;
+	}
+	delta_chain_limit(dc, offset, len);
+
+	return dc;
+}
+
+/* Narrow dc to the len bytes at offset of its version (fewer if the
+ * version ends first); reads and writes then see only that range. */
+void delta_chain_limit(struct delta_chain *dc, OFF_T offset, OFF_T len)
+{
+	struct delta_chain out;
+	OFF_T end;
+	int i;
+
+	offset = MIN(MAX(offset, 0), dc->size);
+	end = offset + MIN(MAX(len, 0), dc->size - offset);
+
+	if (dc->dfs) {
+		dc->base += offset;
+		dc->size = end - offset;
+		return;
+	}
+
+	memset(&out, 0, sizeof out);
+	for (i = find_extent(dc, offset); i < dc->count && offset < end; i++) {
+		struct delta_extent *e = dc->ext + i;
+		OFF_T skip = offset - e->pos;
+		OFF_T n = MIN(e->len - skip, end - offset);
+		add_extent(&out, e->src, e->offset + skip, n);
+		offset += n;
+	}
+
+	if (dc->ext)
+		free(dc->ext);
+	dc->ext = out.ext;
+	dc->count = out.count;
+	dc->malloced = out.malloced;
+	dc->size = out.size;
+}
+
+/* Read len bytes of source src (the basis or a delta) at offset.
+ * Returns the number of bytes read, short only at its end, or -1. */
+static int32 read_source(struct delta_chain *dc, int src, OFF_T offset, char *buf, int32 len)
+{
+	int fd = dc->fds[src];
+	int32 done = 0;
+
+	if (src == 0 && dc->list)
+		return chunk_list_read(dc->list, offset, buf, len);
+	if (dc->zfs[src])
+		return zframe_read(dc->zfs[src], offset, buf, len);
+
+	if (do_lseek(fd, offset, SEEK_SET) != offset)
+		return -1;
+	while (done < len) {
+		int32 n = read(fd, buf + done, len - done);
+		if (n <= 0) {
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n < 0)
+				return -1;
+			break;
+		}
+		done += n;
+	}
+
+	return done;
+}
+
+/* Read len bytes at offset of the version that delta number k of a lazy
+ * chain produces (0 being the basis itself).  Returns the number of
+ * bytes read, short only at the end of that version, or -1. */
+static int32 read_level(struct delta_chain *dc, int k, OFF_T offset, char *buf, int32 len)
+{
+	struct delta_file *df;
+	struct delta_op op;
+	int32 done = 0;
+	int ret;
+
+	if (k == 0)
+		return read_source(dc, 0, offset, buf, len);
+
+	df = dc->dfs[k - 1];
+	if (seek_op(df, offset) < 0)
+		return -1;
+	while (done < len) {
+		OFF_T pos = df->out_pos, skip;
+		int32 n, got;
+
+		if ((ret = delta_read_op(df, &op)) <= 0) {
+			if (ret == 0)
+				break;
+			errno = EINVAL;
+			return -1;
+		}
+		if (df->out_pos <= offset)
+			continue;
+		skip = offset - pos;
+		n = (int32)MIN(op.len - skip, len - done);
+		if (op.type == DELTA_OP_LITERAL)
+			got = read_source(dc, k, op.offset + skip, buf + done, n);
+		else
+			got = read_level(dc, k - 1, op.offset + skip, buf + done, n);
+		if (got != n) {
+			if (got >= 0)
+				errno = ENODATA;
+			return -1;
+		}
+		done += n;
+		offset += n;
+	}
+
+	return done;
+}
+
+static int write_chain(struct delta_chain *dc, const char *dest_fname, int level)
+{
+	struct zframe_file *zf = NULL;
+	int i, dest_fd, ret = 0;
+	char *buf;
+
+	if ((dest_fd = do_open(dest_fname, O_WRONLY|O_CREAT|O_TRUNC, 0600)) < 0) {
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(dest_fname));
+		return -1;
+	}
+	if (level != 0 && !(zf = zframe_create(dest_fd, level)))
+		ret = -1;
+	if (!(buf = new_array(char, DELTA_IO_SIZE)))
+		out_of_memory("delta_chain_write");
+
+	if (dc->dfs) {
+		OFF_T offset;
+		for (offset = 0; offset < dc->size && ret == 0; ) {
+			int32 n = delta_chain_read(dc, offset, buf, DELTA_IO_SIZE);
+			if (n <= 0) {
+				if (n == 0)
+					errno = ENODATA;
+				ret = -1;
+			} else if (zf ? zframe_write(zf, buf, n) < 0 : full_write(dest_fd, buf, n) != n)
+				ret = -1;
+			offset += n;
+		}
+	}
+	for (i = 0; i < dc->count && !dc->dfs && ret == 0; i++) {
+		struct delta_extent *e = dc->ext + i;
+		OFF_T offset = e->offset, len = e->len;
+		if (!zf && !dc->zfs[e->src] && (e->src != 0 || !dc->list)) {
+			if (copy_fd_range(dc->fds[e->src], offset, len, dest_fd, buf) < 0)
+				ret = -1;
+			continue;
+		}
+		while (len > 0 && ret == 0) {
+			int32 n = read_source(dc, e->src, offset, buf, (int32)MIN(len, DELTA_IO_SIZE));
+			if (n <= 0) {
+				if (n == 0)
+					errno = ENODATA;
+				ret = -1;
+			} else if (zf ? zframe_write(zf, buf, n) < 0 : full_write(dest_fd, buf, n) != n)
+				ret = -1;
+			offset += n;
+			len -= n;
+		}
+	}
+	if (zf && zframe_close(zf) < 0)
+		ret = -1;
+	if (ret < 0)
+		rsyserr(FERROR_XFER, errno, "write %s", full_fname(dest_fname));
+
+	free(buf);
+	if (close(dest_fd) < 0 && ret == 0) {
+		rsyserr(FERROR_XFER, errno, "close failed on %s", full_fname(dest_fname));
+		ret = -1;
+	}
+
+	return ret;
+}
+
+/* Write the whole version described by dc to dest_fname, compressed if
+ * a new backup file would be (see output_level()). */
+int delta_chain_write(struct delta_chain *dc, const char *dest_fname)
+{
+	return write_chain(dc, dest_fname, output_level(dc));
+}
+
+/* Write the version described by dc to dest_fname as a plain file. */
+int delta_chain_extract(struct delta_chain *dc, const char *dest_fname)
+{
+	return write_chain(dc, dest_fname, 0);
+}
+
+/* Read up to len bytes of the version described by dc, starting at
+ * offset.  Returns the number of bytes read (short only at the end of
+ * the version) or -1 on a read error. */
+int32 delta_chain_read(struct delta_chain *dc, OFF_T offset, char *buf, int32 len)
+{
+	int32 done = 0;
+	int i;
+
+	if (offset >= dc->size || len <= 0)
+		return 0;
+	if (dc->dfs)
+		return read_level(dc, dc->nsrc - 1, dc->base + offset, buf, (int32)MIN(len, dc->size - offset));
+
+	for (i = find_extent(dc, offset); i < dc->count && done < len; i++) {
+		struct delta_extent *e = dc->ext + i;
+		OFF_T skip = offset - e->pos;
+		int32 n = (int32)MIN(e->len - skip, len - done);
+		int32 got = read_source(dc, e->src, e->offset + skip, buf + done, n);
+
+		if (got != n) {
+			if (got >= 0)
+				errno = ENODATA;
+			return -1;
+		}
+		done += n;
+		offset += n;
+	}
+
+	return done;
+}
+
+/* An MD5 digest of the files dc reads (which backup files never change
+ * in place: a rewrite is a new file) and of the range it covers, so that
+ * a copy of its version can be told apart from one of a chain that
+ * retention has since rebuilt. */
+void delta_chain_fingerprint(struct delta_chain *dc, char *digest)
+{
+	char buf[40];
+	md_context ctx;
+	STRUCT_STAT st;
+	int i;
+
+	md5_begin(&ctx);
+	for (i = 0; i < dc->nsrc; i++) {
+		memset(buf, 0, sizeof buf);
+		if (dc->fds[i] >= 0 && do_fstat(dc->fds[i], &st) == 0) {
+			SIVAL64(buf, 0, (int64)st.st_dev);
+			SIVAL64(buf, 8, (int64)st.st_ino);
+			SIVAL64(buf, 16, (int64)st.st_size);
+			SIVAL64(buf, 24, (int64)st.st_mtime);
+		}
+		md5_update(&ctx, (const uchar *)buf, 32);
+	}
+	SIVAL64(buf, 0, (int64)dc->size);
+	SIVAL64(buf, 8, (int64)(dc->count ? dc->ext[0].offset : dc->base));
+	md5_update(&ctx, (const uchar *)buf, 16);
+	md5_result(&ctx, (uchar *)digest);
+}
+
+void delta_chain_close(struct delta_chain *dc)
+{
+	int i;
+
+	for (i = 0; i < dc->nsrc; i++) {
+		if (dc->fds[i] >= 0)
+			close(dc->fds[i]);
+	}
+	free(dc->fds);
+	if (dc->dfs) {
+		for (i = 0; i < dc->nsrc; i++) {
+			if (dc->dfs[i])
+				delta_close(dc->dfs[i]);
+		}
+		free(dc->dfs);
+	}
+	if (dc->zfs) {
+		for (i = 0; i < dc->nsrc; i++) {
+			if (dc->zfs[i])
+				zframe_close(dc->zfs[i]);
+		}
+		free(dc->zfs);
+	}
+	if (dc->list)
+		chunk_list_close(dc->list);
+	if (dc->ext)
+		free(dc->ext);
+	free(dc);
+}
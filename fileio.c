@@ -228,6 +228,18 @@ struct map_struct *map_file(int fd, OFF_T len, int32 read_size, int32 blk_size)
 	return map;
 }
 
+/* Map a version that only exists as a composed delta chain (see
+ * delta_chain_open()); map_ptr() then reads through the chain's extents
+ * instead of from a file.  The caller still owns dc. */
+struct map_struct *map_delta_chain(struct delta_chain *dc, int32 read_size, int32 blk_size)
+{
+	struct map_struct *map = map_file(-1, dc->size, read_size, blk_size);
+
+	map->chain = dc;
+
+	return map;
+}
+
 
 /* slide the read window in the file */
 char *map_ptr(struct map_struct *map, OFF_T offset, int32 len)
@@ -283,7 +295,8 @@ char *map_ptr(struct map_struct *map, OFF_T offset, int32 len)
 		exit_cleanup(RERR_FILEIO);
 	}
 
-	if (map->p_fd_offset != read_start) {
+#ifndef HAVE_PREAD
+	if (map->p_fd_offset != read_start && !map->chain) {
 		OFF_T ret = do_lseek(map->fd, read_start, SEEK_SET);
 		// rprintf(FWARNING, "[yee-%s] fileio.c: map_ptr: do_lseek(%d, %s, SEEK_SET) = %s\n", 
 		// who_am_i(), map->fd, big_num(read_start), big_num(ret));
@@ -294,11 +307,29 @@ char *map_ptr(struct map_struct *map, OFF_T offset, int32 len)
 		}
 		map->p_fd_offset = read_start;
 	}
+#endif
 	map->p_offset = window_start;
 	map->p_len = window_size;
 
+#ifdef HAVE_PREAD
+	/* Reading at an offset leaves the fd's own offset alone, so forked
+	 * processes can map the same open file (see match.c). */
+	map->p_fd_offset = read_start;
+#else
+	if (map->chain)
+		map->p_fd_offset = read_start;
+#endif
+
 	while (read_size > 0) {
-		int32 nread = read(map->fd, map->p + read_offset, read_size);
+#ifdef HAVE_PREAD
+		int32 nread = map->chain
+			    ? delta_chain_read(map->chain, map->p_fd_offset, map->p + read_offset, read_size)
+			    : pread(map->fd, map->p + read_offset, read_size, map->p_fd_offset);
+#else
+		int32 nread = map->chain
+			    ? delta_chain_read(map->chain, map->p_fd_offset, map->p + read_offset, read_size)
+			    : read(map->fd, map->p + read_offset, read_size);
+#endif
 		if (nread <= 0) {
 			if (!map->status)
 				map->status = nread ? errno : ENODATA;
@@ -115,6 +115,9 @@ extern struct chmod_mode_struct *chmod_modes;
 extern filter_rule_list filter_list;
 extern filter_rule_list daemon_filter_list;
 
+extern char *recovery_version;
+extern char *recovery_range;
+
 #ifdef ICONV_OPTION
 extern int filesfrom_convert;
 extern iconv_t ic_send, ic_recv;
@@ -357,6 +360,22 @@ static void flist_done_allocating(struct file_list *flist)
 		flist->pool_boundary = ptr;
 }
 
+/* Put the absolute path of the directory that change_pathname() would
+ * chdir() to for file (the starting directory if file is NULL) in buf. */
+char *pathname_dir(struct file_struct *file, char *buf, int bufsize)
+{
+	const char *dir = file ? F_PATHNAME(file) : NULL;
+
+	if (!dir)
+		strlcpy(buf, orig_dir, bufsize);
+	else if (*dir == '/')
+		strlcpy(buf, dir, bufsize);
+	else
+		pathjoin(buf, bufsize, orig_dir, dir);
+
+	return buf;
+}
+
 /* Call this with EITHER (1) "file, NULL, 0" to chdir() to the file's
  * F_PATHNAME(), or (2) "NULL, dir, dirlen" to chdir() to the supplied dir,
  * with dir == NULL taken to be the starting directory, and dirlen < 0
@@ -1164,8 +1183,9 @@ struct file_struct *make_file(const char *fname, struct file_list *flist,
 	struct file_struct *file;
 	char thisname[MAXPATHLEN];
 	char linkname[MAXPATHLEN];
-	int alloc_len, basename_len, linkname_len;
+	int alloc_len, basename_len, linkname_len, version_sum, covered = 0;
 	int extra_len = file_extra_cnt * EXTRA_LEN;
+	struct catalog_entry *centry;
 	const char *basename;
 	alloc_pool_t *pool;
 	STRUCT_STAT st;
@@ -1185,7 +1205,8 @@ struct file_struct *make_file(const char *fname, struct file_list *flist,
 		 * dir, or a request to delete a specific file. */
 		st = *stp;
 		*linkname = '\0'; /* make IBM code checker happy */
-	} else if (readlink_stat(thisname, &st, linkname) != 0) {
+	} else if (readlink_stat(thisname, &st, linkname) != 0
+		&& (errno != ENOENT || catalog_stat(thisname, &st) < 0)) {
 		int save_errno = errno;
 		/* See if file is excluded before reporting an error. */
 		if (filter_level != NO_FILTERS
@@ -1317,6 +1338,22 @@ struct file_struct *make_file(const char *fname, struct file_list *flist,
 	linkname_len = 0;
 #endif
 
+	// 恢复整个版本时长度和校验和取自该版本, 客户端比对校验和后跳过已是该版本的文件
+	version_sum = always_checksum && am_sender && recovery_version && !recovery_range
+		   && S_ISREG(st.st_mode);
+	// 目录清单记录了该版本时目录中的文件: 之后才创建的文件不恢复, 长度和校验和直接取自清单
+	centry = am_sender && recovery_version && S_ISREG(st.st_mode)
+	       ? catalog_find(thisname, &covered) : NULL;
+	if (!centry && covered)
+		return NULL;
+	if (version_sum && centry) {
+		st.st_size = centry->size;
+		memset(tmp_sum, 0, flist_csum_len);
+		if (centry->csum_type == checksum_type)
+			memcpy(tmp_sum, centry->digest, flist_csum_len);
+	} else if (version_sum)
+		restore_version_sum(thisname, &st, tmp_sum);
+
 #ifdef ST_MTIME_NSEC
 	if (st.ST_MTIME_NSEC && protocol_version >= 31)
 		extra_len += EXTRA_LEN;
@@ -1327,7 +1364,8 @@ struct file_struct *make_file(const char *fname, struct file_list *flist,
 #endif
 
 	if (always_checksum && am_sender && S_ISREG(st.st_mode)) {
-		file_checksum(thisname, &st, tmp_sum);
+		if (!version_sum)
+			file_checksum(thisname, &st, tmp_sum);
 		if (sender_keeps_checksum)
 			extra_len += SUM_EXTRA_CNT * EXTRA_LEN;
 	}
@@ -1727,9 +1765,14 @@ static void send_directory(int f, struct file_list *flist, char *fbuf, int len,
 	int divert_dirs = (flags & FLAG_DIVERT_DIRS) != 0;
 	int start = flist->used;
 	int filter_level = f == -2 ? SERVER_FILTERS : ALL_FILTERS;
+	struct catalog_entry *centry = NULL;
+	int cnt = 0, save_errno;
 
 	assert(flist != NULL);
 
+	if (am_sender && recovery_version)
+		cnt = catalog_children(fbuf, &centry);
+
 	if (!(d = opendir(fbuf))) {
 		if (errno == ENOENT) {
 			if (am_sender) /* Can abuse this for vanished error w/ENOENT: */
@@ -1779,6 +1822,19 @@ static void send_directory(int f, struct file_list *flist, char *fbuf, int len,
 		send_file_name(f, flist, fbuf, NULL, flags, filter_level);
 	}
 
+	/* Restore the files this directory had at the version that have
+	 * been deleted since; make_file() takes their stat from the catalog. */
+	for (save_errno = errno; cnt > 0; cnt--, centry++) {
+		const char *slash = strrchr(centry->path, '/');
+		STRUCT_STAT st;
+		if (!S_ISREG(centry->mode)
+		 || strlcpy(p, slash ? slash + 1 : centry->path, remainder) >= remainder
+		 || do_lstat(fbuf, &st) == 0 || errno != ENOENT)
+			continue;
+		send_file_name(f, flist, fbuf, NULL, flags, filter_level);
+	}
+	errno = save_errno;
+
 	fbuf[len] = '\0';
 
 	if (errno) {
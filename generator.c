@@ -62,6 +62,7 @@ extern int inplace;
 extern int append_mode;
 extern int make_backups;
 extern int csum_length;
+extern int xfersum_type;
 extern int ignore_times;
 extern int size_only;
 extern OFF_T max_size;
@@ -117,6 +118,9 @@ int task_type_backup_or_recovery_generator = -1; // 0: backup, 1: recovery
 
 extern int backup_type;
 extern int backup_version_num;
+extern int signature_sidecars;
+extern int checksum_workers;
+extern char *recovery_range;
 
 enum nonregtype {
     TYPE_DIR, TYPE_SPECIAL, TYPE_DEVICE, TYPE_SYMLINK
@@ -620,7 +624,7 @@ int unchanged_file(char *fn, struct file_struct *file, STRUCT_STAT *st)
  *
  * This might be made one of several selectable heuristics.
  */
-static void sum_sizes_sqroot(struct sum_struct *sum, int64 len)
+void sum_sizes_sqroot(struct sum_struct *sum, int64 len)
 {
 	int32 blength;
 	int s2length;
@@ -669,6 +673,8 @@ static void sum_sizes_sqroot(struct sum_struct *sum, int64 len)
 		s2length = MAX(s2length, csum_length);
 		s2length = MIN(s2length, SUM_LENGTH);
 	}
+	/* A shorter strong checksum (XXH3) is sent whole at most. */
+	s2length = MIN(s2length, csum_len_for_type(xfersum_type, 0));
 
 	sum->flength	= len;
 	sum->blength	= blength;
@@ -692,13 +698,22 @@ static void sum_sizes_sqroot(struct sum_struct *sum, int64 len)
  * Generate and send a stream of signatures/checksums that describe a buffer
  *
  * Generate approximately one checksum every block_len bytes.
+ *
+ * When sidecar names a differential full file (the basis of dc), the
+ * checksums come from its signature sidecar if that matches this
+ * transfer; otherwise they are computed and a new sidecar is written.
  */
-static int generate_and_send_sums(int fd, OFF_T len, int f_out, int f_copy)
+static int generate_and_send_sums(int fd, struct delta_chain *dc, const char *fname, OFF_T len,
+				  int f_out, int f_copy, const char *sidecar)
 {
-	int32 i;
-	struct map_struct *mapbuf;
+	int32 i, group;
+	struct map_struct *mapbuf = NULL;
+	struct sig_sidecar *sig_in = NULL, *sig_out = NULL;
 	struct sum_struct sum;
 	OFF_T offset = 0;
+	char *group_map = NULL, group_sum2[MD_LANES * MAX_DIGEST_LEN];
+	uint32 group_sum1[MD_LANES];
+	int g = 0, group_cnt = 0, workers = 0;
 
 	sum_sizes_sqroot(&sum, len);
 	if (sum.count < 0)
@@ -708,28 +723,67 @@ static int generate_and_send_sums(int fd, OFF_T len, int f_out, int f_copy)
 	if (append_mode > 0 && f_copy < 0)
 		return 0;
 
-	if (len > 0)
-		mapbuf = map_file(fd, len, MAX_MAP_SIZE, sum.blength);
-	else
-		mapbuf = NULL;
+	if (sidecar && f_copy < 0 && sum.count > 0
+	 && !(sig_in = sig_sidecar_open(sidecar, &sum)))
+		sig_out = sig_sidecar_create(sidecar, &sum);
+
+	// 大文件交给校验和进程池按条带并行计算, 按块顺序读回
+	if (!sig_in && f_copy < 0 && checksum_workers > 1)
+		workers = sum_workers_begin(fname, dc != NULL, sum.flength, sum.blength, sum.count) == 0;
+
+	// 每次映射并计算一组块 (最多MD_LANES个), 强校验和在各通道中并行计算
+	group = (int32)MAX(1, MIN(MD_LANES, MAX_MAP_SIZE / sum.blength));
 
 	for (i = 0; i < sum.count; i++) {
 		int32 n1 = (int32)MIN(len, (OFF_T)sum.blength);
-		char *map = map_ptr(mapbuf, offset, n1);
+		char *map;
 		char sum2[SUM_LENGTH];
 		uint32 sum1;
 
 		len -= n1;
 		offset += n1;
 
-		if (f_copy >= 0) {
-			full_write(f_copy, map, n1);
-			if (append_mode > 0)
-				continue;
-		}
+		if (sig_in && sig_sidecar_read(sig_in, &sum1, sum2) < 0) {
+			// 签名文件读取失败, 其余的块改为从全量文件计算
+			sig_sidecar_close(sig_in, 0);
+			sig_in = NULL;
+		}
+
+		if (workers && sum_workers_read(&sum1, sum2) < 0) {
+			// 校验和进程出错, 其余的块由本进程计算
+			workers = 0;
+		}
+
+		if (!sig_in && !workers) {
+			if (!mapbuf && dc)
+				mapbuf = map_delta_chain(dc, MAX_MAP_SIZE, sum.blength);
+			else if (!mapbuf)
+				mapbuf = map_file(fd, sum.flength, MAX_MAP_SIZE, sum.blength);
+			if (g == group_cnt) {
+				int32 group_len = (int32)MIN(len + n1, (OFF_T)group * sum.blength);
+				group_map = map_ptr(mapbuf, offset - n1, group_len);
+				if (f_copy >= 0 && append_mode > 0)
+					group_cnt = (group_len + sum.blength - 1) / sum.blength;
+				else {
+					group_cnt = get_block_sums(group_map, group_len, sum.blength,
+								   group_sum1, group_sum2);
+				}
+				g = 0;
+			}
+			map = group_map + (int32)g * sum.blength;
+			g++;
 
-		sum1 = get_checksum1(map, n1);
-		get_checksum2(map, n1, sum2);
+			if (f_copy >= 0) {
+				full_write(f_copy, map, n1);
+				if (append_mode > 0)
+					continue;
+			}
+
+			sum1 = group_sum1[g - 1];
+			memcpy(sum2, group_sum2 + (g - 1) * MAX_DIGEST_LEN, SUM_LENGTH);
+		}
+		if (!sig_in && sig_out)
+			sig_sidecar_add(sig_out, sum1, sum2);
 
 		if (DEBUG_GTE(DELTASUM, 3)) {
 			rprintf(FINFO,
@@ -741,6 +795,10 @@ static int generate_and_send_sums(int fd, OFF_T len, int f_out, int f_copy)
 		write_buf(f_out, sum2, sum.s2length);
 	}
 
+	if (sig_in)
+		sig_sidecar_close(sig_in, 0);
+	if (sig_out)
+		sig_sidecar_close(sig_out, 1);
 	if (mapbuf)
 		unmap_file(mapbuf);
 
@@ -1175,54 +1233,22 @@ static BOOL is_below(struct file_struct *file, struct file_struct *subtree)
 
 int find_newest_full_backup(const char* fname, char* newest_full_backup)
 {
-	char cwd[MAXPATHLEN];
-	getcwd(cwd, MAXPATHLEN);
-
-	// rprintf(FWARNING, "[yee-%s] generator.c: find_newest_full_backup fname = %s, cwd = %s\n", who_am_i(), fname, cwd);
-	// 分离目录名和文件名
-	char *ptr = strrchr(fname, '/');
-	char dir_name[MAXPATHLEN];
-	char file_name[MAXNAMLEN];
-
-	if(ptr != NULL)
-	{
-		strncpy(dir_name, fname, ptr - fname);
-		dir_name[ptr - fname] = '\0';
-		strcpy(file_name, ptr + 1);
-	}
-	else
-	{
-		strcpy(dir_name, ".");
-		strcpy(file_name, fname);
-	}
-
-	char diff_full_backup_path[MAXPATHLEN];
+	struct backup_manifest manifest;
+	struct backup_version *newest;
 
-	sprintf(diff_full_backup_path, "%s/%s.backup/differential/full/", dir_name, file_name);
-
-	// rprintf(FWARNING, "[yee-%s] generator.c: find_newest_full_backup diff_full_backup_path = %s\n", who_am_i(), diff_full_backup_path);
+	if (manifest_open(&manifest, fname) < 0)
+		return -1;
 
-	if(access(diff_full_backup_path, F_OK) != 0)
+	if ((newest = manifest_newest(&manifest, BACKUP_MODE_DIFFERENTIAL, BACKUP_KIND_FULL)) == NULL)
 	{	
-		// 没有差异备份文件夹, 为首次备份, 则直接返回
+		// 没有差异备份的全量版本, 为首次备份, 则直接返回
 		rprintf(FWARNING, "[yee-%s] generator.c: find_newest_full_backup, first backup for %s\n", who_am_i(), fname);
+		manifest_close(&manifest);
 		return 1;
 	}
 
-	backup_files_list *differental_full_files = (backup_files_list*)malloc(sizeof(backup_files_list));
-
-	int count = read_sort_dir_files(diff_full_backup_path, differental_full_files->file_path);
-	if(count <= 0)
-	{
-		rprintf(FERROR, "[yee-%s] generator.c: find_newest_full_backup: read_sort_dir_files error\n", who_am_i());
-		return -1;
-	}
-	// rprintf(FWARNING, "[yee-%s] generator.c: find_newest_full_backup: count = %d, fname = %s\n", who_am_i(), count, differental_full_files->file_path[count-1]);
-	// differental_full_files->num = count;
-
-	// print_backup_files_list(differental_full_files);
-
-	strcpy(newest_full_backup, differental_full_files->file_path[count-1]);
+	strlcpy(newest_full_backup, newest->path, MAXPATHLEN);
+	manifest_close(&manifest);
 	// rprintf(FWARNING, "[yee-%s] generator.c: find_newest_full_backup: newest_full_backup = %s\n", who_am_i(), newest_full_backup);
 	return 0;
 }
@@ -1252,6 +1278,7 @@ static void recv_generator(char *fname, struct file_struct *file, int ndx,
 	static int need_fuzzy_dirlist = 0;
 	struct file_struct *fuzzy_file = NULL;
 	int fd = -1, f_copy = -1;
+	struct delta_chain *basis_chain = NULL;	/* differential backup: the newest full */
 	stat_x sx, real_sx;
 	STRUCT_STAT partial_st;
 	struct file_struct *back_file = NULL;
@@ -1751,6 +1778,13 @@ static void recv_generator(char *fname, struct file_struct *file, int ndx,
 		goto cleanup;
 	}
 
+	// --recovery_range 只发来版本中的一段, 写到已有文件上会把整个文件换成这一段, 所以只还原到新的目标
+	if (recovery_range && statret == 0) {
+		rprintf(FERROR_XFER, "refusing to replace %s with a --recovery_range fragment"
+			" (restore it to a new destination)\n", full_fname(fname));
+		goto cleanup;
+	}
+
 	fnamecmp_type = FNAMECMP_FNAME;
 
 	if (statret == 0 && !S_ISREG(sx.st.st_mode)) {
@@ -1891,6 +1925,9 @@ static void recv_generator(char *fname, struct file_struct *file, int ndx,
 		{
 			strncpy(fnamecmp, newest_full_backup, MAXPATHLEN);
 			rprintf(FWARNING, "[yee-%s] generator.c: find newest full backup success, fname:%s\n",who_am_i(), fname);
+			// 全量版本可能是块存储中的块列表, 通过delta链读取, 长度也以全量版本为准
+			if((basis_chain = delta_chain_open(fnamecmp, NULL, 0)) == NULL)
+				rprintf(FWARNING, "[yee-%s] generator.c: open newest full backup %s failed\n", who_am_i(), fnamecmp);
 		}
 		else if(ret == -1)
 		{
@@ -1988,11 +2025,13 @@ static void recv_generator(char *fname, struct file_struct *file, int ndx,
 
 	if (statret != 0 || whole_file)
 		write_sum_head(f_out, NULL);
-	else if (sx.st.st_size <= 0) {
+	else if ((basis_chain ? basis_chain->size : sx.st.st_size) <= 0) {
 		write_sum_head(f_out, NULL);
 		close(fd);
 	} else {
-		if (generate_and_send_sums(fd, sx.st.st_size, f_out, f_copy) < 0) {
+		if (generate_and_send_sums(fd, basis_chain, fnamecmp,
+					   basis_chain ? basis_chain->size : sx.st.st_size, f_out, f_copy,
+					   basis_chain && signature_sidecars ? fnamecmp : NULL) < 0) {
 			rprintf(FWARNING,
 			    "WARNING: file is too large for checksum sending: %s\n",
 			    fnamecmp);
@@ -2020,6 +2059,8 @@ static void recv_generator(char *fname, struct file_struct *file, int ndx,
 		}
 		unmake_file(back_file);
 	}
+	if (basis_chain)
+		delta_chain_close(basis_chain);
 
 	free_stat_x(&sx);
 }
@@ -2490,6 +2531,9 @@ void generate_files(int f_out, const char *local_name)
 	 && dir_tweaking && (!inc_recurse || delete_during == 2))
 		touch_up_dirs(dir_flist, -1);
 
+	if (checksum_workers > 1)
+		sum_workers_finish();
+
 	if (DEBUG_GTE(GENR, 1))
 		rprintf(FINFO, "generate_files finished\n");
 }
@@ -1448,6 +1448,13 @@ static void read_a_msg(void)
 		raw_read_buf((char*)&stats.total_read, sizeof stats.total_read);
 		iobuf.in_multiplexed = 1;
 		break;
+	case MSG_CHECKPOINT:
+		if (msg_bytes != 4 || !am_generator)
+			goto invalid_msg;
+		val = raw_read_int();
+		iobuf.in_multiplexed = 1;
+		stats.checkpoint_files++;
+		break;
 	case MSG_REDO:
 		if (msg_bytes != 4 || !am_generator)
 			goto invalid_msg;
@@ -215,6 +215,208 @@ void get_md5(uchar *out, const uchar *input, int n)
 	md5_result(&ctx, out);
 }
 
+#ifdef __GNUC__
+
+/* Hash msgs[0..cnt-1] in the lanes of md_vec, a chunk of each at a time.
+ * A lane that runs out of chunks hashes zeros until the longest message
+ * is done; its digest was saved when its last chunk went through. */
+static inline __attribute__((always_inline))
+void md5_lanes(const md_message *msgs, int cnt, uchar *digests)
+{
+	uint32 W[16][MD_LANES] __attribute__((aligned(MD_LANES * 4)));
+	uint32 total[MD_LANES], chunks[MD_LANES], end[MD_LANES], max_chunks = 0, c;
+	uint32 out[4][MD_LANES] __attribute__((aligned(MD_LANES * 4)));
+	const md_vec *X = (const md_vec *)W, zero = { 0 };
+	md_vec SA, SB, SC, SD;
+	int l;
+
+	for (l = 0; l < MD_LANES; l++) {
+		if (l < cnt) {
+			total[l] = msgs[l].len + (msgs[l].seed_at != MD_SEED_NONE ? 4 : 0);
+			chunks[l] = (total[l] + 8) / CSUM_CHUNK + 1;
+			end[l] = chunks[l] * CSUM_CHUNK - 8;
+			max_chunks = MAX(max_chunks, chunks[l]);
+		} else
+			chunks[l] = 0;
+	}
+
+	SA = zero + 0x67452301;
+	SB = zero + 0xEFCDAB89;
+	SC = zero + 0x98BADCFE;
+	SD = zero + 0x10325476;
+
+	for (c = 0; c < max_chunks; c++) {
+		md_vec A = SA, B = SB, C = SC, D = SD;
+
+		for (l = 0; l < MD_LANES; l++) {
+			if (c < chunks[l]) {
+				md_message_words(msgs + l, c, &W[0][l], MD_LANES, total[l], end[l],
+						 total[l] << 3, total[l] >> 29);
+			} else {
+				int k;
+				for (k = 0; k < 16; k++)
+					W[k][l] = 0;
+			}
+		}
+
+#define F(x,y,z) (z ^ (x & (y ^ z)))
+
+		P(A, B, C, D,  0,  7, 0xD76AA478);
+		P(D, A, B, C,  1, 12, 0xE8C7B756);
+		P(C, D, A, B,  2, 17, 0x242070DB);
+		P(B, C, D, A,  3, 22, 0xC1BDCEEE);
+		P(A, B, C, D,  4,  7, 0xF57C0FAF);
+		P(D, A, B, C,  5, 12, 0x4787C62A);
+		P(C, D, A, B,  6, 17, 0xA8304613);
+		P(B, C, D, A,  7, 22, 0xFD469501);
+		P(A, B, C, D,  8,  7, 0x698098D8);
+		P(D, A, B, C,  9, 12, 0x8B44F7AF);
+		P(C, D, A, B, 10, 17, 0xFFFF5BB1);
+		P(B, C, D, A, 11, 22, 0x895CD7BE);
+		P(A, B, C, D, 12,  7, 0x6B901122);
+		P(D, A, B, C, 13, 12, 0xFD987193);
+		P(C, D, A, B, 14, 17, 0xA679438E);
+		P(B, C, D, A, 15, 22, 0x49B40821);
+
+#undef F
+#define F(x,y,z) (y ^ (z & (x ^ y)))
+
+		P(A, B, C, D,  1,  5, 0xF61E2562);
+		P(D, A, B, C,  6,  9, 0xC040B340);
+		P(C, D, A, B, 11, 14, 0x265E5A51);
+		P(B, C, D, A,  0, 20, 0xE9B6C7AA);
+		P(A, B, C, D,  5,  5, 0xD62F105D);
+		P(D, A, B, C, 10,  9, 0x02441453);
+		P(C, D, A, B, 15, 14, 0xD8A1E681);
+		P(B, C, D, A,  4, 20, 0xE7D3FBC8);
+		P(A, B, C, D,  9,  5, 0x21E1CDE6);
+		P(D, A, B, C, 14,  9, 0xC33707D6);
+		P(C, D, A, B,  3, 14, 0xF4D50D87);
+		P(B, C, D, A,  8, 20, 0x455A14ED);
+		P(A, B, C, D, 13,  5, 0xA9E3E905);
+		P(D, A, B, C,  2,  9, 0xFCEFA3F8);
+		P(C, D, A, B,  7, 14, 0x676F02D9);
+		P(B, C, D, A, 12, 20, 0x8D2A4C8A);
+
+#undef F
+#define F(x,y,z) (x ^ y ^ z)
+
+		P(A, B, C, D,  5,  4, 0xFFFA3942);
+		P(D, A, B, C,  8, 11, 0x8771F681);
+		P(C, D, A, B, 11, 16, 0x6D9D6122);
+		P(B, C, D, A, 14, 23, 0xFDE5380C);
+		P(A, B, C, D,  1,  4, 0xA4BEEA44);
+		P(D, A, B, C,  4, 11, 0x4BDECFA9);
+		P(C, D, A, B,  7, 16, 0xF6BB4B60);
+		P(B, C, D, A, 10, 23, 0xBEBFBC70);
+		P(A, B, C, D, 13,  4, 0x289B7EC6);
+		P(D, A, B, C,  0, 11, 0xEAA127FA);
+		P(C, D, A, B,  3, 16, 0xD4EF3085);
+		P(B, C, D, A,  6, 23, 0x04881D05);
+		P(A, B, C, D,  9,  4, 0xD9D4D039);
+		P(D, A, B, C, 12, 11, 0xE6DB99E5);
+		P(C, D, A, B, 15, 16, 0x1FA27CF8);
+		P(B, C, D, A,  2, 23, 0xC4AC5665);
+
+#undef F
+#define F(x,y,z) (y ^ (x | ~z))
+
+		P(A, B, C, D,  0,  6, 0xF4292244);
+		P(D, A, B, C,  7, 10, 0x432AFF97);
+		P(C, D, A, B, 14, 15, 0xAB9423A7);
+		P(B, C, D, A,  5, 21, 0xFC93A039);
+		P(A, B, C, D, 12,  6, 0x655B59C3);
+		P(D, A, B, C,  3, 10, 0x8F0CCC92);
+		P(C, D, A, B, 10, 15, 0xFFEFF47D);
+		P(B, C, D, A,  1, 21, 0x85845DD1);
+		P(A, B, C, D,  8,  6, 0x6FA87E4F);
+		P(D, A, B, C, 15, 10, 0xFE2CE6E0);
+		P(C, D, A, B,  6, 15, 0xA3014314);
+		P(B, C, D, A, 13, 21, 0x4E0811A1);
+		P(A, B, C, D,  4,  6, 0xF7537E82);
+		P(D, A, B, C, 11, 10, 0xBD3AF235);
+		P(C, D, A, B,  2, 15, 0x2AD7D2BB);
+		P(B, C, D, A,  9, 21, 0xEB86D391);
+
+#undef F
+
+		SA += A;
+		SB += B;
+		SC += C;
+		SD += D;
+
+		for (l = 0; l < cnt; l++) {
+			if (chunks[l] == c + 1)
+				break;
+		}
+		if (l == cnt)
+			continue;
+		*(md_vec *)out[0] = SA;
+		*(md_vec *)out[1] = SB;
+		*(md_vec *)out[2] = SC;
+		*(md_vec *)out[3] = SD;
+		for ( ; l < cnt; l++) {
+			if (chunks[l] != c + 1)
+				continue;
+			SIVALu(digests + l * MD5_DIGEST_LEN, 0, out[0][l]);
+			SIVALu(digests + l * MD5_DIGEST_LEN, 4, out[1][l]);
+			SIVALu(digests + l * MD5_DIGEST_LEN, 8, out[2][l]);
+			SIVALu(digests + l * MD5_DIGEST_LEN, 12, out[3][l]);
+		}
+	}
+}
+
+static void md5_multi_default(const md_message *msgs, int cnt, uchar *digests)
+{
+	md5_lanes(msgs, cnt, digests);
+}
+
+#ifdef SIMD_CHECKSUM
+__attribute__((target("avx2")))
+static void md5_multi_avx2(const md_message *msgs, int cnt, uchar *digests)
+{
+	md5_lanes(msgs, cnt, digests);
+}
+#endif
+
+#endif
+
+/* Put the MD5 digests of msgs[0..cnt-1] (cnt <= MD_LANES) in digests,
+ * MD5_DIGEST_LEN bytes apart. */
+void md5_multi(const md_message *msgs, int cnt, uchar *digests)
+{
+#ifdef __GNUC__
+#ifdef SIMD_CHECKSUM
+	static int avx2 = -1;
+
+	if (avx2 < 0) {
+		__builtin_cpu_init();
+		avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+	}
+	if (avx2) {
+		md5_multi_avx2(msgs, cnt, digests);
+		return;
+	}
+#endif
+	md5_multi_default(msgs, cnt, digests);
+#else
+	int l;
+
+	for (l = 0; l < cnt; l++) {
+		md_context ctx;
+		uchar seedbuf[4];
+		SIVALu(seedbuf, 0, msgs[l].seed);
+		md5_begin(&ctx);
+		if (msgs[l].seed_at == MD_SEED_BEFORE)
+			md5_update(&ctx, seedbuf, 4);
+		md5_update(&ctx, msgs[l].in, msgs[l].len);
+		if (msgs[l].seed_at == MD_SEED_AFTER)
+			md5_update(&ctx, seedbuf, 4);
+		md5_result(&ctx, digests + l * MD5_DIGEST_LEN);
+	}
+#endif
+}
+
 #ifdef TEST_MD5
 
 #include <stdlib.h>
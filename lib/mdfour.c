@@ -201,6 +201,182 @@ void mdfour(uchar digest[MD4_DIGEST_LEN], uchar *in, int length)
 	mdfour_result(&md, digest);
 }
 
+#ifdef __GNUC__
+
+/* The lanes version of mdfour64() and mdfour_tail(), like md5_lanes().
+ * A busted message (CSUM_MD4_BUSTED and older) gets no padding chunk
+ * when its length is a multiple of 64. */
+static inline __attribute__((always_inline))
+void mdfour_lanes(const md_message *msgs, int cnt, int busted, uchar *digests)
+{
+	uint32 W[16][MD_LANES] __attribute__((aligned(MD_LANES * 4)));
+	uint32 total[MD_LANES], chunks[MD_LANES], end[MD_LANES], max_chunks = 0, c;
+	uint32 out[4][MD_LANES] __attribute__((aligned(MD_LANES * 4)));
+	const md_vec *M = (const md_vec *)W, zero = { 0 };
+	md_vec SA, SB, SC, SD;
+	extern int protocol_version;
+	int l;
+
+	for (l = 0; l < MD_LANES; l++) {
+		if (l < cnt) {
+			total[l] = msgs[l].len + (msgs[l].seed_at != MD_SEED_NONE ? 4 : 0);
+			if (busted && total[l] % CSUM_CHUNK == 0)
+				chunks[l] = total[l] / CSUM_CHUNK;
+			else
+				chunks[l] = (total[l] + 8) / CSUM_CHUNK + 1;
+			end[l] = chunks[l] * CSUM_CHUNK - 8;
+			max_chunks = MAX(max_chunks, chunks[l]);
+		} else
+			chunks[l] = 0;
+	}
+
+	SA = zero + 0x67452301;
+	SB = zero + 0xefcdab89;
+	SC = zero + 0x98badcfe;
+	SD = zero + 0x10325476;
+
+	/* A busted empty message is never hashed at all. */
+	for (l = 0; l < cnt; l++) {
+		if (chunks[l] == 0) {
+			SIVALu(digests + l * MD4_DIGEST_LEN, 0, 0x67452301);
+			SIVALu(digests + l * MD4_DIGEST_LEN, 4, 0xefcdab89);
+			SIVALu(digests + l * MD4_DIGEST_LEN, 8, 0x98badcfe);
+			SIVALu(digests + l * MD4_DIGEST_LEN, 12, 0x10325476);
+		}
+	}
+
+	for (c = 0; c < max_chunks; c++) {
+		md_vec A = SA, B = SB, C = SC, D = SD;
+
+		for (l = 0; l < MD_LANES; l++) {
+			if (c < chunks[l]) {
+				/* Only the low 32 bits of the length before protocol 27. */
+				md_message_words(msgs + l, c, &W[0][l], MD_LANES, total[l], end[l], total[l] << 3,
+						 protocol_version >= 27 ? total[l] >> 29 : 0);
+			} else {
+				int k;
+				for (k = 0; k < 16; k++)
+					W[k][l] = 0;
+			}
+		}
+
+		ROUND1(A,B,C,D,  0,  3);  ROUND1(D,A,B,C,  1,  7);
+		ROUND1(C,D,A,B,  2, 11);  ROUND1(B,C,D,A,  3, 19);
+		ROUND1(A,B,C,D,  4,  3);  ROUND1(D,A,B,C,  5,  7);
+		ROUND1(C,D,A,B,  6, 11);  ROUND1(B,C,D,A,  7, 19);
+		ROUND1(A,B,C,D,  8,  3);  ROUND1(D,A,B,C,  9,  7);
+		ROUND1(C,D,A,B, 10, 11);  ROUND1(B,C,D,A, 11, 19);
+		ROUND1(A,B,C,D, 12,  3);  ROUND1(D,A,B,C, 13,  7);
+		ROUND1(C,D,A,B, 14, 11);  ROUND1(B,C,D,A, 15, 19);
+
+		ROUND2(A,B,C,D,  0,  3);  ROUND2(D,A,B,C,  4,  5);
+		ROUND2(C,D,A,B,  8,  9);  ROUND2(B,C,D,A, 12, 13);
+		ROUND2(A,B,C,D,  1,  3);  ROUND2(D,A,B,C,  5,  5);
+		ROUND2(C,D,A,B,  9,  9);  ROUND2(B,C,D,A, 13, 13);
+		ROUND2(A,B,C,D,  2,  3);  ROUND2(D,A,B,C,  6,  5);
+		ROUND2(C,D,A,B, 10,  9);  ROUND2(B,C,D,A, 14, 13);
+		ROUND2(A,B,C,D,  3,  3);  ROUND2(D,A,B,C,  7,  5);
+		ROUND2(C,D,A,B, 11,  9);  ROUND2(B,C,D,A, 15, 13);
+
+		ROUND3(A,B,C,D,  0,  3);  ROUND3(D,A,B,C,  8,  9);
+		ROUND3(C,D,A,B,  4, 11);  ROUND3(B,C,D,A, 12, 15);
+		ROUND3(A,B,C,D,  2,  3);  ROUND3(D,A,B,C, 10,  9);
+		ROUND3(C,D,A,B,  6, 11);  ROUND3(B,C,D,A, 14, 15);
+		ROUND3(A,B,C,D,  1,  3);  ROUND3(D,A,B,C,  9,  9);
+		ROUND3(C,D,A,B,  5, 11);  ROUND3(B,C,D,A, 13, 15);
+		ROUND3(A,B,C,D,  3,  3);  ROUND3(D,A,B,C, 11,  9);
+		ROUND3(C,D,A,B,  7, 11);  ROUND3(B,C,D,A, 15, 15);
+
+		SA += A;
+		SB += B;
+		SC += C;
+		SD += D;
+
+		for (l = 0; l < cnt; l++) {
+			if (chunks[l] == c + 1)
+				break;
+		}
+		if (l == cnt)
+			continue;
+		*(md_vec *)out[0] = SA;
+		*(md_vec *)out[1] = SB;
+		*(md_vec *)out[2] = SC;
+		*(md_vec *)out[3] = SD;
+		for ( ; l < cnt; l++) {
+			if (chunks[l] != c + 1)
+				continue;
+			SIVALu(digests + l * MD4_DIGEST_LEN, 0, out[0][l]);
+			SIVALu(digests + l * MD4_DIGEST_LEN, 4, out[1][l]);
+			SIVALu(digests + l * MD4_DIGEST_LEN, 8, out[2][l]);
+			SIVALu(digests + l * MD4_DIGEST_LEN, 12, out[3][l]);
+		}
+	}
+}
+
+static void mdfour_multi_default(const md_message *msgs, int cnt, int busted, uchar *digests)
+{
+	mdfour_lanes(msgs, cnt, busted, digests);
+}
+
+#ifdef SIMD_CHECKSUM
+__attribute__((target("avx2")))
+static void mdfour_multi_avx2(const md_message *msgs, int cnt, int busted, uchar *digests)
+{
+	mdfour_lanes(msgs, cnt, busted, digests);
+}
+#endif
+
+#endif
+
+/* Put the MD4 digests of msgs[0..cnt-1] (cnt <= MD_LANES) in digests,
+ * MD4_DIGEST_LEN bytes apart, with the same results as mdfour_begin(),
+ * mdfour_update() of each whole 64 bytes, and mdfour_update() of the rest
+ * unless busted is set and there is none. */
+void mdfour_multi(const md_message *msgs, int cnt, int busted, uchar *digests)
+{
+#ifdef __GNUC__
+#ifdef SIMD_CHECKSUM
+	static int avx2 = -1;
+
+	if (avx2 < 0) {
+		__builtin_cpu_init();
+		avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+	}
+	if (avx2) {
+		mdfour_multi_avx2(msgs, cnt, busted, digests);
+		return;
+	}
+#endif
+	mdfour_multi_default(msgs, cnt, busted, digests);
+#else
+	int l;
+
+	for (l = 0; l < cnt; l++) {
+		uchar buf[CSUM_CHUNK + 4];
+		uint32 len = msgs[l].len, i;
+		md_context md;
+
+		/* Only the last, partial chunk needs the seed next to it. */
+		mdfour_begin(&md);
+		for (i = 0; i + CSUM_CHUNK <= len; i += CSUM_CHUNK)
+			mdfour_update(&md, msgs[l].in + i, CSUM_CHUNK);
+		memcpy(buf, msgs[l].in + i, len - i);
+		if (msgs[l].seed_at == MD_SEED_AFTER) {
+			SIVALu(buf, len - i, msgs[l].seed);
+			len += 4;
+		}
+		if (len - i >= CSUM_CHUNK) {
+			mdfour_update(&md, buf, CSUM_CHUNK);
+			memmove(buf, buf + CSUM_CHUNK, len - i - CSUM_CHUNK);
+			i += CSUM_CHUNK;
+		}
+		if (len - i > 0 || !busted)
+			mdfour_update(&md, buf, len - i);
+		mdfour_result(&md, digests + l * MD4_DIGEST_LEN);
+	}
+#endif
+}
+
 #ifdef TEST_MDFOUR
 int protocol_version = 28;
 
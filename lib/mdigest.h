@@ -1,4 +1,4 @@
-/* The include file for both the MD4 and MD5 routines. */
+/* The include file for the MD4, MD5 and XXH3 routines. */
 
 #define MD4_DIGEST_LEN 16
 #define MD5_DIGEST_LEN 16
@@ -24,3 +24,92 @@ void md5_update(md_context *ctx, const uchar *input, uint32 length);
 void md5_result(md_context *ctx, uchar digest[MD5_DIGEST_LEN]);
 
 void get_md5(uchar digest[MD5_DIGEST_LEN], const uchar *input, int n);
+
+/* The multi-buffer routines hash up to MD_LANES independent messages in
+ * parallel lanes.  A message is a block of data with an optional 4-byte
+ * little-endian seed hashed before or after it. */
+#define MD_LANES 8
+
+#ifdef __GNUC__
+typedef uint32 md_vec __attribute__((vector_size(MD_LANES * 4)));
+#endif
+
+#define MD_SEED_NONE 0
+#define MD_SEED_BEFORE 1
+#define MD_SEED_AFTER 2
+
+typedef struct {
+	const uchar *in;
+	uint32 len;
+	uint32 seed;
+	int seed_at;		/* MD_SEED_* */
+} md_message;
+
+void md5_multi(const md_message *msgs, int cnt, uchar *digests);
+void mdfour_multi(const md_message *msgs, int cnt, int busted, uchar *digests);
+
+/* The byte at pos of the padded form of msg, total bytes long before the
+ * padding, whose length field starts at end. */
+static inline uchar md_message_byte(const md_message *msg, uint32 pos, uint32 total,
+				    uint32 end, uint32 bits_lo, uint32 bits_hi)
+{
+	uint32 data = msg->seed_at == MD_SEED_BEFORE ? 4 : 0;
+
+	if (pos < data)
+		return (uchar)(msg->seed >> (pos * 8));
+	if (pos < data + msg->len)
+		return msg->in[pos - data];
+	if (pos < total)
+		return (uchar)(msg->seed >> ((pos - data - msg->len) * 8));
+	if (pos == total)
+		return 0x80;
+	if (pos >= end + 4)
+		return (uchar)(bits_hi >> ((pos - end - 4) * 8));
+	if (pos >= end)
+		return (uchar)(bits_lo >> ((pos - end) * 8));
+	return 0;
+}
+
+/* Store the 16 words of chunk c of msg's padded form in w[0], w[stride],
+ * ..., reading them straight from the block wherever the whole chunk is
+ * data, so the seed and the padding are never copied next to it. */
+static inline void md_message_words(const md_message *msg, uint32 c, uint32 *w, int stride,
+				    uint32 total, uint32 end, uint32 bits_lo, uint32 bits_hi)
+{
+	uint32 start = c * CSUM_CHUNK, data = msg->seed_at == MD_SEED_BEFORE ? 4 : 0;
+	int k, b;
+
+	if (start >= data && start - data + CSUM_CHUNK <= msg->len) {
+		const uchar *p = msg->in + (start - data);
+		for (k = 0; k < 16; k++)
+			w[k * stride] = IVALu(p, k * 4);
+		return;
+	}
+	for (k = 0; k < 16; k++) {
+		uint32 word = 0;
+		for (b = 3; b >= 0; b--) {
+			word = (word << 8) | md_message_byte(msg, start + k * 4 + b, total,
+							     end, bits_lo, bits_hi);
+		}
+		w[k * stride] = word;
+	}
+}
+
+#define XXH3_DIGEST_LEN 8
+#define XXH3_SECRET_LEN 192
+
+typedef struct {
+	uint64_t acc[8];
+	uint64_t seed;
+	uint64_t total;		/* bytes hashed so far */
+	uint32 buffered;	/* bytes in buffer */
+	uchar secret[XXH3_SECRET_LEN];
+	uchar buffer[1024];	/* the input not yet accumulated */
+	uchar last[64];		/* the end of the last accumulated block */
+} xxh3_context;
+
+uint64_t xxh3_64(const uchar *in, size_t len, uint64_t seed);
+
+void xxh3_begin(xxh3_context *ctx, uint64_t seed);
+void xxh3_update(xxh3_context *ctx, const uchar *in, size_t len);
+uint64_t xxh3_result(xxh3_context *ctx);
@@ -0,0 +1,353 @@
+/*
+ * XXH3 64-bit hash, as specified by xxHash 0.8 (seeded, one-shot and
+ * streaming); see https://github.com/Cyan4973/xxHash for the reference.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, visit the http://fsf.org website.
+ */
+
+#include "rsync.h"
+
+#define PRIME32_1 0x9E3779B1U
+#define PRIME32_2 0x85EBCA77U
+#define PRIME32_3 0xC2B2AE3DU
+#define PRIME64_1 0x9E3779B185EBCA87ULL
+#define PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define PRIME64_3 0x165667B19E3779F9ULL
+#define PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define PRIME64_5 0x27D4EB2F165667C5ULL
+#define PRIME_MX1 0x165667919E3779F9ULL
+#define PRIME_MX2 0x9FB21C651E98DF25ULL
+
+#define STRIPE_LEN 64
+#define SECRET_CONSUME_RATE 8
+#define STRIPES_PER_BLOCK ((XXH3_SECRET_LEN - STRIPE_LEN) / SECRET_CONSUME_RATE)
+#define MIDSIZE_MAX 240
+
+static const uchar default_secret[XXH3_SECRET_LEN] = {
+	0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+	0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+	0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+	0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+	0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+	0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+	0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+	0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+	0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+	0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+	0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+	0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+static inline uint32 read32(const uchar *p)
+{
+	return (uint32)p[0] | (uint32)p[1] << 8 | (uint32)p[2] << 16 | (uint32)p[3] << 24;
+}
+
+static inline uint64_t read64(const uchar *p)
+{
+	return (uint64_t)read32(p) | (uint64_t)read32(p + 4) << 32;
+}
+
+static inline void write64(uchar *p, uint64_t v)
+{
+	int i;
+
+	for (i = 0; i < 8; i++)
+		p[i] = (uchar)(v >> (i * 8));
+}
+
+static inline uint64_t rotl64(uint64_t x, int r)
+{
+	return (x << r) | (x >> (64 - r));
+}
+
+static inline uint32 swap32(uint32 x)
+{
+	return (x << 24) | ((x << 8) & 0xff0000) | ((x >> 8) & 0xff00) | (x >> 24);
+}
+
+static inline uint64_t swap64(uint64_t x)
+{
+	return (uint64_t)swap32((uint32)x) << 32 | swap32((uint32)(x >> 32));
+}
+
+/* The 128-bit product of a and b, folded to 64 bits. */
+static inline uint64_t mul128_fold64(uint64_t a, uint64_t b)
+{
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 p = (unsigned __int128)a * b;
+
+	return (uint64_t)p ^ (uint64_t)(p >> 64);
+#else
+	uint64_t lo_lo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+	uint64_t hi_lo = (a >> 32) * (b & 0xFFFFFFFF);
+	uint64_t lo_hi = (a & 0xFFFFFFFF) * (b >> 32);
+	uint64_t hi_hi = (a >> 32) * (b >> 32);
+	uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+	uint64_t upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+	uint64_t lower = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+
+	return lower ^ upper;
+#endif
+}
+
+static inline uint64_t xxh64_avalanche(uint64_t h)
+{
+	h ^= h >> 33;
+	h *= PRIME64_2;
+	h ^= h >> 29;
+	h *= PRIME64_3;
+	return h ^ (h >> 32);
+}
+
+static inline uint64_t avalanche(uint64_t h)
+{
+	h ^= h >> 37;
+	h *= PRIME_MX1;
+	return h ^ (h >> 32);
+}
+
+static inline uint64_t rrmxmx(uint64_t h, uint64_t len)
+{
+	h ^= rotl64(h, 49) ^ rotl64(h, 24);
+	h *= PRIME_MX2;
+	h ^= (h >> 35) + len;
+	h *= PRIME_MX2;
+	return h ^ (h >> 28);
+}
+
+static inline uint64_t mix16(const uchar *in, const uchar *secret, uint64_t seed)
+{
+	return mul128_fold64(read64(in) ^ (read64(secret) + seed),
+			     read64(in + 8) ^ (read64(secret + 8) - seed));
+}
+
+/* Inputs of up to MIDSIZE_MAX bytes use the default secret and the seed. */
+static uint64_t hash_short(const uchar *in, size_t len, uint64_t seed)
+{
+	const uchar *secret = default_secret;
+	uint64_t acc;
+	size_t i;
+
+	if (len > 16) {
+		acc = len * PRIME64_1;
+		if (len > 128) {
+			uint64_t end = mix16(in + len - 16, secret + 136 - 17, seed);
+			for (i = 0; i < 8; i++)
+				acc += mix16(in + 16 * i, secret + 16 * i, seed);
+			acc = avalanche(acc);
+			for (i = 8; i < len / 16; i++)
+				end += mix16(in + 16 * i, secret + 16 * (i - 8) + 3, seed);
+			return avalanche(acc + end);
+		}
+		if (len > 32) {
+			if (len > 64) {
+				if (len > 96) {
+					acc += mix16(in + 48, secret + 96, seed);
+					acc += mix16(in + len - 64, secret + 112, seed);
+				}
+				acc += mix16(in + 32, secret + 64, seed);
+				acc += mix16(in + len - 48, secret + 80, seed);
+			}
+			acc += mix16(in + 16, secret + 32, seed);
+			acc += mix16(in + len - 32, secret + 48, seed);
+		}
+		acc += mix16(in, secret, seed);
+		acc += mix16(in + len - 16, secret + 16, seed);
+		return avalanche(acc);
+	}
+	if (len > 8) {
+		uint64_t lo = read64(in) ^ ((read64(secret + 24) ^ read64(secret + 32)) + seed);
+		uint64_t hi = read64(in + len - 8) ^ ((read64(secret + 40) ^ read64(secret + 48)) - seed);
+		return avalanche(len + swap64(lo) + hi + mul128_fold64(lo, hi));
+	}
+	if (len >= 4) {
+		uint64_t flip, keyed;
+		seed ^= (uint64_t)swap32((uint32)seed) << 32;
+		flip = (read64(secret + 8) ^ read64(secret + 16)) - seed;
+		keyed = ((uint64_t)read32(in) << 32 | read32(in + len - 4)) ^ flip;
+		return rrmxmx(keyed, len);
+	}
+	if (len > 0) {
+		uint32 combined = (uint32)in[0] << 16 | (uint32)in[len >> 1] << 24
+				| (uint32)in[len - 1] | (uint32)len << 8;
+		uint64_t flip = (uint64_t)(read32(secret) ^ read32(secret + 4)) + seed;
+		return xxh64_avalanche((uint64_t)combined ^ flip);
+	}
+	return xxh64_avalanche(seed ^ read64(secret + 56) ^ read64(secret + 64));
+}
+
+static inline void accumulate_stripe(uint64_t *acc, const uchar *in, const uchar *secret)
+{
+	int i;
+
+	for (i = 0; i < 8; i++) {
+		uint64_t val = read64(in + 8 * i);
+		uint64_t key = val ^ read64(secret + 8 * i);
+		acc[i ^ 1] += val;
+		acc[i] += (key & 0xFFFFFFFF) * (key >> 32);
+	}
+}
+
+static void accumulate(uint64_t *acc, const uchar *in, const uchar *secret, size_t stripes)
+{
+	size_t n;
+
+	for (n = 0; n < stripes; n++)
+		accumulate_stripe(acc, in + n * STRIPE_LEN, secret + n * SECRET_CONSUME_RATE);
+}
+
+static void scramble(uint64_t *acc, const uchar *secret)
+{
+	int i;
+
+	for (i = 0; i < 8; i++) {
+		uint64_t a = acc[i];
+		a ^= a >> 47;
+		a ^= read64(secret + 8 * i);
+		acc[i] = a * PRIME32_1;
+	}
+}
+
+static void init_acc(uint64_t *acc)
+{
+	acc[0] = PRIME32_3;
+	acc[1] = PRIME64_1;
+	acc[2] = PRIME64_2;
+	acc[3] = PRIME64_3;
+	acc[4] = PRIME64_4;
+	acc[5] = PRIME32_2;
+	acc[6] = PRIME64_5;
+	acc[7] = PRIME32_1;
+}
+
+static void init_secret(uchar *secret, uint64_t seed)
+{
+	int i;
+
+	for (i = 0; i < XXH3_SECRET_LEN; i += 16) {
+		write64(secret + i, read64(default_secret + i) + seed);
+		write64(secret + i + 8, read64(default_secret + i + 8) - seed);
+	}
+}
+
+/* The result from the accumulators of an input of len bytes, whose last
+ * STRIPE_LEN bytes are last_stripe. */
+static uint64_t finish_long(uint64_t *acc, const uchar *last_stripe, const uchar *secret, uint64_t len)
+{
+	uint64_t result = len * PRIME64_1;
+	int i;
+
+	accumulate_stripe(acc, last_stripe, secret + XXH3_SECRET_LEN - STRIPE_LEN - 7);
+	for (i = 0; i < 4; i++) {
+		result += mul128_fold64(acc[2 * i] ^ read64(secret + 11 + 16 * i),
+					acc[2 * i + 1] ^ read64(secret + 11 + 16 * i + 8));
+	}
+	return avalanche(result);
+}
+
+uint64_t xxh3_64(const uchar *in, size_t len, uint64_t seed)
+{
+	uchar custom[XXH3_SECRET_LEN];
+	const uchar *secret = default_secret;
+	size_t block_len = STRIPE_LEN * STRIPES_PER_BLOCK, blocks, n;
+	uint64_t acc[8];
+
+	if (len <= MIDSIZE_MAX)
+		return hash_short(in, len, seed);
+
+	if (seed) {
+		init_secret(custom, seed);
+		secret = custom;
+	}
+	init_acc(acc);
+	blocks = (len - 1) / block_len;
+	for (n = 0; n < blocks; n++) {
+		accumulate(acc, in + n * block_len, secret, STRIPES_PER_BLOCK);
+		scramble(acc, secret + XXH3_SECRET_LEN - STRIPE_LEN);
+	}
+	accumulate(acc, in + blocks * block_len, secret, ((len - 1) - blocks * block_len) / STRIPE_LEN);
+
+	return finish_long(acc, in + len - STRIPE_LEN, secret, len);
+}
+
+void xxh3_begin(xxh3_context *ctx, uint64_t seed)
+{
+	init_acc(ctx->acc);
+	ctx->seed = seed;
+	ctx->total = 0;
+	ctx->buffered = 0;
+	if (seed)
+		init_secret(ctx->secret, seed);
+	else
+		memcpy(ctx->secret, default_secret, XXH3_SECRET_LEN);
+}
+
+/* Run a whole block through the accumulators; the caller knows that more
+ * input follows it, so it is never the one finish_long() has to see. */
+static void xxh3_block(xxh3_context *ctx, const uchar *block)
+{
+	size_t block_len = STRIPE_LEN * STRIPES_PER_BLOCK;
+
+	accumulate(ctx->acc, block, ctx->secret, STRIPES_PER_BLOCK);
+	scramble(ctx->acc, ctx->secret + XXH3_SECRET_LEN - STRIPE_LEN);
+	memcpy(ctx->last, block + block_len - STRIPE_LEN, STRIPE_LEN);
+}
+
+void xxh3_update(xxh3_context *ctx, const uchar *in, size_t len)
+{
+	size_t block_len = STRIPE_LEN * STRIPES_PER_BLOCK;
+
+	ctx->total += len;
+	if (ctx->buffered + len <= block_len) {
+		memcpy(ctx->buffer + ctx->buffered, in, len);
+		ctx->buffered += len;
+		return;
+	}
+	if (ctx->buffered) {
+		size_t fill = block_len - ctx->buffered;
+		memcpy(ctx->buffer + ctx->buffered, in, fill);
+		xxh3_block(ctx, ctx->buffer);
+		in += fill;
+		len -= fill;
+	}
+	while (len > block_len) {
+		xxh3_block(ctx, in);
+		in += block_len;
+		len -= block_len;
+	}
+	memcpy(ctx->buffer, in, len);
+	ctx->buffered = len;
+}
+
+uint64_t xxh3_result(xxh3_context *ctx)
+{
+	uchar last[STRIPE_LEN];
+	uint64_t acc[8];
+	size_t n = ctx->buffered;
+
+	if (ctx->total <= MIDSIZE_MAX)
+		return hash_short(ctx->buffer, n, ctx->seed);
+
+	memcpy(acc, ctx->acc, sizeof acc);
+	accumulate(acc, ctx->buffer, ctx->secret, (n - 1) / STRIPE_LEN);
+	if (n >= STRIPE_LEN)
+		memcpy(last, ctx->buffer + n - STRIPE_LEN, STRIPE_LEN);
+	else {
+		memcpy(last, ctx->last + n, STRIPE_LEN - n);
+		memcpy(last + STRIPE_LEN - n, ctx->buffer, n);
+	}
+
+	return finish_long(acc, last, ctx->secret, ctx->total);
+}
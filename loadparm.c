@@ -111,7 +111,9 @@ typedef struct {
 typedef struct {
 	char *auth_users;
 	char *charset;
+	char *chunk_store;
 	char *comment;
+	char *compaction_queue;
 	char *dont_compress;
 	char *exclude;
 	char *exclude_from;
@@ -135,13 +137,22 @@ typedef struct {
 	char *syslog_tag;
 	char *temp_dir;
 	char *uid;
+	char *version_cache;
 /* NOTE: update this macro if the last char* variable changes! */
-#define LOCAL_STRING_COUNT() (offsetof(local_vars, uid) / sizeof (char*) + 1)
+#define LOCAL_STRING_COUNT() (offsetof(local_vars, version_cache) / sizeof (char*) + 1)
 
+	int backup_compaction;
+	int backup_compression;
+	int checkpoint_ratio;
+	int checksum_workers;
 	int max_connections;
 	int max_verbosity;
+	int pack_threshold;
+	int restore_prefetch_limit;
+	int restore_workers;
 	int syslog_facility;
 	int timeout;
+	int version_cache_size;
 
 	BOOL fake_super;
 	BOOL forward_lookup;
@@ -152,6 +163,8 @@ typedef struct {
 	BOOL numeric_ids;
 	BOOL read_only;
 	BOOL reverse_lookup;
+	BOOL signature_sidecars;
+	BOOL snapshot_catalog;
 	BOOL strict_modes;
 	BOOL transfer_logging;
 	BOOL use_chroot;
@@ -191,7 +204,9 @@ static const all_vars Defaults = {
  {
  /* auth_users; */		NULL,
  /* charset; */ 		NULL,
+ /* chunk_store; */		NULL,
  /* comment; */ 		NULL,
+ /* compaction_queue; */	NULL,
  /* dont_compress; */		DEFAULT_DONT_COMPRESS,
  /* exclude; */			NULL,
  /* exclude_from; */		NULL,
@@ -215,11 +230,20 @@ static const all_vars Defaults = {
  /* syslog_tag; */		"rsyncd",
  /* temp_dir; */ 		NULL,
  /* uid; */			NULL,
+ /* version_cache; */		NULL,
 
+ /* backup_compaction; */	BACKUP_COMPACTION_BACKGROUND,
+ /* backup_compression; */	0,
+ /* checkpoint_ratio; */	100,
+ /* checksum_workers; */	0,
  /* max_connections; */		0,
  /* max_verbosity; */		1,
+ /* pack_threshold; */		0,
+ /* restore_prefetch_limit; */	256,
+ /* restore_workers; */		0,
  /* syslog_facility; */		LOG_DAEMON,
  /* timeout; */			0,
+ /* version_cache_size; */	1024,
 
  /* fake_super; */		False,
  /* forward_lookup; */		True,
@@ -230,6 +254,8 @@ static const all_vars Defaults = {
  /* numeric_ids; */		(BOOL)-1,
  /* read_only; */		True,
  /* reverse_lookup; */		True,
+ /* signature_sidecars; */	False,
+ /* snapshot_catalog; */	False,
  /* strict_modes; */		True,
  /* transfer_logging; */	False,
  /* use_chroot; */		True,
@@ -251,6 +277,13 @@ static BOOL bInGlobalSection = True;
 
 #define NUMPARAMETERS (sizeof (parm_table) / sizeof (struct parm_struct))
 
+static struct enum_list enum_compaction[] = {
+	{ BACKUP_COMPACTION_INLINE, "inline" },
+	{ BACKUP_COMPACTION_BACKGROUND, "background" },
+	{ BACKUP_COMPACTION_DEFERRED, "deferred" },
+	{ -1, NULL }
+};
+
 static struct enum_list enum_facilities[] = {
 #ifdef LOG_AUTH
 	{ LOG_AUTH, "auth" },
@@ -331,8 +364,14 @@ static struct parm_struct parm_table[] =
  {"socket options",    P_STRING, P_GLOBAL,&Vars.g.socket_options,      NULL,0},
 
  {"auth users",        P_STRING, P_LOCAL, &Vars.l.auth_users,          NULL,0},
+ {"backup compaction", P_ENUM,   P_LOCAL, &Vars.l.backup_compaction,   enum_compaction,0},
+ {"backup compression",P_INTEGER,P_LOCAL, &Vars.l.backup_compression,  NULL,0},
  {"charset",           P_STRING, P_LOCAL, &Vars.l.charset,             NULL,0},
+ {"checkpoint ratio",  P_INTEGER,P_LOCAL, &Vars.l.checkpoint_ratio,    NULL,0},
+ {"checksum workers",  P_INTEGER,P_LOCAL, &Vars.l.checksum_workers,    NULL,0},
+ {"chunk store",       P_PATH,   P_LOCAL, &Vars.l.chunk_store,         NULL,0},
  {"comment",           P_STRING, P_LOCAL, &Vars.l.comment,             NULL,0},
+ {"compaction queue",  P_PATH,   P_LOCAL, &Vars.l.compaction_queue,    NULL,0},
  {"dont compress",     P_STRING, P_LOCAL, &Vars.l.dont_compress,       NULL,0},
  {"exclude from",      P_STRING, P_LOCAL, &Vars.l.exclude_from,        NULL,0},
  {"exclude",           P_STRING, P_LOCAL, &Vars.l.exclude,             NULL,0},
@@ -357,6 +396,7 @@ static struct parm_struct parm_table[] =
  {"name",              P_STRING, P_LOCAL, &Vars.l.name,                NULL,0},
  {"numeric ids",       P_BOOL,   P_LOCAL, &Vars.l.numeric_ids,         NULL,0},
  {"outgoing chmod",    P_STRING, P_LOCAL, &Vars.l.outgoing_chmod,      NULL,0},
+ {"pack threshold",    P_INTEGER,P_LOCAL, &Vars.l.pack_threshold,      NULL,0},
  {"path",              P_PATH,   P_LOCAL, &Vars.l.path,                NULL,0},
 #ifdef HAVE_PUTENV
  {"post-xfer exec",    P_STRING, P_LOCAL, &Vars.l.postxfer_exec,       NULL,0},
@@ -364,8 +404,12 @@ static struct parm_struct parm_table[] =
 #endif
  {"read only",         P_BOOL,   P_LOCAL, &Vars.l.read_only,           NULL,0},
  {"refuse options",    P_STRING, P_LOCAL, &Vars.l.refuse_options,      NULL,0},
+ {"restore prefetch limit",P_INTEGER,P_LOCAL,&Vars.l.restore_prefetch_limit,NULL,0},
+ {"restore workers",   P_INTEGER,P_LOCAL, &Vars.l.restore_workers,     NULL,0},
  {"reverse lookup",    P_BOOL,   P_LOCAL, &Vars.l.reverse_lookup,      NULL,0},
  {"secrets file",      P_STRING, P_LOCAL, &Vars.l.secrets_file,        NULL,0},
+ {"signature sidecars",P_BOOL,  P_LOCAL, &Vars.l.signature_sidecars,  NULL,0},
+ {"snapshot catalog",  P_BOOL,   P_LOCAL, &Vars.l.snapshot_catalog,    NULL,0},
  {"strict modes",      P_BOOL,   P_LOCAL, &Vars.l.strict_modes,        NULL,0},
  {"syslog facility",   P_ENUM,   P_LOCAL, &Vars.l.syslog_facility,     enum_facilities,0},
  {"syslog tag",        P_STRING, P_LOCAL, &Vars.l.syslog_tag,          NULL,0},
@@ -374,6 +418,8 @@ static struct parm_struct parm_table[] =
  {"transfer logging",  P_BOOL,   P_LOCAL, &Vars.l.transfer_logging,    NULL,0},
  {"uid",               P_STRING, P_LOCAL, &Vars.l.uid,                 NULL,0},
  {"use chroot",        P_BOOL,   P_LOCAL, &Vars.l.use_chroot,          NULL,0},
+ {"version cache",     P_PATH,   P_LOCAL, &Vars.l.version_cache,       NULL,0},
+ {"version cache size",P_INTEGER,P_LOCAL, &Vars.l.version_cache_size,  NULL,0},
  {"write only",        P_BOOL,   P_LOCAL, &Vars.l.write_only,          NULL,0},
  {NULL,                P_BOOL,   P_NONE,  NULL,                        NULL,0}
 };
@@ -468,7 +514,9 @@ FN_GLOBAL_INTEGER(lp_rsync_port, &Vars.g.rsync_port)
 
 FN_LOCAL_STRING(lp_auth_users, auth_users)
 FN_LOCAL_STRING(lp_charset, charset)
+FN_LOCAL_STRING(lp_chunk_store, chunk_store)
 FN_LOCAL_STRING(lp_comment, comment)
+FN_LOCAL_STRING(lp_compaction_queue, compaction_queue)
 FN_LOCAL_STRING(lp_dont_compress, dont_compress)
 FN_LOCAL_STRING(lp_exclude, exclude)
 FN_LOCAL_STRING(lp_exclude_from, exclude_from)
@@ -492,11 +540,20 @@ FN_LOCAL_STRING(lp_secrets_file, secrets_file)
 FN_LOCAL_STRING(lp_syslog_tag, syslog_tag)
 FN_LOCAL_STRING(lp_temp_dir, temp_dir)
 FN_LOCAL_STRING(lp_uid, uid)
+FN_LOCAL_STRING(lp_version_cache, version_cache)
 
+FN_LOCAL_INTEGER(lp_backup_compaction, backup_compaction)
+FN_LOCAL_INTEGER(lp_backup_compression, backup_compression)
+FN_LOCAL_INTEGER(lp_checkpoint_ratio, checkpoint_ratio)
+FN_LOCAL_INTEGER(lp_checksum_workers, checksum_workers)
 FN_LOCAL_INTEGER(lp_max_connections, max_connections)
 FN_LOCAL_INTEGER(lp_max_verbosity, max_verbosity)
+FN_LOCAL_INTEGER(lp_pack_threshold, pack_threshold)
+FN_LOCAL_INTEGER(lp_restore_prefetch_limit, restore_prefetch_limit)
+FN_LOCAL_INTEGER(lp_restore_workers, restore_workers)
 FN_LOCAL_INTEGER(lp_syslog_facility, syslog_facility)
 FN_LOCAL_INTEGER(lp_timeout, timeout)
+FN_LOCAL_INTEGER(lp_version_cache_size, version_cache_size)
 
 FN_LOCAL_BOOL(lp_fake_super, fake_super)
 FN_LOCAL_BOOL(lp_forward_lookup, forward_lookup)
@@ -507,6 +564,8 @@ FN_LOCAL_BOOL(lp_munge_symlinks, munge_symlinks)
 FN_LOCAL_BOOL(lp_numeric_ids, numeric_ids)
 FN_LOCAL_BOOL(lp_read_only, read_only)
 FN_LOCAL_BOOL(lp_reverse_lookup, reverse_lookup)
+FN_LOCAL_BOOL(lp_signature_sidecars, signature_sidecars)
+FN_LOCAL_BOOL(lp_snapshot_catalog, snapshot_catalog)
 FN_LOCAL_BOOL(lp_strict_modes, strict_modes)
 FN_LOCAL_BOOL(lp_transfer_logging, transfer_logging)
 FN_LOCAL_BOOL(lp_use_chroot, use_chroot)
@@ -78,6 +78,7 @@ extern BOOL flist_receiving_enabled;
 extern BOOL shutting_down;
 extern int backup_dir_len;
 extern int basis_dir_cnt;
+extern int checkpoint_stats;
 extern struct stats stats;
 extern char *stdout_format;
 extern char *logfile_format;
@@ -97,9 +98,11 @@ extern filter_rule_list daemon_filter_list;
 
 int source_is_remote_or_local = -1; // 解析命令行参数时，如果是本地文件，source_is_remote_or_local = 0，如果是远程文件，source_is_remote_or_local = 1
 extern char *recovery_version;
+extern char *recovery_range;
 extern char *backup_version;
 extern int backup_type;				
 extern int backup_version_num;
+extern char *compact_backups_queue;
 
 uid_t our_uid;
 gid_t our_gid;
@@ -217,6 +220,17 @@ void read_del_stats(int f)
 	stats.deleted_files += stats.deleted_specials = read_varint(f);
 }
 
+void write_checkpoint_stats(int f)
+{
+	write_ndx(f, NDX_CHECKPOINT_STATS);
+	write_varint(f, stats.checkpoint_files);
+}
+
+void read_checkpoint_stats(int f)
+{
+	stats.checkpoint_files = read_varint(f);
+}
+
 /* This function gets called from all 3 processes.  We want the client side
  * to actually output the text, but the sender is the only process that has
  * all the stats we need.  So, if we're a client sender, we do the report.
@@ -327,6 +341,10 @@ static void output_summary(void)
 			output_itemized_counts("Number of deleted files", &stats.deleted_files);
 		rprintf(FINFO,"Number of regular files transferred: %s\n",
 			comma_num(stats.xferred_files));
+		if (stats.checkpoint_files) {
+			rprintf(FINFO,"Number of full checkpoints written: %s\n",
+				comma_num(stats.checkpoint_files));
+		}
 		rprintf(FINFO,"Total file size: %s bytes\n",
 			human_num(stats.total_size));
 		rprintf(FINFO,"Total transferred file size: %s bytes\n",
@@ -861,6 +879,10 @@ static void do_server_sender(int f_in, int f_out, int argc, char *argv[])
 		argv[0] = ".";
 	}
 
+	// 恢复时按目录清单列出该版本时存在的文件(含之后被删除的), 排除之后才创建的文件
+	if (source_is_remote_or_local == 1)
+		catalog_restore_open(recovery_version);
+
 	flist = send_file_list(f_out,argc,argv);
 	if (!flist || flist->used == 0) {
 		/* Make sure input buffering is off so we can't hang in noop_io_until_death(). */
@@ -1015,6 +1037,9 @@ static int do_recv(int f_in, int f_out, char *local_name)
         io_flush(FULL_FLUSH);
         shutting_down = True;
         if (protocol_version >= 24) {
+            // 备份写入的全量检查点数目(见recv_files()), 客户端在--stats中列出
+            if (am_server && checkpoint_stats)
+                write_checkpoint_stats(f_out);
             /* send a final goodbye message */
             write_ndx(f_out, NDX_DONE);
         }
@@ -1497,6 +1522,9 @@ static int start_client(int argc, char *argv[])
 		*/
 		if (path) { /* source is remote */
 			source_is_remote_or_local = 1;  // source is remote 参数1时远程资源 代表是一个还原任务
+			// 恢复整个版本时按校验和比对(--checksum), 已是该版本的文件由服务端的版本摘要直接判定, 不再传输
+			if (recovery_version && !recovery_range)
+				always_checksum = 1;
 			char *dummy_host;
 			int dummy_port = 0;
 			*argv = path;
@@ -1872,6 +1900,8 @@ int main(int argc,char *argv[])
 #endif
 	} else if (am_daemon)
 		return daemon_main();
+	else if (compact_backups_queue)
+		exit_cleanup(retention_run_queue(compact_backups_queue));
 
 	if (am_server && protect_args) {
 		char buf[MAXPATHLEN];
@@ -0,0 +1,691 @@
+/*
+ * The version manifest kept in each <file>.backup/ directory.
+ *
+ * Every full or delta file that the receiver stores is recorded in
+ * <file>.backup/MANIFEST when it is written, and every one that the
+ * retention code removes is recorded when it goes away.  The generator,
+ * receiver and sender then pick versions with one sequential read of a
+ * small file instead of scanning and sorting the full/ and delta/
+ * directories for every file they touch.
+ *
+ * The manifest is a header line followed by one record per line:
+ *
+ *	+ MODE KIND VERSION SIZE DIGEST [LITERAL OPS]
+ *	- MODE KIND VERSION
+ *
+ * MODE is "i" (incremental), "d" (differential) or "r" (reverse), KIND is "f" (full) or
+ * "d" (delta), SIZE is the length of the file at that version and DIGEST
+ * is "CSUM_TYPE:hex" (the whole-file checksum of that version) or "-".
+ * A delta's record also carries its literal byte and op counts, which
+ * the receiver adds up to decide when to write a new full file.
+ * Records are only ever appended; the file is rewritten from memory once
+ * removals make up most of it.  A backup directory written before
+ * manifests existed gets one built from a directory scan the first time
+ * it is opened.
+ *
+ * Appends and rewrites take an fcntl() write lock on MANIFEST, and a
+ * rewrite first reads the file again under it, so a receiver recording
+ * a new version and a retention job pruning old ones don't lose each
+ * other's records.  Readers don't lock: a rewrite renames a complete
+ * file into place.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, visit the http://fsf.org website.
+ */
+
+#include "rsync.h"
+#include "itypes.h"
+
+#define MANIFEST_NAME "MANIFEST"
+#define MANIFEST_HEADER "# rsync backup manifest 1\n"
+
+static const char *mode_dirs[] = { "incremental", "differential", "reverse" };
+static const char *kind_names[] = { "full", "delta" };
+static const char mode_chars[] = "idr";
+static const char kind_chars[] = "fd";
+
+/* The version "yyyy-mm-dd-HH:MM:SS" as seconds since the epoch (its
+ * fields read as UTC), which orders versions the way their names do.
+ * Trailing fields may be left off ("yyyy-mm-dd" is midnight).  Returns
+ * -1 for anything else, for versions before 1970, and for a date or time
+ * that does not exist (e.g. 02-30 or :60), so that no two versions get
+ * the same id. */
+int64 version_id(const char *version)
+{
+	static const int mdays[] = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365 };
+	static const char seps[] = "---::";
+	int f[6] = { 0, 1, 1, 0, 0, 0 }, n, i, leap;
+	const char *p = version;
+	int64 days;
+
+	for (n = 0; n < 6 && *p; n++) {
+		if (n && *p++ != seps[n - 1])
+			return -1;
+		for (f[n] = 0, i = n ? 2 : 4; i; i--, p++) {
+			if (!isDigit(p))
+				return -1;
+			f[n] = f[n] * 10 + *p - '0';
+		}
+	}
+	if (!n || *p)
+		return -1;
+	leap = f[0] % 4 == 0 && (f[0] % 100 != 0 || f[0] % 400 == 0);
+	if (f[0] < 1970 || f[1] < 1 || f[1] > 12 || f[2] < 1
+	 || f[2] > mdays[f[1]] - mdays[f[1] - 1] + (f[1] == 2 && leap)
+	 || f[3] > 23 || f[4] > 59 || f[5] > 59)
+		return -1;
+
+	days = (int64)(f[0] - 1970) * 365 + mdays[f[1] - 1] + f[2] - 1;
+	for (i = 1972; i < f[0] + (f[1] > 2); i += 4) {	/* leap days so far */
+		if (i % 100 != 0 || i % 400 == 0)
+			days++;
+	}
+
+	return ((days * 24 + f[3]) * 60 + f[4]) * 60 + f[5];
+}
+
+/* Entries are ordered by mode, kind and version id, with the name only
+ * telling apart versions that have no id.  A NULL version compares equal
+ * to every name, so find_slot() then finds the first entry of that id. */
+static int version_cmp(const struct backup_version *v, int mode, int kind, int64 id, const char *version)
+{
+	if (v->mode != mode)
+		return v->mode - mode;
+	if (v->kind != kind)
+		return v->kind - kind;
+	if (v->id != id)
+		return v->id < id ? -1 : 1;
+	return version ? strcmp(v->version, version) : 0;
+}
+
+/* Index of the first entry that sorts at or after (mode, kind, id, version). */
+static int find_slot(const struct backup_manifest *m, int mode, int kind, int64 id, const char *version)
+{
+	int lo = 0, hi = m->count;
+
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (version_cmp(&m->vers[mid], mode, kind, id, version) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+/* Index of the mode/kind entry of version, or -1. */
+static int find_version(const struct backup_manifest *m, int mode, int kind, const char *version)
+{
+	int64 id = version_id(version);
+	int i = find_slot(m, mode, kind, id, version);
+
+	if (i == m->count || version_cmp(&m->vers[i], mode, kind, id, version) != 0)
+		return -1;
+
+	return i;
+}
+
+/* Add an entry for version (or find the one there is).  Returns NULL if
+ * its file's path would be too long. */
+static struct backup_version *insert_version(struct backup_manifest *m, int mode, int kind,
+					     const char *version)
+{
+	struct backup_version *v;
+	char path[MAXPATHLEN];
+	int64 id = version_id(version);
+	int i = find_slot(m, mode, kind, id, version);
+
+	if (i < m->count && version_cmp(&m->vers[i], mode, kind, id, version) == 0)
+		return &m->vers[i];
+	if (manifest_path(m, mode, kind, version, path) < 0)
+		return NULL;
+
+	if (m->count == m->malloced) {
+		m->malloced = m->malloced ? m->malloced * 2 : 16;
+		if (!(m->vers = realloc_array(m->vers, struct backup_version, m->malloced)))
+			out_of_memory("insert_version");
+	}
+	memmove(m->vers + i + 1, m->vers + i, (m->count - i) * sizeof m->vers[0]);
+	m->count++;
+
+	v = m->vers + i;
+	memset(v, 0, sizeof v[0]);
+	strlcpy(v->version, version, sizeof v->version);
+	v->id = id;
+	v->mode = mode;
+	v->kind = kind;
+	v->csum_type = -1;
+
+	if (!(v->path = strdup(path)))
+		out_of_memory("insert_version");
+
+	return v;
+}
+
+static void drop_version(struct backup_manifest *m, struct backup_version *v)
+{
+	int i = v - m->vers;
+
+	free(v->path);
+	m->count--;
+	memmove(m->vers + i, m->vers + i + 1, (m->count - i) * sizeof m->vers[0]);
+}
+
+static void write_record(FILE *fp, const struct backup_version *v)
+{
+	int i;
+
+	fprintf(fp, "+ %c %c %s %s ", mode_chars[v->mode], kind_chars[v->kind],
+		v->version, do_big_num(v->size, 0, NULL));
+	if (v->csum_type < 0)
+		fputs("-", fp);
+	else {
+		int len = csum_len_for_type(v->csum_type, 0);
+		fprintf(fp, "%d:", v->csum_type);
+		for (i = 0; i < len; i++)
+			fprintf(fp, "%02x", (uchar)v->digest[i]);
+	}
+	if (v->kind == BACKUP_KIND_DELTA)
+		fprintf(fp, " %s %s", do_big_num(v->literal, 0, NULL), do_big_num(v->ops, 0, NULL));
+	putc('\n', fp);
+}
+
+/* Write-lock fd, waiting for whoever holds it. */
+static int lock_manifest_fd(int fd)
+{
+	struct flock lock;
+
+	lock.l_type = F_WRLCK;
+	lock.l_whence = SEEK_SET;
+	lock.l_start = 0;
+	lock.l_len = 0;
+	lock.l_pid = 0;
+
+	while (fcntl(fd, F_SETLKW, &lock) < 0) {
+		if (errno != EINTR)
+			return -1;
+	}
+	return 0;
+}
+
+/* Open and lock the manifest at path (creating it if need be), making
+ * sure the lock is on the file that is at the path and not one a
+ * rewrite replaced.  The lock goes away with the last descriptor this
+ * process has of the file, so all I/O under it goes through the one
+ * stream returned. */
+static FILE *lock_manifest(const char *path)
+{
+	STRUCT_STAT st, st2;
+	FILE *fp;
+	int fd;
+
+	while (1) {
+		if ((fd = do_open(path, O_RDWR|O_CREAT, 0644)) < 0)
+			return NULL;
+		if (lock_manifest_fd(fd) < 0) {
+			close(fd);
+			return NULL;
+		}
+		if (do_fstat(fd, &st) == 0 && do_stat(path, &st2) == 0
+		 && st.st_dev == st2.st_dev && st.st_ino == st2.st_ino) {
+			if (!(fp = fdopen(fd, "r+")))
+				close(fd);
+			return fp;
+		}
+		close(fd);
+	}
+}
+
+/* Write the whole manifest from memory and switch it into place.  That
+ * is only done under the lock, after rereading the file, so records that
+ * another process appended meanwhile are kept and MANIFEST.tmp is ours. */
+static int rewrite_manifest(struct backup_manifest *m)
+{
+	char path[MAXPATHLEN], tmp[MAXPATHLEN];
+	int held = m->lock_fp != NULL, ret = -1;
+	FILE *fp;
+	int i;
+
+	if (!held && manifest_lock(m) < 0)
+		return -1;
+
+	pathjoin(path, sizeof path, m->backup_dir, MANIFEST_NAME);
+	pathjoin(tmp, sizeof tmp, m->backup_dir, MANIFEST_NAME ".tmp");
+
+	if (!(fp = fopen(tmp, "w+"))) {
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(tmp));
+		goto done;
+	}
+	fputs(MANIFEST_HEADER, fp);
+	for (i = 0; i < m->count; i++)
+		write_record(fp, &m->vers[i]);
+	/* The new file is locked before it takes the name, so that whoever
+	 * is waiting for the old one finds it replaced and waits again. */
+	if (fflush(fp) != 0 || lock_manifest_fd(fileno(fp)) < 0 || do_rename(tmp, path) < 0) {
+		rsyserr(FERROR_XFER, errno, "write %s", full_fname(path));
+		fclose(fp);
+		do_unlink(tmp);
+		goto done;
+	}
+	fclose(m->lock_fp);
+	m->lock_fp = fp;
+	m->dead = 0;
+	ret = 0;
+
+  done:
+	if (!held)
+		manifest_unlock(m);
+
+	return ret;
+}
+
+/* Get the manifest ready for a record to be appended: the held stream,
+ * or else one locked for just this record. */
+static FILE *open_for_append(struct backup_manifest *m)
+{
+	char path[MAXPATHLEN];
+	FILE *fp = m->lock_fp;
+
+	pathjoin(path, sizeof path, m->backup_dir, MANIFEST_NAME);
+	if (!fp && !(fp = lock_manifest(path))) {
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(path));
+		return NULL;
+	}
+	if (fseek(fp, 0, SEEK_END) < 0) {
+		rsyserr(FERROR_XFER, errno, "seek %s", full_fname(path));
+		if (fp != m->lock_fp)
+			fclose(fp);
+		return NULL;
+	}
+	if (ftell(fp) == 0)
+		fputs(MANIFEST_HEADER, fp);
+
+	return fp;
+}
+
+static int close_for_append(struct backup_manifest *m, FILE *fp)
+{
+	int ret = fflush(fp);
+
+	if (fp != m->lock_fp && fclose(fp) != 0)
+		ret = EOF;
+	if (ret != 0)
+		rsyserr(FERROR_XFER, errno, "write %s/%s", m->backup_dir, MANIFEST_NAME);
+
+	return ret != 0 ? -1 : 0;
+}
+
+static int parse_number(const char *str, int64 *num)
+{
+	for (*num = 0; isDigit(str); str++)
+		*num = *num * 10 + (*str - '0');
+	return *str ? -1 : 0;
+}
+
+static int parse_record(struct backup_manifest *m, char *line)
+{
+	struct backup_version *v;
+	char version[BACKUP_VERSION_LEN], size_str[32], digest_str[2*MAX_DIGEST_LEN+16];
+	char literal_str[32], ops_str[32];
+	char op, mc, kc, *cp;
+	int mode, kind, i, len, cnt;
+	int64 size, literal = 0, ops = 0;
+
+	cnt = sscanf(line, "%c %c %c %31s %31s %47s %31s %31s", &op, &mc, &kc, version,
+		     size_str, digest_str, literal_str, ops_str);
+	if (cnt < 4 || !(cp = strchr(mode_chars, mc)) || !*cp)
+		return -1;
+	mode = cp - mode_chars;
+	if (!(cp = strchr(kind_chars, kc)) || !*cp)
+		return -1;
+	kind = cp - kind_chars;
+
+	if (op == '-') {
+		if ((i = find_version(m, mode, kind, version)) >= 0)
+			drop_version(m, &m->vers[i]);
+		m->dead++;
+		return 0;
+	}
+	if (op != '+' || (cnt != 6 && cnt != 8))
+		return -1;
+
+	if (parse_number(size_str, &size) < 0)
+		return -1;
+	if (cnt == 8 && (parse_number(literal_str, &literal) < 0 || parse_number(ops_str, &ops) < 0))
+		return -1;
+
+	if (!(v = insert_version(m, mode, kind, version)))
+		return -1;
+	v->size = size;
+	v->literal = literal;
+	v->ops = ops;
+	v->csum_type = -1;
+	if (*digest_str != '-') {
+		int csum_type = strtol(digest_str, &cp, 10);
+		if (*cp++ != ':')
+			return -1;
+		len = strlen(cp) / 2;
+		if (len > MAX_DIGEST_LEN)
+			return -1;
+		for (i = 0; i < len; i++) {
+			unsigned int byte;
+			if (sscanf(cp + i*2, "%2x", &byte) != 1)
+				return -1;
+			v->digest[i] = (char)byte;
+		}
+		v->csum_type = csum_type;
+	}
+
+	return 0;
+}
+
+/* Build the manifest of a backup directory that predates manifests from
+ * the names (and, for deltas, the headers) of the files it holds. */
+static void scan_backup_dir(struct backup_manifest *m)
+{
+	char dir[MAXPATHLEN], prefix[MAXPATHLEN];
+	int mode, kind, prefix_len;
+
+	for (mode = 0; mode < BACKUP_MODE_COUNT; mode++) {
+		for (kind = 0; kind < 2; kind++) {
+			struct dirent *di;
+			DIR *d;
+
+			if (snprintf(dir, sizeof dir, "%s/%s/%s", m->backup_dir, mode_dirs[mode],
+				     kind_names[kind]) >= (int)sizeof dir
+			 || (prefix_len = snprintf(prefix, sizeof prefix, "%s.%s.", m->name,
+						   kind_names[kind])) >= (int)sizeof prefix
+			 || !(d = opendir(dir)))
+				continue;
+			while ((di = readdir(d)) != NULL) {
+				struct backup_version *v;
+				STRUCT_STAT st;
+
+				if (strncmp(di->d_name, prefix, prefix_len) != 0
+				 || strlen(di->d_name + prefix_len) >= BACKUP_VERSION_LEN)
+					continue;
+				if (!(v = insert_version(m, mode, kind, di->d_name + prefix_len)))
+					continue;
+				if (kind == BACKUP_KIND_DELTA) {
+					struct delta_file *df = delta_open(v->path);
+					if (df) {
+						struct delta_op op;
+						v->size = df->hdr.file_size;
+						while (delta_read_op(df, &op) > 0) {}
+						v->literal = df->literal_bytes;
+						v->ops = df->op_count;
+						delta_close(df);
+					}
+				} else if (do_stat(v->path, &st) == 0)
+					v->size = st.st_size;
+			}
+			closedir(d);
+		}
+	}
+}
+
+static void free_versions(struct backup_manifest *m)
+{
+	int i;
+
+	for (i = 0; i < m->count; i++)
+		free(m->vers[i].path);
+	if (m->vers)
+		free(m->vers);
+	m->vers = NULL;
+	m->count = m->malloced = m->dead = 0;
+}
+
+/* Read the records of fp into the empty m.  Returns how many lines
+ * there were (0 for a file that was only just created), or -1 if the
+ * file is damaged, in which case m is left empty. */
+static int read_records(struct backup_manifest *m, FILE *fp, const char *path)
+{
+	char line[MAXPATHLEN];
+	int lineno = 0;
+
+	while (fgets(line, sizeof line, fp)) {
+		if (lineno++ == 0) {
+			if (strcmp(line, MANIFEST_HEADER) != 0)
+				break;
+			continue;
+		}
+		if (parse_record(m, line) < 0)
+			break;
+	}
+	if (!feof(fp)) {
+		rprintf(FWARNING, "[yee-%s] manifest.c: %s is damaged at line %d, rescanning %s\n",
+			who_am_i(), path, lineno, m->backup_dir);
+		free_versions(m);
+		return -1;
+	}
+
+	return lineno;
+}
+
+/* Load the manifest of fname's backup directory into m.  A file that has
+ * never been backed up simply gets an empty manifest.  Returns -1 only
+ * if an existing manifest could not be read. */
+int manifest_open(struct backup_manifest *m, const char *fname)
+{
+	char path[MAXPATHLEN];
+	const char *slash = strrchr(fname, '/');
+	STRUCT_STAT st;
+	FILE *fp;
+
+	m->vers = NULL;
+	m->count = m->malloced = m->dead = 0;
+	m->lock_fp = NULL;
+	if (slash) {
+		strlcpy(m->name, slash + 1, sizeof m->name);
+		snprintf(m->backup_dir, sizeof m->backup_dir, "%.*s/%s.backup",
+			 (int)(slash - fname), fname, m->name);
+	} else {
+		strlcpy(m->name, fname, sizeof m->name);
+		snprintf(m->backup_dir, sizeof m->backup_dir, "./%s.backup", m->name);
+	}
+
+	pathjoin(path, sizeof path, m->backup_dir, MANIFEST_NAME);
+	if (!(fp = fopen(path, "r"))) {
+		if (errno != ENOENT) {
+			rsyserr(FERROR_XFER, errno, "open %s", full_fname(path));
+			return -1;
+		}
+	} else {
+		int lines = read_records(m, fp, path);
+		fclose(fp);
+		if (lines > 0)
+			return 0;
+	}
+
+	if (do_stat(m->backup_dir, &st) < 0 || !S_ISDIR(st.st_mode))
+		return 0;
+	/* Build the file under the lock, where nobody else is doing the
+	 * same; a read-only module still gets the scan, just not the file. */
+	if (access(m->backup_dir, W_OK) != 0 || manifest_lock(m) < 0)
+		scan_backup_dir(m);
+	else
+		manifest_unlock(m);
+
+	return 0;
+}
+
+/* Lock m's manifest against other processes until manifest_unlock(),
+ * reading it again so that m has what they recorded before. */
+int manifest_lock(struct backup_manifest *m)
+{
+	char path[MAXPATHLEN];
+
+	if (m->lock_fp)
+		return 0;
+
+	pathjoin(path, sizeof path, m->backup_dir, MANIFEST_NAME);
+	if (!(m->lock_fp = lock_manifest(path))) {
+		rsyserr(FERROR_XFER, errno, "lock %s", full_fname(path));
+		return -1;
+	}
+
+	free_versions(m);
+	if (read_records(m, m->lock_fp, path) > 0)
+		return 0;
+	scan_backup_dir(m);
+
+	return rewrite_manifest(m);
+}
+
+void manifest_unlock(struct backup_manifest *m)
+{
+	if (m->lock_fp) {
+		fclose(m->lock_fp);
+		m->lock_fp = NULL;
+	}
+}
+
+void manifest_close(struct backup_manifest *m)
+{
+	free_versions(m);
+	manifest_unlock(m);
+}
+
+/* Record a newly stored version.  A digest of csum_type -1 means none.
+ * literal and ops are the delta's totals (0 for a full file). */
+struct backup_version *manifest_add(struct backup_manifest *m, int mode, int kind,
+				    const char *version, OFF_T size,
+				    int csum_type, const char *digest,
+				    OFF_T literal, int64 ops)
+{
+	struct backup_version *v = insert_version(m, mode, kind, version);
+	FILE *fp;
+
+	if (!v) {
+		rprintf(FERROR_XFER, "[yee-%s] manifest.c: the path of version %s in %s is too long\n",
+			who_am_i(), version, m->backup_dir);
+		return NULL;
+	}
+	v->size = size;
+	v->literal = literal;
+	v->ops = ops;
+	v->csum_type = csum_type;
+	if (csum_type >= 0)
+		memcpy(v->digest, digest, csum_len_for_type(csum_type, 0));
+
+	if (!(fp = open_for_append(m)))
+		return v;
+	write_record(fp, v);
+	close_for_append(m, fp);
+
+	return v;
+}
+
+/* Delete the file holding the given version and record that it is gone.
+ * Pointers into m->vers are not valid after this returns. */
+int manifest_remove(struct backup_manifest *m, int mode, int kind, const char *version)
+{
+	struct backup_version *v;
+	FILE *fp;
+	int i = find_version(m, mode, kind, version);
+	int ret = 0;
+
+	if (i < 0)
+		return -1;
+	v = &m->vers[i];
+
+	if (chunk_list_unlink(v->path) < 0 && errno != ENOENT) {
+		rsyserr(FERROR_XFER, errno, "unlink %s", full_fname(v->path));
+		ret = -1;
+	}
+	if (kind == BACKUP_KIND_FULL)
+		sig_sidecar_unlink(v->path);
+
+	if ((fp = open_for_append(m)) != NULL) {
+		fprintf(fp, "- %c %c %s\n", mode_chars[mode], kind_chars[kind], version);
+		if (close_for_append(m, fp) < 0)
+			ret = -1;
+	} else
+		ret = -1;
+
+	drop_version(m, v);
+	if (++m->dead > m->count + 16)
+		rewrite_manifest(m);
+
+	return ret;
+}
+
+/* Set *first to the oldest mode/kind version and return how many there
+ * are; they are contiguous in m->vers, oldest first. */
+int manifest_range(const struct backup_manifest *m, int mode, int kind, struct backup_version **first)
+{
+	int i = find_slot(m, mode, kind, -1, NULL);
+	int j = find_slot(m, mode, kind + 1, -1, NULL);
+
+	*first = m->vers + i;
+
+	return j - i;
+}
+
+/* The newest mode/kind version, or NULL if there isn't one. */
+struct backup_version *manifest_newest(const struct backup_manifest *m, int mode, int kind)
+{
+	struct backup_version *v;
+	int cnt = manifest_range(m, mode, kind, &v);
+
+	return cnt ? v + cnt - 1 : NULL;
+}
+
+/* The mode/kind entry of version, or NULL if there isn't one. */
+struct backup_version *manifest_find(const struct backup_manifest *m, int mode, int kind, const char *version)
+{
+	int i = find_version(m, mode, kind, version);
+
+	return i < 0 ? NULL : m->vers + i;
+}
+
+/* Set *first to the oldest mode/kind version whose id (see version_id())
+ * is in [from, to] and return how many there are, found by binary search;
+ * they are contiguous in m->vers, oldest first. */
+int manifest_span(const struct backup_manifest *m, int mode, int kind, int64 from, int64 to,
+		  struct backup_version **first)
+{
+	int i = find_slot(m, mode, kind, MAX(from, 0), NULL);
+	int j = to < 0 ? i : find_slot(m, mode, kind, to + 1, NULL);
+
+	*first = m->vers + i;
+
+	return j > i ? j - i : 0;
+}
+
+/* The newest mode/kind version whose id is at most until, or NULL. */
+struct backup_version *manifest_until(const struct backup_manifest *m, int mode, int kind, int64 until)
+{
+	struct backup_version *v;
+	int cnt = manifest_span(m, mode, kind, 0, until, &v);
+
+	return cnt ? v + cnt - 1 : NULL;
+}
+
+/* The name of mode's directory under <file>.backup/. */
+const char *backup_mode_name(int mode)
+{
+	return mode >= 0 && mode < BACKUP_MODE_COUNT ? mode_dirs[mode] : "unknown";
+}
+
+/* Where the mode/kind file for version lives (whether or not it exists).
+ * Returns -1 if that doesn't fit in MAXPATHLEN. */
+int manifest_path(const struct backup_manifest *m, int mode, int kind, const char *version, char *buf)
+{
+	int len = snprintf(buf, MAXPATHLEN, "%s/%s/%s/%s.%s.%s", m->backup_dir, mode_dirs[mode],
+			   kind_names[kind], m->name, kind_names[kind], version);
+
+	return len >= MAXPATHLEN ? -1 : 0;
+}
@@ -25,6 +25,8 @@ extern int whole_file;
 extern int checksum_seed;
 extern int append_mode;
 extern int xfersum_type;
+extern int delta_workers;
+extern int msgs2stderr;
 
 int updating_basis_file;
 char sender_file_sum[MAX_DIGEST_LEN];
@@ -42,6 +44,9 @@ extern struct stats stats;
 
 #define TRADITIONAL_TABLESIZE (1<<16)
 
+#define MAX_DELTA_WORKERS 32
+#define DELTA_SEGMENT_MIN (16*1024*1024)	/* smallest segment worth a worker */
+
 static uint32 tablesize;
 static int32 *hash_table;
 
@@ -137,8 +142,41 @@ static void matched(int f, struct sum_struct *s, struct map_struct *buf,
 }
 
 
-static void hash_search(int f,struct sum_struct *s,
-			struct map_struct *buf, OFF_T len)
+/* The matches a search worker found, in the order found (see
+ * segment_search()).  Each is a SEG_RECORD_LEN record: the offset
+ * (8 bytes) and the block (4 bytes); the last has an offset of -1 and
+ * the worker's hash_hits and false_alarms. */
+struct seg_matches {
+	char *buf;
+	int32 len, pos, size;
+	int fd;			/* the worker's pipe, -1 once read to EOF */
+	int done;		/* the last record was seen */
+	pid_t pid;
+};
+
+#define SEG_RECORD_LEN 16
+
+static void note_match(struct seg_matches *out, OFF_T offset, int32 i)
+{
+	char *rec;
+
+	if (out->len + SEG_RECORD_LEN > out->size) {
+		if (full_write(out->fd, out->buf, out->len) != out->len)
+			_exit(RERR_IPC);
+		out->len = 0;
+	}
+	rec = out->buf + out->len;
+	SIVAL64(rec, 0, offset);
+	SIVAL(rec, 8, i);
+	SIVAL(rec, 12, 0);
+	out->len += SEG_RECORD_LEN;
+}
+
+/* Search the match offsets [start, stop) of the len bytes in buf.  With
+ * out NULL the literal data and matches are sent to f; otherwise each
+ * match is only noted in out, for a parallel search to merge. */
+static void hash_search(int f, struct sum_struct *s, struct map_struct *buf,
+			OFF_T start, OFF_T stop, OFF_T len, struct seg_matches *out)
 {
 	OFF_T offset, aligned_offset, end;
 	int32 k, want_i, aligned_i, backup;
@@ -157,9 +195,9 @@ static void hash_search(int f,struct sum_struct *s,
 			(long)s->blength, big_num(len));
 	}
 
-	k = (int32)MIN(len, (OFF_T)s->blength);
+	k = (int32)MIN(len - start, (OFF_T)s->blength);
 
-	map = (schar *)map_ptr(buf, 0, k);
+	map = (schar *)map_ptr(buf, start, k);
 
 	sum = get_checksum1((char *)map, k);
 	s1 = sum & 0xFFFF;
@@ -167,9 +205,10 @@ static void hash_search(int f,struct sum_struct *s,
 	if (DEBUG_GTE(DELTASUM, 3))
 		rprintf(FINFO, "sum=%.8x k=%ld\n", sum, (long)k);
 
-	offset = aligned_offset = aligned_i = 0;
+	offset = start;
+	aligned_offset = aligned_i = 0;
 
-	end = len + 1 - s->sums[s->count-1].len;
+	end = MIN(len + 1 - s->sums[s->count-1].len, stop);
 
 	if (DEBUG_GTE(DELTASUM, 3)) {
 		rprintf(FINFO, "hash search s->blength=%ld len=%s count=%s\n",
@@ -299,7 +338,11 @@ static void hash_search(int f,struct sum_struct *s,
 			}
 			want_i = i + 1;
 
-			matched(f,s,buf,offset,i);
+			if (out) {
+				note_match(out, offset, i);
+				last_match = offset + s->sums[i].len;
+			} else
+				matched(f,s,buf,offset,i);
 			offset += s->sums[i].len - 1;
 			k = (int32)MIN((OFF_T)s->blength, len-offset);
 			map = (schar *)map_ptr(buf, offset, k);
@@ -336,14 +379,212 @@ static void hash_search(int f,struct sum_struct *s,
 		   match. The 3 reads are caused by the
 		   running match, the checksum update and the
 		   literal send. */
-		if (backup >= s->blength+CHUNK_SIZE && end-offset > CHUNK_SIZE)
-			matched(f, s, buf, offset - s->blength, -2);
+		if (backup >= s->blength+CHUNK_SIZE && end-offset > CHUNK_SIZE) {
+			if (out)
+				last_match = offset - s->blength;
+			else
+				matched(f, s, buf, offset - s->blength, -2);
+		}
 	} while (++offset < end);
+	if (out)
+		return;
     printf("total compare Times: %ld \n ", total_compareTime);
 	matched(f, s, buf, len, -1);
 	map_ptr(buf, len-1, 1);
 }
 
+#ifdef HAVE_PREAD
+/* Run the hash search of one segment in a worker, writing its matches
+ * to out_fd. */
+static NORETURN void segment_search(struct sum_struct *s, struct map_struct *buf,
+				    OFF_T start, OFF_T stop, OFF_T len, int out_fd)
+{
+	struct seg_matches out;
+	struct map_struct *map;
+	char rec[SEG_RECORD_LEN];
+
+	/* Our messages must not interleave with the sender's multiplexed
+	 * stream, so send them to stderr or the daemon log instead. */
+	msgs2stderr = 1;
+
+	/* Our own window on the file (map_ptr() reads at an offset). */
+	map = map_file(buf->fd, buf->file_size, buf->def_window_size, s->blength);
+	out.size = SEG_RECORD_LEN * 1024;
+	if (!(out.buf = new_array(char, out.size)))
+		_exit(RERR_MALLOC);
+	out.len = 0;
+	out.fd = out_fd;
+	last_match = start;
+	hash_hits = false_alarms = 0;
+
+	hash_search(-1, s, map, start, stop, len, &out);
+
+	/* A read error zeroed some data: leave the segment to the sender. */
+	if (map->status)
+		_exit(RERR_FILEIO);
+	if (full_write(out_fd, out.buf, out.len) != out.len)
+		_exit(RERR_IPC);
+	SIVAL64(rec, 0, (OFF_T)-1);
+	SIVAL(rec, 8, hash_hits);
+	SIVAL(rec, 12, false_alarms);
+	if (full_write(out_fd, rec, sizeof rec) != sizeof rec)
+		_exit(RERR_IPC);
+	_exit(0);
+}
+
+/* Send the matches of one segment that start at or after last_match,
+ * with the literal data between them.  Returns 1 once the segment's last
+ * record has been used. */
+static int merge_segment(int f, struct sum_struct *s, struct map_struct *buf,
+			 struct seg_matches *seg, int32 *want_i)
+{
+	for ( ; seg->pos + SEG_RECORD_LEN <= seg->len; seg->pos += SEG_RECORD_LEN) {
+		char *rec = seg->buf + seg->pos;
+		OFF_T offset = IVAL64(rec, 0), j;
+		int32 i = IVAL(rec, 8);
+
+		if (offset < 0) {
+			hash_hits += i;
+			false_alarms += IVAL(rec, 12);
+			seg->pos += SEG_RECORD_LEN;
+			seg->done = 1;
+			break;
+		}
+		/* Overlaps the previous segment's last match. */
+		if (offset < last_match)
+			continue;
+		/* The worker could not see the match before this one. */
+		if (i != *want_i && *want_i < s->count
+		 && s->sums[i].sum1 == s->sums[*want_i].sum1
+		 && memcmp(s->sums[i].sum2, s->sums[*want_i].sum2, s->s2length) == 0)
+			i = *want_i;
+		*want_i = i + 1;
+
+		for (j = last_match + CHUNK_SIZE; j < offset; j += CHUNK_SIZE)
+			matched(f, s, buf, j, -2);
+		matched(f, s, buf, offset, i);
+		matches++;
+	}
+	if (seg->pos) {
+		memmove(seg->buf, seg->buf + seg->pos, seg->len - seg->pos);
+		seg->len -= seg->pos;
+		seg->pos = 0;
+	}
+
+	return seg->done;
+}
+
+/* Split the search of a big file into nseg segments, each searched by a
+ * forked worker with its own read window.  A match may run past the end
+ * of its segment, so the next segment's matches that it overlaps are
+ * dropped when the results are merged, in order, into the token stream.
+ * Returns -1 if no worker could be started. */
+static int parallel_hash_search(int f, struct sum_struct *s, struct map_struct *buf,
+				OFF_T len, int nseg)
+{
+	struct seg_matches segs[MAX_DELTA_WORKERS];
+	OFF_T seg_len = (len / nseg + s->blength - 1) / s->blength * s->blength;
+	OFF_T tail;
+	int32 want_i = 0;
+	int n, head = 0, failed = 0;
+
+	for (n = 0; n < nseg && (OFF_T)n * seg_len < len; n++) {
+		int fds[2];
+		if (pipe(fds) < 0)
+			break;
+		if ((segs[n].pid = fork()) < 0) {
+			close(fds[0]);
+			close(fds[1]);
+			break;
+		}
+		if (segs[n].pid == 0) {
+			int j;
+			for (j = 0; j < n; j++)
+				close(segs[j].fd);
+			close(fds[0]);
+			segment_search(s, buf, n * seg_len, MIN((n + 1) * seg_len, len), len, fds[1]);
+		}
+		close(fds[1]);
+		segs[n].fd = fds[0];
+		segs[n].buf = NULL;
+		segs[n].len = segs[n].pos = segs[n].size = 0;
+		segs[n].done = 0;
+	}
+	if (n < nseg && (OFF_T)n * seg_len < len)
+		failed = 1;
+	if (n == 0)
+		return -1;
+
+	while (head < n && !failed) {
+		fd_set r_fds;
+		int j, max_fd = -1;
+
+		FD_ZERO(&r_fds);
+		for (j = head; j < n; j++) {
+			if (segs[j].fd >= 0) {
+				FD_SET(segs[j].fd, &r_fds);
+				max_fd = MAX(max_fd, segs[j].fd);
+			}
+		}
+		if (max_fd >= 0 && select(max_fd + 1, &r_fds, NULL, NULL, NULL) < 0) {
+			if (errno == EINTR)
+				continue;
+			failed = 1;
+			break;
+		}
+		for (j = head; max_fd >= 0 && j < n; j++) {
+			struct seg_matches *seg = segs + j;
+			ssize_t got;
+			if (seg->fd < 0 || !FD_ISSET(seg->fd, &r_fds))
+				continue;
+			if (seg->size - seg->len < 64 * 1024) {
+				seg->size += MAX(seg->size, 64 * 1024);
+				if (!(seg->buf = realloc_array(seg->buf, char, seg->size)))
+					out_of_memory("parallel_hash_search");
+			}
+			if ((got = read(seg->fd, seg->buf + seg->len, seg->size - seg->len)) > 0)
+				seg->len += got;
+			else if (got == 0 || errno != EINTR) {
+				close(seg->fd);
+				seg->fd = -1;
+			}
+		}
+		/* Send what we can, so the head worker's pipe keeps draining. */
+		while (head < n && merge_segment(f, s, buf, segs + head, &want_i))
+			head++;
+		if (head < n && segs[head].fd < 0 && !segs[head].done)
+			failed = 1;
+	}
+
+	/* A worker still writing gets EPIPE and exits.  Success is the last
+	 * record, not the exit status, which remember_children() may have
+	 * had no room to keep. */
+	for (n--; n >= 0; n--) {
+		int status;
+		if (segs[n].fd >= 0)
+			close(segs[n].fd);
+		wait_process(segs[n].pid, &status, 0);
+		if (segs[n].buf)
+			free(segs[n].buf);
+	}
+
+	if (failed) {
+		/* Search the rest here, after what was already sent. */
+		rprintf(FWARNING, "[yee-%s] match.c: delta worker failed, searching the rest in the sender\n", who_am_i());
+		if (last_match < len + 1 - s->sums[s->count-1].len) {
+			hash_search(f, s, buf, last_match, len, len, NULL);
+			return 0;
+		}
+	}
+	/* The tail after the last match, like the gaps in merge_segment(). */
+	for (tail = last_match + CHUNK_SIZE; tail < len; tail += CHUNK_SIZE)
+		matched(f, s, buf, tail, -2);
+	matched(f, s, buf, len, -1);
+	map_ptr(buf, len-1, 1);
+
+	return 0;
+}
+#endif
 
 /**
  * Scan through a origin file, looking for sections that match
@@ -436,7 +677,19 @@ void match_sums(int f, struct sum_struct *s, struct map_struct *buf, OFF_T len)
 			if (DEBUG_GTE(DELTASUM, 2))
 				rprintf(FINFO,"built hash table\n");
 
-			hash_search(f, s, buf, len);
+#ifdef HAVE_PREAD
+			/* Big plain files are searched in segments by delta_workers
+			 * processes (not while updating in place: each match there
+			 * depends on the ones before it). */
+			if (delta_workers > 1 && buf && !buf->chain && !updating_basis_file
+			 && len >= 2 * DELTA_SEGMENT_MIN
+			 && parallel_hash_search(f, s, buf, len,
+						 (int)MIN(MIN(delta_workers, MAX_DELTA_WORKERS),
+							  len / DELTA_SEGMENT_MIN)) == 0)
+				;
+			else
+#endif
+			hash_search(f, s, buf, 0, len, len, NULL);
 
 			if (DEBUG_GTE(DELTASUM, 2))
 				rprintf(FINFO,"done hash search\n");
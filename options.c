@@ -182,8 +182,13 @@ char *dest_option = NULL;
 char *recovery_version = NULL;		// 用户要恢复的版本号 YYYY-mm-dd-HH:MM:SS 需要传给sender模块恢复至指定版本
 char *backup_version = NULL;		// 用户指定的的备份版本号 YYYY-mm-dd-HH:MM:SS 需要传给receiver模块恢复至指定版本
 
-int backup_type = -1;				// 备份类型 0:增量备份 1:差量备份
+int backup_type = -1;				// 备份类型 0:增量备份 1:差量备份 2:反向增量备份
 int backup_version_num = 0;			// 存储端保留的备份版本数目
+char *compact_backups_queue = NULL;	// 执行守护进程延后的版本清理队列(backup compaction = deferred)
+char *recovery_range = NULL;		// 只还原版本中的一段 OFFSET:LEN, 原样传给sender模块
+OFF_T recovery_range_offset = 0;
+OFF_T recovery_range_len = 0;
+int delta_workers = 0;				// 发送端并行分段查找匹配块的进程数
 
 static int remote_option_alloc = 0;
 int remote_option_cnt = 0;
@@ -813,10 +818,14 @@ void usage(enum logcode F)
   rprintf(F," -4, --ipv4                  prefer IPv4\n");
   rprintf(F," -6, --ipv6                  prefer IPv6\n");
   rprintf(F,"     --version               print version number\n");
-  rprintf(F,"     --backup_type=0/1       specify the type of backup, 0 is incremental backup, 1 is differental backup\n");
+  rprintf(F,"     --backup_type=0/1/2     specify the type of backup, 0 is incremental backup, 1 is differental backup,\n");
+  rprintf(F,"                             2 is reverse incremental backup (newest version kept as the full file)\n");
   rprintf(F,"     --backup_version_num=NUM specify the number of backup version\n");
   rprintf(F,"     --backup_version=TIME   specify the version of the file to be backuped\n" );
   rprintf(F,"     --recovery_version=TIME specify the version of the file to be recovered\n");
+  rprintf(F,"     --recovery_range=OFFSET:LEN recover LEN bytes at OFFSET of the version as a new file\n");
+  rprintf(F,"     --compact_backups=QUEUE run the retention jobs a daemon deferred to QUEUE\n");
+  rprintf(F,"     --delta_workers=NUM     search big files for matching blocks in NUM processes\n");
   rprintf(F,"(-h) --help                  show this help (-h is --help only if used alone)\n");
 
   rprintf(F,"\n");
@@ -831,17 +840,20 @@ enum {OPT_VERSION = 1000, OPT_DAEMON, OPT_SENDER, OPT_EXCLUDE, OPT_EXCLUDE_FROM,
       OPT_READ_BATCH, OPT_WRITE_BATCH, OPT_ONLY_WRITE_BATCH, OPT_MAX_SIZE,
       OPT_NO_D, OPT_APPEND, OPT_NO_ICONV, OPT_INFO, OPT_DEBUG,
       OPT_USERMAP, OPT_GROUPMAP, OPT_CHOWN, OPT_BWLIMIT,
-      OPT_SERVER, OPT_REFUSED_BASE = 9000
+      OPT_SERVER, OPT_RECOVERY_RANGE, OPT_BACKUP_VERSION, OPT_REFUSED_BASE = 9000
 	//   ,OPT_RECOVERY_VERSION				// 参数 恢复版本
 	  };
 
 static struct poptOption long_options[] = {
   /* longName, shortName, argInfo, argPtr, value, descrip, argDesc */
   {"help",             0,  POPT_ARG_NONE,   0, OPT_HELP, 0, 0 },
-  {"recovery_version", 0,  POPT_ARG_STRING, &recovery_version, 0, 0, 0},
-  {"backup_version",   0,  POPT_ARG_STRING, &backup_version, 0, 0, 0},
+  {"recovery_version", 0,  POPT_ARG_STRING, &recovery_version, OPT_BACKUP_VERSION, 0, 0},
+  {"backup_version",   0,  POPT_ARG_STRING, &backup_version, OPT_BACKUP_VERSION, 0, 0},
   {"backup_type",	   0,  POPT_ARG_INT,	&backup_type, 0, 0, 0},
   {"backup_version_num", 0,POPT_ARG_INT, 	&backup_version_num, 0, 0, 0},
+  {"compact_backups",  0,  POPT_ARG_STRING, &compact_backups_queue, 0, 0, 0},
+  {"recovery_range",   0,  POPT_ARG_STRING, &recovery_range, OPT_RECOVERY_RANGE, 0, 0},
+  {"delta_workers",    0,  POPT_ARG_INT,    &delta_workers, 0, 0, 0},
   {"version",          0,  POPT_ARG_NONE,   0, OPT_VERSION, 0, 0},
   {"verbose",         'v', POPT_ARG_NONE,   0, 'v', 0, 0 },
   {"no-verbose",       0,  POPT_ARG_VAL,    &verbose, 0, 0, 0 },
@@ -1792,6 +1804,36 @@ int parse_arguments(int *argc_p, const char ***argv_p)
 			break;
 		}
 
+		case OPT_BACKUP_VERSION: {	// 版本号按秒数比较(见version_id()), 必须是 YYYY-mm-dd-HH:MM:SS 或其前缀
+			const char *bad = backup_version && version_id(backup_version) < 0 ? backup_version
+					: recovery_version && version_id(recovery_version) < 0 ? recovery_version : NULL;
+			if (bad) {
+				snprintf(err_buf, sizeof err_buf,
+					"version %s is not YYYY-mm-dd-HH:MM:SS\n", bad);
+				return 0;
+			}
+			break;
+		}
+
+		case OPT_RECOVERY_RANGE: {
+			char *off_arg, *len_arg = NULL, *colon;
+			if (!(off_arg = strdup(recovery_range)))
+				out_of_memory("parse_arguments");
+			if ((colon = strchr(off_arg, ':')) != NULL) {
+				*colon = '\0';
+				len_arg = colon + 1;
+			}
+			if (!colon
+			 || (recovery_range_offset = parse_size_arg(&off_arg, 'b')) < 0
+			 || (recovery_range_len = parse_size_arg(&len_arg, 'b')) < 0) {
+				snprintf(err_buf, sizeof err_buf,
+					"--recovery_range value is invalid: %s\n",
+					recovery_range);
+				return 0;
+			}
+			break;
+		}
+
 		case OPT_HELP:
 			usage(FINFO);
 			exit_cleanup(0);
@@ -2061,7 +2103,7 @@ int parse_arguments(int *argc_p, const char ***argv_p)
 			xfer_dirs = 1;
 	}
 
-	if (argc < 2 && !read_batch && !am_server)
+	if (argc < 2 && !read_batch && !am_server && !compact_backups_queue)
 		list_only |= 1;
 
 	if (xfer_dirs >= 4) {
@@ -2550,6 +2592,8 @@ void server_options(char **args, int *argc_p)
 		eFlags[x++] = 'f'; /* flist I/O-error safety support */
 		eFlags[x++] = 'x'; /* xattr hardlink optimization not desired */
 		eFlags[x++] = 'C'; /* support checksum seed order fix */
+		eFlags[x++] = 'H'; /* support XXH3 checksums */
+		eFlags[x++] = 'K'; /* support the backup checkpoint count in the stats */
 #undef eFlags
 	}
 
@@ -2828,6 +2872,19 @@ void server_options(char **args, int *argc_p)
 	if (do_compression > 1)
 		args[ac++] = "--new-compress";
 
+	if (recovery_range) {
+		if (asprintf(&arg, "--recovery_range=%s", recovery_range) < 0)
+			goto oom;
+		args[ac++] = arg;
+	}
+
+	/* Only a sender searches for matches. */
+	if (delta_workers > 1 && !am_sender) {
+		if (asprintf(&arg, "--delta_workers=%d", delta_workers) < 0)
+			goto oom;
+		args[ac++] = arg;
+	}
+
 	if (remote_option_cnt) {
 		int j;
 		if (ac + remote_option_cnt > MAX_SERVER_ARGS) {
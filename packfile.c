@@ -0,0 +1,600 @@
+/*
+ * Shared pack files for the versions of small files ("pack threshold" in
+ * rsyncd.conf).
+ *
+ * Giving every file its own <file>.backup/ tree costs a handful of
+ * directories and files per file, which for a tree of many small files
+ * is far more metadata work than data.  A file no larger than the
+ * threshold that has no <file>.backup/ yet instead has each version
+ * appended whole to a pack shared by its directory:
+ *
+ *	.backup-pack.idx	the index, a header line and one record per line:
+ *		# rsync backup pack 1 GEN
+ *		+ VERSION OFFSET SIZE DIGEST NAME
+ *		- VERSION NAME
+ *	.backup-pack.GEN	the versions' data, appended one after another
+ *
+ * DIGEST is "CSUM_TYPE:hex" or "-", as in a MANIFEST.  Records are only
+ * appended.  Once removed versions hold most of the data, the live ones
+ * are copied to .backup-pack.GEN+1 and a rewritten index is renamed over
+ * the old one, so a reader that loaded the old index still finds the old
+ * data.  A writer holds a lock on the index while it works in the
+ * directory.
+ *
+ * Small versions are always kept whole: a delta of a few KB saves little
+ * and would cost the files this is meant to avoid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, visit the http://fsf.org website.
+ */
+
+#include "rsync.h"
+#include "itypes.h"
+
+#define PACK_INDEX_NAME ".backup-pack.idx"
+#define PACK_DATA_PREFIX ".backup-pack."
+#define PACK_HEADER "# rsync backup pack 1"
+#define PACK_IO_SIZE (64*1024)
+
+/* Don't bother rewriting a pack for less dead data than this. */
+#define PACK_REWRITE_MIN ((OFF_T)1024*1024)
+
+extern int backup_version_num;
+
+/* Files up to this size are packed; 0 turns packing off. */
+int pack_threshold = 0;
+
+struct pack_entry {
+	char *name;
+	char version[BACKUP_VERSION_LEN];
+	int64 id;		/* version_id() of version */
+	OFF_T offset, size;
+	short csum_type;
+	char digest[MAX_DIGEST_LEN];
+	int dead;
+	int32 older;		/* the name's previous entry, -1 for none */
+};
+
+static struct {
+	char dir[MAXPATHLEN];	/* "" when nothing is loaded */
+	int gen;
+	int index_fd;		/* open and locked while writing */
+	int data_fd;
+	struct pack_entry *ents;
+	int32 count, malloced;
+	struct hashtable *names; /* name key -> newest entry + 1 */
+	OFF_T live, dead;
+} pack = { "", 0, -1, -1, NULL, 0, 0, NULL, 0, 0 };
+
+int64 name_key(const char *name)
+{
+	uint32 a = 2166136261U, b = 0x9E3779B9;
+	int64 key;
+
+	for ( ; *name; name++) {
+		a = (a ^ (uchar)*name) * 16777619U;
+		b = (b + (uchar)*name) * 2654435761U;
+	}
+	key = ((int64)a << 32) | b;
+
+	return key ? key : 1;
+}
+
+static void pack_path(char *buf, const char *dir, int gen)
+{
+	char name[64];
+
+	if (gen < 0)
+		strlcpy(name, PACK_INDEX_NAME, sizeof name);
+	else
+		snprintf(name, sizeof name, "%s%d", PACK_DATA_PREFIX, gen);
+	pathjoin(buf, MAXPATHLEN, dir, name);
+}
+
+static void reset_pack(void)
+{
+	int32 i;
+
+	for (i = 0; i < pack.count; i++)
+		free(pack.ents[i].name);
+	if (pack.ents)
+		free(pack.ents);
+	if (pack.names)
+		hashtable_destroy(pack.names);
+	if (pack.index_fd >= 0)
+		close(pack.index_fd);	/* drops the lock */
+	if (pack.data_fd >= 0)
+		close(pack.data_fd);
+	pack.ents = NULL;
+	pack.names = NULL;
+	pack.count = pack.malloced = 0;
+	pack.index_fd = pack.data_fd = -1;
+	pack.live = pack.dead = 0;
+	pack.gen = 0;
+	*pack.dir = '\0';
+}
+
+/* The newest entry for name, or NULL. */
+static struct pack_entry *newest_entry(const char *name)
+{
+	struct ht_int64_node *node = hashtable_find(pack.names, name_key(name), 0);
+	int32 i = node ? (int32)(long)node->data - 1 : -1;
+
+	while (i >= 0 && strcmp(pack.ents[i].name, name) != 0)
+		i = pack.ents[i].older;
+
+	return i >= 0 ? pack.ents + i : NULL;
+}
+
+static struct pack_entry *add_entry(const char *name, const char *version)
+{
+	struct ht_int64_node *node;
+	struct pack_entry *e;
+
+	if (pack.count == pack.malloced) {
+		pack.malloced = pack.malloced ? pack.malloced * 2 : 256;
+		if (!(pack.ents = realloc_array(pack.ents, struct pack_entry, pack.malloced)))
+			out_of_memory("pack add_entry");
+	}
+	e = pack.ents + pack.count;
+	memset(e, 0, sizeof e[0]);
+	if (!(e->name = strdup(name)))
+		out_of_memory("pack add_entry");
+	strlcpy(e->version, version, sizeof e->version);
+	e->id = version_id(version);
+	e->csum_type = -1;
+
+	/* Names that share a key share a list; newest_entry() sorts them out. */
+	node = hashtable_find(pack.names, name_key(name), 1);
+	e->older = node->data ? (int32)(long)node->data - 1 : -1;
+	node->data = (void *)(long)++pack.count;
+
+	return e;
+}
+
+static void mark_dead(struct pack_entry *e)
+{
+	if (e->dead)
+		return;
+	e->dead = 1;
+	pack.live -= e->size;
+	pack.dead += e->size;
+}
+
+static int parse_digest(const char *str, struct pack_entry *e)
+{
+	char *cp;
+	int i, len;
+
+	e->csum_type = -1;
+	if (*str == '-')
+		return 0;
+	e->csum_type = strtol(str, &cp, 10);
+	if (*cp++ != ':' || (len = strlen(cp) / 2) > MAX_DIGEST_LEN)
+		return -1;
+	for (i = 0; i < len; i++) {
+		unsigned int byte;
+		if (sscanf(cp + i*2, "%2x", &byte) != 1)
+			return -1;
+		e->digest[i] = (char)byte;
+	}
+
+	return 0;
+}
+
+static int parse_number(const char *str, int64 *num)
+{
+	for (*num = 0; isDigit(str); str++)
+		*num = *num * 10 + (*str - '0');
+	return *str ? -1 : 0;
+}
+
+static int parse_line(char *line)
+{
+	char version[BACKUP_VERSION_LEN], offset_str[32], size_str[32], digest_str[2*MAX_DIGEST_LEN+16];
+	struct pack_entry *e;
+	int64 offset, size;
+	char *name;
+	int n = 0;
+
+	if ((name = strchr(line, '\n')) != NULL)
+		*name = '\0';
+
+	/* The name is everything after the single space that ends the
+	 * other fields, since it may hold spaces of its own. */
+	if (*line == '-') {
+		if (sscanf(line, "- %31s%n", version, &n) != 1 || line[n] != ' ' || !line[n+1])
+			return -1;
+		name = line + n + 1;
+		for (e = newest_entry(name); e; e = e->older >= 0 ? pack.ents + e->older : NULL) {
+			if (strcmp(e->name, name) == 0 && strcmp(e->version, version) == 0)
+				mark_dead(e);
+		}
+		return 0;
+	}
+
+	if (sscanf(line, "+ %31s %31s %31s %47s%n", version, offset_str, size_str, digest_str, &n) != 4
+	 || line[n] != ' ' || !line[n+1]
+	 || parse_number(offset_str, &offset) < 0 || parse_number(size_str, &size) < 0)
+		return -1;
+	e = add_entry(line + n + 1, version);
+	e->offset = offset;
+	e->size = size;
+	pack.live += size;
+
+	return parse_digest(digest_str, e);
+}
+
+/* Lock the index of dir (creating it if need be), making sure the lock
+ * is on the file that is at the path and not one a rewrite replaced. */
+static int lock_index(const char *path)
+{
+	STRUCT_STAT st, st2;
+	struct flock lock;
+	int fd;
+
+	while (1) {
+		if ((fd = do_open(path, O_RDWR|O_CREAT, 0644)) < 0)
+			return -1;
+		lock.l_type = F_WRLCK;
+		lock.l_whence = SEEK_SET;
+		lock.l_start = 0;
+		lock.l_len = 0;
+		lock.l_pid = 0;
+		while (fcntl(fd, F_SETLKW, &lock) < 0) {
+			if (errno != EINTR) {
+				close(fd);
+				return -1;
+			}
+		}
+		if (do_fstat(fd, &st) == 0 && do_stat(path, &st2) == 0
+		 && st.st_dev == st2.st_dev && st.st_ino == st2.st_ino)
+			return fd;
+		close(fd);
+	}
+}
+
+/* Load the pack of dir, locked for writing if writing is set.  A
+ * directory without a pack is loaded as an empty one. */
+static int load_pack(const char *dir, int writing)
+{
+	char path[MAXPATHLEN], line[MAXPATHLEN + 256];
+	FILE *fp;
+	int lineno = 0;
+
+	if (*pack.dir && strcmp(pack.dir, dir) == 0 && (pack.index_fd >= 0) == writing)
+		return 0;
+	pack_flush();
+
+	pack.names = hashtable_create(256, 1);
+	strlcpy(pack.dir, dir, sizeof pack.dir);
+	pack_path(path, dir, -1);
+	if (writing && (pack.index_fd = lock_index(path)) < 0) {
+		rsyserr(FERROR_XFER, errno, "lock %s", full_fname(path));
+		goto error;
+	}
+
+	if (!(fp = fopen(path, "r"))) {
+		if (errno == ENOENT && !writing)
+			return 0;
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(path));
+		goto error;
+	}
+	while (fgets(line, sizeof line, fp)) {
+		if (lineno++ == 0) {
+			if (sscanf(line, PACK_HEADER " %d", &pack.gen) != 1)
+				break;
+			continue;
+		}
+		if (parse_line(line) < 0)
+			break;
+	}
+	if (!feof(fp)) {
+		rprintf(FERROR_XFER, "%s is damaged at line %d\n", full_fname(path), lineno);
+		fclose(fp);
+		goto error;
+	}
+	fclose(fp);
+
+	if (writing && lineno == 0) {
+		snprintf(line, sizeof line, PACK_HEADER " %d\n", pack.gen);
+		if (write(pack.index_fd, line, strlen(line)) != (ssize_t)strlen(line)) {
+			rsyserr(FERROR_XFER, errno, "write %s", full_fname(path));
+			goto error;
+		}
+	}
+
+	pack_path(path, dir, pack.gen);
+	pack.data_fd = do_open(path, writing ? O_RDWR|O_CREAT : O_RDONLY, 0644);
+	if (pack.data_fd < 0 && (writing || errno != ENOENT)) {
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(path));
+		goto error;
+	}
+
+	return 0;
+
+  error:
+	reset_pack();
+	return -1;
+}
+
+static int append_record(const char *fmt, ...)
+{
+	char buf[MAXPATHLEN + 256];
+	va_list ap;
+	int len;
+
+	va_start(ap, fmt);
+	len = vsnprintf(buf, sizeof buf, fmt, ap);
+	va_end(ap);
+
+	if (len >= (int)sizeof buf)
+		return -1;
+	if (do_lseek(pack.index_fd, 0, SEEK_END) < 0 || full_write(pack.index_fd, buf, len) != len) {
+		rsyserr(FERROR_XFER, errno, "write %s/%s", pack.dir, PACK_INDEX_NAME);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int remove_entry(struct pack_entry *e)
+{
+	if (e->dead)
+		return 0;
+	if (append_record("- %s %s\n", e->version, e->name) < 0)
+		return -1;
+	mark_dead(e);
+	return 0;
+}
+
+static int copy_data(int src, OFF_T offset, OFF_T len, int dest, char *buf)
+{
+	if (do_lseek(src, offset, SEEK_SET) != offset)
+		return -1;
+	while (len > 0) {
+		int32 n = read(src, buf, (size_t)MIN(len, PACK_IO_SIZE));
+		if (n <= 0) {
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n == 0)
+				errno = ENODATA;
+			return -1;
+		}
+		if (full_write(dest, buf, n) != n)
+			return -1;
+		len -= n;
+	}
+	return 0;
+}
+
+/* Whether fname (in dir, called name) should have its versions packed:
+ * it is small and has never had a <file>.backup/ of its own. */
+int pack_wanted(const char *fname, const char *name, OFF_T size)
+{
+	char path[MAXPATHLEN];
+	STRUCT_STAT st;
+
+	if (pack_threshold <= 0 || size > pack_threshold || strchr(name, '\n')
+	 || strncmp(name, PACK_DATA_PREFIX, strlen(PACK_DATA_PREFIX)) == 0)
+		return 0;
+	snprintf(path, sizeof path, "%s.backup", fname);
+
+	return do_stat(path, &st) < 0 && errno == ENOENT;
+}
+
+/* Append the file fname, now version of dir/name, to dir's pack, and
+ * drop the name's versions beyond the number kept. */
+int pack_add(const char *dir, const char *name, const char *fname, const char *version,
+	     int csum_type, const char *digest)
+{
+	struct pack_entry *e;
+	char *buf, digest_str[2*MAX_DIGEST_LEN+16];
+	STRUCT_STAT st;
+	OFF_T offset;
+	int fd, i, keep, ret = 0;
+
+	if (load_pack(dir, 1) < 0)
+		return -1;
+
+	if ((fd = do_open(fname, O_RDONLY, 0)) < 0 || do_fstat(fd, &st) < 0) {
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(fname));
+		if (fd >= 0)
+			close(fd);
+		return -1;
+	}
+	if (!(buf = new_array(char, PACK_IO_SIZE)))
+		out_of_memory("pack_add");
+	if ((offset = do_lseek(pack.data_fd, 0, SEEK_END)) < 0
+	 || copy_data(fd, 0, st.st_size, pack.data_fd, buf) < 0) {
+		rsyserr(FERROR_XFER, errno, "copy %s to %s/%s%d", full_fname(fname),
+			dir, PACK_DATA_PREFIX, pack.gen);
+		ret = -1;
+	}
+	free(buf);
+	close(fd);
+	if (ret < 0)
+		return -1;
+
+	/* A version stored again replaces the earlier copy. */
+	for (e = newest_entry(name); e; e = e->older >= 0 ? pack.ents + e->older : NULL) {
+		if (strcmp(e->name, name) == 0 && strcmp(e->version, version) == 0)
+			remove_entry(e);
+	}
+
+	if (csum_type < 0)
+		strlcpy(digest_str, "-", sizeof digest_str);
+	else {
+		int len = csum_len_for_type(csum_type, 0);
+		char *cp = digest_str + snprintf(digest_str, sizeof digest_str, "%d:", csum_type);
+		for (i = 0; i < len; i++, cp += 2)
+			snprintf(cp, 3, "%02x", (uchar)digest[i]);
+	}
+	if (append_record("+ %s %s %s %s %s\n", version, do_big_num(offset, 0, NULL),
+			  do_big_num(st.st_size, 0, NULL), digest_str, name) < 0)
+		return -1;
+
+	e = add_entry(name, version);
+	e->offset = offset;
+	e->size = st.st_size;
+	e->csum_type = csum_type;
+	if (csum_type >= 0)
+		memcpy(e->digest, digest, csum_len_for_type(csum_type, 0));
+	pack.live += st.st_size;
+
+	keep = MAX(backup_version_num, 1);
+	for (i = 0; e; e = e->older >= 0 ? pack.ents + e->older : NULL) {
+		if (e->dead || strcmp(e->name, name) != 0)
+			continue;
+		if (++i > keep && remove_entry(e) < 0)
+			return -1;
+	}
+
+	return 0;
+}
+
+/* Copy the live versions into the next generation of the pack. */
+static int rewrite_pack(void)
+{
+	char path[MAXPATHLEN], new_path[MAXPATHLEN], index_path[MAXPATHLEN], tmp[MAXPATHLEN];
+	char *buf, digest_str[2*MAX_DIGEST_LEN+16];
+	OFF_T offset = 0;
+	int new_fd, ret = 0;
+	int32 i;
+	FILE *fp;
+
+	pack_path(path, pack.dir, pack.gen);
+	pack_path(new_path, pack.dir, pack.gen + 1);
+	pack_path(index_path, pack.dir, -1);
+	pathjoin(tmp, sizeof tmp, pack.dir, PACK_INDEX_NAME ".tmp");
+
+	if ((new_fd = do_open(new_path, O_WRONLY|O_CREAT|O_TRUNC, 0644)) < 0) {
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(new_path));
+		return -1;
+	}
+	if (!(fp = fopen(tmp, "w"))) {
+		rsyserr(FERROR_XFER, errno, "open %s", full_fname(tmp));
+		close(new_fd);
+		do_unlink(new_path);
+		return -1;
+	}
+	if (!(buf = new_array(char, PACK_IO_SIZE)))
+		out_of_memory("rewrite_pack");
+
+	fprintf(fp, PACK_HEADER " %d\n", pack.gen + 1);
+	for (i = 0; i < pack.count && ret == 0; i++) {
+		struct pack_entry *e = pack.ents + i;
+		if (e->dead)
+			continue;
+		if (copy_data(pack.data_fd, e->offset, e->size, new_fd, buf) < 0) {
+			rsyserr(FERROR_XFER, errno, "copy to %s", full_fname(new_path));
+			ret = -1;
+			break;
+		}
+		if (e->csum_type < 0)
+			strlcpy(digest_str, "-", sizeof digest_str);
+		else {
+			int j, len = csum_len_for_type(e->csum_type, 0);
+			char *cp = digest_str + snprintf(digest_str, sizeof digest_str, "%d:", e->csum_type);
+			for (j = 0; j < len; j++, cp += 2)
+				snprintf(cp, 3, "%02x", (uchar)e->digest[j]);
+		}
+		fprintf(fp, "+ %s %s %s %s %s\n", e->version, do_big_num(offset, 0, NULL),
+			do_big_num(e->size, 0, NULL), digest_str, e->name);
+		offset += e->size;
+	}
+	free(buf);
+
+	if (close(new_fd) < 0 && ret == 0) {
+		rsyserr(FERROR_XFER, errno, "close failed on %s", full_fname(new_path));
+		ret = -1;
+	}
+	if (fclose(fp) != 0 && ret == 0) {
+		rsyserr(FERROR_XFER, errno, "write %s", full_fname(tmp));
+		ret = -1;
+	}
+	if (ret == 0 && do_rename(tmp, index_path) < 0) {
+		rsyserr(FERROR_XFER, errno, "rename %s", full_fname(tmp));
+		ret = -1;
+	}
+	if (ret < 0) {
+		do_unlink(tmp);
+		do_unlink(new_path);
+		return -1;
+	}
+	do_unlink(path);
+
+	return 0;
+}
+
+/* Finish with the loaded pack: rewrite it if removed versions hold most
+ * of its data, and release the lock. */
+void pack_flush(void)
+{
+	if (pack.index_fd >= 0 && pack.dead > pack.live && pack.dead >= PACK_REWRITE_MIN)
+		rewrite_pack();
+	reset_pack();
+}
+
+/* The newest live entry of dir/name whose version id is at most until, or NULL. */
+static struct pack_entry *find_version(const char *dir, const char *name, int64 until)
+{
+	struct pack_entry *e, *best = NULL;
+
+	if (load_pack(dir, 0) < 0 || !pack.count)
+		return NULL;
+
+	for (e = newest_entry(name); e; e = e->older >= 0 ? pack.ents + e->older : NULL) {
+		if (e->dead || strcmp(e->name, name) != 0 || e->id < 0 || e->id > until)
+			continue;
+		if (!best || e->id > best->id)
+			best = e;
+	}
+
+	return best;
+}
+
+/* A chain over the newest packed version of dir/name whose version id
+ * is at most until; its version string goes to version.  Returns NULL if there is
+ * none. */
+struct delta_chain *pack_open_version(const char *dir, const char *name, int64 until, char *version)
+{
+	char path[MAXPATHLEN];
+	struct pack_entry *best = find_version(dir, name, until);
+
+	if (!best)
+		return NULL;
+
+	strlcpy(version, best->version, BACKUP_VERSION_LEN);
+	pack_path(path, dir, pack.gen);
+
+	return delta_chain_open_range(path, best->offset, best->size);
+}
+
+/* Fill in the version, size and digest of the version pack_open_version()
+ * would open.  Returns -1 if there is none. */
+int pack_version_info(const char *dir, const char *name, int64 until, struct backup_version *info)
+{
+	struct pack_entry *best = find_version(dir, name, until);
+
+	if (!best)
+		return -1;
+
+	strlcpy(info->version, best->version, sizeof info->version);
+	info->id = best->id;
+	info->size = best->size;
+	info->csum_type = best->csum_type;
+	memcpy(info->digest, best->digest, sizeof info->digest);
+
+	return 0;
+}
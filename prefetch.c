@@ -0,0 +1,447 @@
+/*
+ * Restore prefetch: worker processes that rebuild the versions of the
+ * files a restore will send next while the sender is still busy with
+ * the current one.
+ *
+ * send_files() otherwise opens a version's delta chain only when the
+ * generator asks for the file, so reading chunk lists and inflating
+ * compressed frames for file N+1 waits until file N has gone out over
+ * the network.  With "restore workers" set, the sender hands the
+ * regular files that follow the one it is sending to a pool of forked
+ * workers.  Each writes the version it is given into a private
+ * directory in the transfer root, and when that file comes up the
+ * sender reads it as a plain file (unlinking it as soon as it is open).
+ *
+ * At most PREFETCH_FILES_PER_WORKER files per worker are queued, and
+ * no more than "restore prefetch limit" megabytes of them (going by the
+ * live files' sizes), so the disk a restore uses stays bounded.  A file
+ * that was never queued, or whose worker failed, is rebuilt by the
+ * sender itself as before.
+ *
+ * A job is one line, "NDX PATH\n", on the worker's own pipe; the worker
+ * answers each in order with an 8-byte record (NDX, 1 if the version
+ * was written) on its result pipe.
+ */
+
+#include "rsync.h"
+
+extern int msgs2stderr;
+extern char *recovery_version;
+extern struct file_list *cur_flist;
+
+int restore_workers = 0;
+int restore_prefetch_limit = 256;	/* megabytes */
+
+#define PREFETCH_FILES_PER_WORKER 4
+#define PREFETCH_MAX_WORKERS 16
+#define PREFETCH_JOB_MAX (MAXPATHLEN * 2 + 32)
+
+#define SLOT_FREE	0
+#define SLOT_QUEUED	1
+#define SLOT_STALE	2	/* passed over by the generator */
+#define SLOT_DONE	3
+
+struct prefetch_slot {
+	int ndx;
+	int worker;
+	int state;
+	int ok;			/* done: the version was written */
+	OFF_T size;		/* the live file's, for the budget */
+};
+
+static struct {
+	int started, nworkers, nslots;
+	pid_t pids[PREFETCH_MAX_WORKERS];
+	int job_fds[PREFETCH_MAX_WORKERS];
+	int result_fds[PREFETCH_MAX_WORKERS];
+	int pending[PREFETCH_MAX_WORKERS];
+	struct prefetch_slot slots[PREFETCH_MAX_WORKERS * PREFETCH_FILES_PER_WORKER];
+	OFF_T queued_bytes;
+	int next_ndx;		/* the first file not yet considered */
+	pid_t owner;		/* the sender, which removes dir */
+	char dir[MAXPATHLEN];
+} pf;
+
+/* Where file ndx's version goes; -1 if that doesn't fit in a path. */
+static int temp_name(char *buf, int ndx)
+{
+	int len = snprintf(buf, MAXPATHLEN, "%s/%d", pf.dir, ndx);
+
+	return len >= MAXPATHLEN ? -1 : 0;
+}
+
+static NORETURN void worker_main(int in_fd, int out_fd)
+{
+	char line[PREFETCH_JOB_MAX], dest[MAXPATHLEN], rec[8];
+	char *path;
+	FILE *in;
+	int ndx, len;
+
+	/* Our messages must not interleave with the sender's multiplexed
+	 * stream, so send them to stderr or the daemon log instead. */
+	msgs2stderr = 1;
+
+	if (!(in = fdopen(in_fd, "r")))
+		_exit(RERR_IPC);
+	while (fgets(line, sizeof line, in)) {
+		if ((len = strlen(line)) > 0 && line[len-1] == '\n')
+			line[--len] = '\0';
+		if (sscanf(line, "%d", &ndx) != 1 || !(path = strchr(line, ' ')))
+			_exit(RERR_IPC);
+		SIVAL(rec, 0, ndx);
+		SIVAL(rec, 4, temp_name(dest, ndx) == 0
+			   && backup_version_extract(path + 1, recovery_version, dest) == 0);
+		if (write(out_fd, rec, sizeof rec) != sizeof rec)
+			_exit(RERR_IPC);
+	}
+	fclose(in);
+
+	_exit(0);
+}
+
+static void start_workers(void)
+{
+	char root[MAXPATHLEN];
+	int i;
+
+	pf.started = 1;
+	if (restore_workers <= 0)
+		return;
+
+	pathjoin(pf.dir, sizeof pf.dir, pathname_dir(NULL, root, sizeof root), ".rsync-restore.XXXXXX");
+	if (!mkdtemp(pf.dir)) {
+		rsyserr(FWARNING, errno, "restore prefetch directory %s", pf.dir);
+		return;
+	}
+	pf.owner = getpid();
+
+	for (i = 0; i < MIN(restore_workers, PREFETCH_MAX_WORKERS); i++) {
+		int jobs[2], results[2];
+		if (pipe(jobs) < 0)
+			break;
+		if (pipe(results) < 0) {
+			close(jobs[0]);
+			close(jobs[1]);
+			break;
+		}
+		if ((pf.pids[i] = do_fork()) < 0) {
+			close(jobs[0]);
+			close(jobs[1]);
+			close(results[0]);
+			close(results[1]);
+			break;
+		}
+		if (pf.pids[i] == 0) {
+			int j;
+			for (j = 0; j < i; j++) {
+				close(pf.job_fds[j]);
+				close(pf.result_fds[j]);
+			}
+			close(jobs[1]);
+			close(results[0]);
+			worker_main(jobs[0], results[1]);
+		}
+		close(jobs[0]);
+		close(results[1]);
+		pf.job_fds[i] = jobs[1];
+		pf.result_fds[i] = results[0];
+		pf.nworkers++;
+	}
+	if (!pf.nworkers) {
+		rsyserr(FWARNING, errno, "restore prefetch workers");
+		rmdir(pf.dir);
+		return;
+	}
+	pf.nslots = pf.nworkers * PREFETCH_FILES_PER_WORKER;
+}
+
+static int read_record(int fd, char *buf, int len)
+{
+	int done = 0;
+
+	if (fd < 0)
+		return -1;
+	while (done < len) {
+		int n = read(fd, buf + done, len - done);
+		if (n <= 0) {
+			if (n < 0 && errno == EINTR)
+				continue;
+			return -1;
+		}
+		done += n;
+	}
+	return 0;
+}
+
+static struct prefetch_slot *find_slot(int ndx)
+{
+	int i;
+
+	for (i = 0; i < pf.nslots; i++) {
+		if (pf.slots[i].state != SLOT_FREE && pf.slots[i].ndx == ndx)
+			return pf.slots + i;
+	}
+	return NULL;
+}
+
+/* A worker that stops answering gets no more jobs; whatever it had not
+ * finished is rebuilt by the sender. */
+static void lose_worker(int w)
+{
+	int i;
+
+	close(pf.job_fds[w]);
+	close(pf.result_fds[w]);
+	pf.job_fds[w] = pf.result_fds[w] = -1;
+	for (i = 0; i < pf.nslots; i++) {
+		struct prefetch_slot *slot = pf.slots + i;
+		if ((slot->state == SLOT_QUEUED || slot->state == SLOT_STALE) && slot->worker == w) {
+			if (slot->state == SLOT_QUEUED)
+				pf.queued_bytes -= slot->size;
+			slot->state = SLOT_FREE;
+		}
+	}
+	pf.pending[w] = 0;
+}
+
+/* Drop a slot, removing the version its worker wrote if there is one. */
+static void free_slot(struct prefetch_slot *slot)
+{
+	char fname[MAXPATHLEN];
+
+	if (slot->state == SLOT_DONE && slot->ok && temp_name(fname, slot->ndx) == 0)
+		do_unlink(fname);
+	if (slot->state == SLOT_QUEUED || slot->state == SLOT_DONE)
+		pf.queued_bytes -= slot->size;
+	slot->state = SLOT_FREE;
+}
+
+/* Read worker w's next answer into its slot.  Returns -1 if the worker
+ * is gone. */
+static int read_result(int w)
+{
+	struct prefetch_slot *slot;
+	char rec[8];
+
+	if (read_record(pf.result_fds[w], rec, sizeof rec) < 0) {
+		rprintf(FWARNING, "[yee-%s] prefetch.c: restore worker %d went away\n", who_am_i(), w);
+		lose_worker(w);
+		return -1;
+	}
+	pf.pending[w]--;
+
+	if (!(slot = find_slot(IVAL(rec, 0))) || slot->worker != w)
+		return 0;
+	if (slot->state == SLOT_STALE) {
+		slot->state = SLOT_DONE;
+		slot->ok = IVAL(rec, 4);
+		slot->size = 0;
+		free_slot(slot);
+	} else if (slot->state == SLOT_QUEUED) {
+		slot->state = SLOT_DONE;
+		slot->ok = IVAL(rec, 4);
+	}
+
+	return 0;
+}
+
+/* Collect the answers that are already there, so that files the
+ * generator passed over give their slots back. */
+static void drain_results(void)
+{
+	int w;
+
+	for (w = 0; w < pf.nworkers; w++) {
+		while (pf.result_fds[w] >= 0 && pf.pending[w] > 0) {
+			struct timeval tv;
+			fd_set r_fds;
+			FD_ZERO(&r_fds);
+			FD_SET(pf.result_fds[w], &r_fds);
+			tv.tv_sec = tv.tv_usec = 0;
+			if (select(pf.result_fds[w] + 1, &r_fds, NULL, NULL, &tv) <= 0
+			 || read_result(w) < 0)
+				break;
+		}
+	}
+}
+
+/* Queue the regular files after ndx, as far as the lookahead and the
+ * budget allow. */
+static void fill_queue(int ndx)
+{
+	OFF_T limit = (OFF_T)restore_prefetch_limit * 1024 * 1024;
+	char dir[MAXPATHLEN], fname[MAXPATHLEN], line[PREFETCH_JOB_MAX];
+	struct file_list *flist;
+
+	if (pf.next_ndx <= ndx)
+		pf.next_ndx = ndx + 1;
+
+	for (flist = cur_flist; flist; flist = flist->next) {
+		while (pf.next_ndx < flist->ndx_start + flist->used) {
+			struct file_struct *file;
+			struct prefetch_slot *slot = NULL;
+			int i, w, best = -1, len;
+
+			if (pf.next_ndx < flist->ndx_start) {
+				pf.next_ndx = flist->ndx_start;
+				continue;
+			}
+			file = flist->files[pf.next_ndx - flist->ndx_start];
+			if (!S_ISREG(file->mode)) {
+				pf.next_ndx++;
+				continue;
+			}
+			if (pf.queued_bytes && pf.queued_bytes + F_LENGTH(file) > limit)
+				return;
+			for (i = 0; i < pf.nslots && !slot; i++) {
+				if (pf.slots[i].state == SLOT_FREE)
+					slot = pf.slots + i;
+			}
+			for (w = 0; w < pf.nworkers; w++) {
+				if (pf.job_fds[w] >= 0 && pf.pending[w] < PREFETCH_FILES_PER_WORKER
+				 && (best < 0 || pf.pending[w] < pf.pending[best]))
+					best = w;
+			}
+			if (!slot || best < 0)
+				return;
+
+			len = snprintf(line, sizeof line, "%d %s/%s\n", pf.next_ndx,
+				       pathname_dir(file, dir, sizeof dir), f_name(file, fname));
+			if (len >= (int)sizeof line) {
+				pf.next_ndx++;
+				continue;
+			}
+			if (write(pf.job_fds[best], line, len) != len) {
+				lose_worker(best);
+				continue;
+			}
+			slot->ndx = pf.next_ndx++;
+			slot->worker = best;
+			slot->state = SLOT_QUEUED;
+			slot->size = F_LENGTH(file);
+			pf.pending[best]++;
+			pf.queued_bytes += slot->size;
+		}
+	}
+}
+
+/* Called by the sender when the generator asks for file ndx of a
+ * restore.  Returns a chain over the version a worker rebuilt for it,
+ * or NULL if the sender has to rebuild it itself. */
+struct delta_chain *prefetch_take(int ndx)
+{
+	struct delta_chain *chain = NULL;
+	struct prefetch_slot *slot;
+	char fname[MAXPATHLEN];
+	int i;
+
+	if (!pf.started)
+		start_workers();
+	if (!pf.nslots)
+		return NULL;
+
+	/* Files the generator skipped won't be asked for again (phase 2
+	 * redoes are rebuilt by the sender). */
+	for (i = 0; i < pf.nslots; i++) {
+		slot = pf.slots + i;
+		if (slot->ndx >= ndx)
+			continue;
+		if (slot->state == SLOT_QUEUED) {
+			slot->state = SLOT_STALE;
+			pf.queued_bytes -= slot->size;
+		} else if (slot->state == SLOT_DONE)
+			free_slot(slot);
+	}
+	drain_results();
+
+	if ((slot = find_slot(ndx)) != NULL) {
+		while (slot->state == SLOT_QUEUED) {
+			if (read_result(slot->worker) < 0)
+				break;
+		}
+		if (slot->state == SLOT_DONE) {
+			if (slot->ok && temp_name(fname, ndx) == 0) {
+				chain = delta_chain_open_file(fname);
+				rprintf(FWARNING, "[yee-%s] prefetch.c: file %d was rebuilt by worker %d\n",
+					who_am_i(), ndx, slot->worker);
+			}
+			free_slot(slot);
+		}
+	}
+
+	fill_queue(ndx);
+
+	return chain;
+}
+
+/* Called by the sender after its last file: collects the workers and
+ * removes whatever they wrote that was never sent. */
+void prefetch_finish(void)
+{
+	int i, w, status;
+
+	for (w = 0; w < pf.nworkers; w++) {
+		if (pf.job_fds[w] < 0)
+			continue;
+		close(pf.job_fds[w]);
+		pf.job_fds[w] = -1;
+		while (pf.pending[w] > 0) {
+			if (read_result(w) < 0)
+				break;
+		}
+		if (pf.result_fds[w] >= 0) {
+			close(pf.result_fds[w]);
+			pf.result_fds[w] = -1;
+		}
+	}
+	for (i = 0; i < pf.nslots; i++) {
+		if (pf.slots[i].state != SLOT_FREE)
+			free_slot(pf.slots + i);
+	}
+	for (w = 0; w < pf.nworkers; w++) {
+		if (waitpid(pf.pids[w], &status, 0) == pf.pids[w]
+		 && (!WIFEXITED(status) || WEXITSTATUS(status) != 0))
+			rprintf(FWARNING, "[yee-%s] prefetch.c: restore worker %d failed\n", who_am_i(), w);
+	}
+	if (pf.nworkers)
+		rmdir(pf.dir);
+	pf.nworkers = pf.nslots = 0;
+	pf.queued_bytes = 0;
+}
+
+/* Called by exit_cleanup(), so that a restore that dies before
+ * prefetch_finish() doesn't leave its workers' directory in the
+ * transfer root.  The workers are told to stop (or were already killed)
+ * and collected before whatever they wrote is removed. */
+void prefetch_cleanup(void)
+{
+	char fname[MAXPATHLEN];
+	struct dirent *di;
+	int w, status;
+	DIR *d;
+
+	if (!pf.nworkers || pf.owner != getpid())
+		return;
+
+	for (w = 0; w < pf.nworkers; w++) {
+		if (pf.job_fds[w] >= 0)
+			close(pf.job_fds[w]);
+		if (pf.result_fds[w] >= 0)
+			close(pf.result_fds[w]);
+		pf.job_fds[w] = pf.result_fds[w] = -1;
+	}
+	for (w = 0; w < pf.nworkers; w++)
+		waitpid(pf.pids[w], &status, 0);
+	pf.nworkers = pf.nslots = 0;
+
+	if ((d = opendir(pf.dir)) != NULL) {
+		while ((di = readdir(d)) != NULL) {
+			if (strcmp(di->d_name, ".") == 0 || strcmp(di->d_name, "..") == 0)
+				continue;
+			pathjoin(fname, sizeof fname, pf.dir, di->d_name);
+			unlink(fname);
+		}
+		closedir(d);
+	}
+	rmdir(pf.dir);
+}
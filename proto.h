@@ -20,12 +20,20 @@ void write_stream_flags(int fd);
 void read_stream_flags(int fd);
 void check_batch_flags(void);
 void write_batch_shell_file(int argc, char *argv[], int file_arg_cnt);
+int catalog_restore_open(const char *version);
+struct catalog_entry *catalog_find(const char *fname, int *covered);
+int catalog_stat(const char *fname, STRUCT_STAT *st);
+int catalog_children(const char *dir, struct catalog_entry **first);
+void catalog_add_flist(struct file_list *flist);
+int catalog_run_end(void);
 int parse_checksum_choice(void);
 int parse_csum_name(const char *name, int len);
 int csum_len_for_type(int cst, BOOL flist_csum);
 int canonical_checksum(int csum_type);
 uint32 get_checksum1(char *buf1, int32 len);
 void get_checksum2(char *buf, int32 len, char *sum);
+void get_checksum2_multi(char **bufs, int32 *lens, int cnt, char *sums);
+int get_block_sums(char *buf, int32 len, int32 blength, uint32 *sum1s, char *sums);
 void file_checksum(const char *fname, const STRUCT_STAT *st_p, char *sum);
 void sum_init(int csum_type, int seed);
 void sum_update(const char *p, int32 len);
@@ -34,6 +42,13 @@ struct chmod_mode_struct *parse_chmod(const char *modestr,
 				      struct chmod_mode_struct **root_mode_ptr);
 int tweak_mode(int mode, struct chmod_mode_struct *chmod_modes);
 int free_chmod_mode(struct chmod_mode_struct *chmod_modes);
+void chunk_store_setup(const char *dir);
+int chunk_list_open(const char *fname, int fd, struct chunk_list **clp);
+int32 chunk_list_read(struct chunk_list *cl, OFF_T offset, char *buf, int32 len);
+void chunk_list_close(struct chunk_list *cl);
+int chunk_list_unlink(const char *fname);
+int chunk_store_chain(struct delta_chain *dc, const char *dest_fname);
+void chunk_store_reclaim(void);
 void close_all(void);
 NORETURN void _exit_cleanup(int code, const char *file, int line);
 void cleanup_disable(void);
@@ -64,6 +79,27 @@ void setup_protocol(int f_out,int f_in);
 int claim_connection(char *fname, int max_connections);
 enum delret delete_item(char *fbuf, uint16 mode, uint16 flags);
 uint16 get_del_for_flag(uint16 mode);
+struct delta_file *delta_create(const char *fname, const struct delta_header *hdr);
+int delta_write_copy(struct delta_file *df, OFF_T offset, OFF_T len);
+int delta_write_literal(struct delta_file *df, const char *buf, int32 len);
+struct delta_file *delta_open(const char *fname);
+int delta_read_op(struct delta_file *df, struct delta_op *op);
+int32 delta_read_literal(struct delta_file *df, char *buf, int32 len);
+int delta_flush(struct delta_file *df);
+int delta_close(struct delta_file *df);
+int delta_apply(const char *basis_fname, const char *delta_fname, const char *dest_fname);
+int delta_apply_cloned(const char *basis_fname, const char *delta_fname, const char *dest_fname);
+int delta_invert(const char *fwd_fname, const char *old_fname, const char *dest_fname);
+struct delta_chain *delta_chain_open(const char *basis_fname, char *const *delta_fnames, int ndeltas);
+struct delta_chain *delta_chain_open_lazy(const char *basis_fname, char *const *delta_fnames, int ndeltas);
+struct delta_chain *delta_chain_open_file(const char *fname);
+struct delta_chain *delta_chain_open_range(const char *fname, OFF_T offset, OFF_T len);
+void delta_chain_limit(struct delta_chain *dc, OFF_T offset, OFF_T len);
+int delta_chain_write(struct delta_chain *dc, const char *dest_fname);
+int delta_chain_extract(struct delta_chain *dc, const char *dest_fname);
+int32 delta_chain_read(struct delta_chain *dc, OFF_T offset, char *buf, int32 len);
+void delta_chain_fingerprint(struct delta_chain *dc, char *digest);
+void delta_chain_close(struct delta_chain *dc);
 void set_filter_dir(const char *dir, unsigned int dirlen);
 void *push_local_filters(const char *dir, unsigned int dirlen);
 void pop_local_filters(void *mem);
@@ -84,11 +120,13 @@ int flush_write_file(int f);
 int write_file(int f, int use_seek, OFF_T offset, const char *buf, int len);
 int skip_matched(int fd, OFF_T offset, const char *buf, int len);
 struct map_struct *map_file(int fd, OFF_T len, int32 read_size, int32 blk_size);
+struct map_struct *map_delta_chain(struct delta_chain *dc, int32 read_size, int32 blk_size);
 char *map_ptr(struct map_struct *map, OFF_T offset, int32 len);
 int unmap_file(struct map_struct *map);
 void init_flist(void);
 void show_flist_stats(void);
 int link_stat(const char *path, STRUCT_STAT *stp, int follow_dirlinks);
+char *pathname_dir(struct file_struct *file, char *buf, int bufsize);
 int change_pathname(struct file_struct *file, const char *dir, int dirlen);
 struct file_struct *make_file(const char *fname, struct file_list *flist,
 			      STRUCT_STAT *stp, int flags, int filter_level);
@@ -115,6 +153,7 @@ void itemize(const char *fnamecmp, struct file_struct *file, int ndx, int statre
 	     stat_x *sxp, int32 iflags, uchar fnamecmp_type,
 	     const char *xname);
 int unchanged_file(char *fn, struct file_struct *file, STRUCT_STAT *st);
+void sum_sizes_sqroot(struct sum_struct *sum, int64 len);
 int find_newest_full_backup(const char* fname, char* newest_full_backup);
 int atomic_create(struct file_struct *file, char *fname, const char *slnk, const char *hlnk,
 		  dev_t rdev, stat_x *sxp, int del_for_flag);
@@ -203,7 +242,9 @@ int lp_listen_backlog(void);
 int lp_rsync_port(void);
 char *lp_auth_users(int module_id);
 char *lp_charset(int module_id);
+char *lp_chunk_store(int module_id);
 char *lp_comment(int module_id);
+char *lp_compaction_queue(int module_id);
 char *lp_dont_compress(int module_id);
 char *lp_exclude(int module_id);
 char *lp_exclude_from(int module_id);
@@ -227,10 +268,19 @@ char *lp_secrets_file(int module_id);
 char *lp_syslog_tag(int module_id);
 char *lp_temp_dir(int module_id);
 char *lp_uid(int module_id);
+char *lp_version_cache(int module_id);
+int lp_backup_compaction(int module_id);
+int lp_backup_compression(int module_id);
+int lp_checkpoint_ratio(int module_id);
+int lp_checksum_workers(int module_id);
 int lp_max_connections(int module_id);
 int lp_max_verbosity(int module_id);
+int lp_pack_threshold(int module_id);
+int lp_restore_prefetch_limit(int module_id);
+int lp_restore_workers(int module_id);
 int lp_syslog_facility(int module_id);
 int lp_timeout(int module_id);
+int lp_version_cache_size(int module_id);
 BOOL lp_fake_super(int module_id);
 BOOL lp_forward_lookup(int module_id);
 BOOL lp_ignore_errors(int module_id);
@@ -240,6 +290,8 @@ BOOL lp_munge_symlinks(int module_id);
 BOOL lp_numeric_ids(int module_id);
 BOOL lp_read_only(int module_id);
 BOOL lp_reverse_lookup(int module_id);
+BOOL lp_signature_sidecars(int module_id);
+BOOL lp_snapshot_catalog(int module_id);
 BOOL lp_strict_modes(int module_id);
 BOOL lp_transfer_logging(int module_id);
 BOOL lp_use_chroot(int module_id);
@@ -265,6 +317,8 @@ void log_exit(int code, const char *file, int line);
 pid_t wait_process(pid_t pid, int *status_ptr, int flags);
 void write_del_stats(int f);
 void read_del_stats(int f);
+void write_checkpoint_stats(int f);
+void read_checkpoint_stats(int f);
 char *get_local_name(struct file_list *flist, char *dest_path);
 void check_alt_basis_dirs(void);
 int child_main(int argc, char *argv[]);
@@ -273,6 +327,24 @@ int client_run(int f_in, int f_out, pid_t pid, int argc, char *argv[]);
 void remember_children(UNUSED(int val));
 const char *get_panic_action(void);
 int main(int argc,char *argv[]);
+int64 version_id(const char *version);
+int manifest_open(struct backup_manifest *m, const char *fname);
+int manifest_lock(struct backup_manifest *m);
+void manifest_unlock(struct backup_manifest *m);
+void manifest_close(struct backup_manifest *m);
+struct backup_version *manifest_add(struct backup_manifest *m, int mode, int kind,
+				    const char *version, OFF_T size,
+				    int csum_type, const char *digest,
+				    OFF_T literal, int64 ops);
+int manifest_remove(struct backup_manifest *m, int mode, int kind, const char *version);
+int manifest_range(const struct backup_manifest *m, int mode, int kind, struct backup_version **first);
+struct backup_version *manifest_newest(const struct backup_manifest *m, int mode, int kind);
+struct backup_version *manifest_find(const struct backup_manifest *m, int mode, int kind, const char *version);
+int manifest_span(const struct backup_manifest *m, int mode, int kind, int64 from, int64 to,
+		  struct backup_version **first);
+struct backup_version *manifest_until(const struct backup_manifest *m, int mode, int kind, int64 until);
+const char *backup_mode_name(int mode);
+int manifest_path(const struct backup_manifest *m, int mode, int kind, const char *version, char *buf);
 void match_sums(int f, struct sum_struct *s, struct map_struct *buf, OFF_T len);
 void match_report(void);
 void limit_output_verbosity(int level);
@@ -283,12 +355,22 @@ void option_error(void);
 int parse_arguments(int *argc_p, const char ***argv_p);
 void server_options(char **args, int *argc_p);
 char *check_for_hostspec(char *s, char **host_ptr, int *port_ptr);
+int64 name_key(const char *name);
+int pack_wanted(const char *fname, const char *name, OFF_T size);
+int pack_add(const char *dir, const char *name, const char *fname, const char *version,
+	     int csum_type, const char *digest);
+void pack_flush(void);
+struct delta_chain *pack_open_version(const char *dir, const char *name, int64 until, char *version);
+int pack_version_info(const char *dir, const char *name, int64 until, struct backup_version *info);
 int pm_process( char *FileName,
                  BOOL (*sfunc)(char *),
                  BOOL (*pfunc)(char *, char *) );
 pid_t piped_child(char **command, int *f_in, int *f_out);
 pid_t local_child(int argc, char **argv, int *f_in, int *f_out,
 		  int (*child_main)(int, char*[]));
+struct delta_chain *prefetch_take(int ndx);
+void prefetch_finish(void);
+void prefetch_cleanup(void);
 void set_current_file_index(struct file_struct *file, int ndx);
 void end_progress(OFF_T size);
 void show_progress(OFF_T ofs, OFF_T size);
@@ -300,9 +382,16 @@ int receive_data(int f_in, char *fname_r, int fd_r, OFF_T size_r,
 void discard_receive_data(int f_in, OFF_T length);
 void handle_delayed_updates(char *local_name);
 int gen_wants_ndx(int desired_ndx, int flist_num);
-int update_incre_full_backup(const char* full_file_path, const char* delta_file_path);
-int manage_backup_version(const char* backup_path);
+int update_incre_full_backup(struct backup_manifest *m, const struct backup_version *full,
+			     const struct backup_version *delta);
+int update_reverse_backup(struct backup_manifest *m, const char *fwd_delta);
+int manage_backup_version(struct backup_manifest *m);
 int recv_files(int f_in, int f_out, char *local_name);
+void retention_daemon_setup(int i, const char *chroot_dir);
+void retention_start(void);
+void retention_queue(const char *fname, struct backup_manifest *m);
+void retention_finish(void);
+int retention_run_queue(const char *queue);
 void setup_iconv(void);
 int iconvbufs(iconv_t ic, xbuf *in, xbuf *out, int flags);
 void send_protected_args(int fd, char *args[]);
@@ -321,22 +410,26 @@ int finish_transfer(const char *fname, const char *fnametmp,
 struct file_list *flist_for_ndx(int ndx, const char *fatal_error_loc);
 const char *who_am_i(void);
 void successful_send(int ndx);
-int compare_delta_file_name(const void *a, const void *b);
-void extract_file_name_timestamp(const char *file_name, char *timestamp);
-int make_delta_to_full(const char* fname, const char* recovery_timestamp);
-int read_sort_dir_files(const char* dir_name, char* files[]);
 void print_backup_files_list(const backup_files_list * backup_files);
-int decide_recovery_type(const char* dir_name, const char* file_name, 
-						backup_files_list * incremental_full_files, backup_files_list * incremental_delta_files, 
-						backup_files_list * differential_full_files, backup_files_list * differential_delta_files, 
-						const char* recovery_timestamp );
-int combine_incremental_files(const char* dir_name, const char* file_name,
-							const backup_files_list * full_files, const backup_files_list * delta_files, 
-							const char* recovery_version, char* recovery_file_path)	;
-int combine_differental_files(const char* dir_name, const char* file_name,
-							const backup_files_list * full_files, const backup_files_list * delta_files, 
-							const char* recovery_version, char* recovery_file_path)	;
+int decide_recovery_type(const struct backup_manifest *m, int64 until);
+struct delta_chain *combine_incremental_files(const struct backup_manifest *m, int64 until);
+struct delta_chain *combine_differental_files(const struct backup_manifest *m, int64 until);
+struct delta_chain *combine_reverse_files(const struct backup_manifest *m, int64 until);
+struct delta_chain *backup_version_open(const char *fname, const char *version);
+int backup_version_extract(const char *fname, const char *version, const char *dest);
+int32 backup_read_range(const char *fname, const char *version, OFF_T offset, char *buf, int32 len);
+int backup_version_info(const char *fname, const char *version, struct backup_version *info);
+void restore_version_sum(const char *fname, STRUCT_STAT *st, char *sum);
 void send_files(int f_in, int f_out)    ;
+uint32 signature_seed(const char *module);
+struct sig_sidecar *sig_sidecar_open(const char *full_path, const struct sum_struct *sum);
+int sig_sidecar_read(struct sig_sidecar *s, uint32 *sum1, char *sum2);
+struct sig_sidecar *sig_sidecar_create(const char *full_path, const struct sum_struct *sum);
+void sig_sidecar_add(struct sig_sidecar *s, uint32 sum1, const char *sum2);
+int sig_sidecar_close(struct sig_sidecar *s, int ok);
+int sig_sidecar_write(const char *full_path);
+void sig_sidecar_unlink(const char *full_path);
+int32 get_checksum1_blocks(const schar *buf, int32 len, uint32 *ps1, uint32 *ps2);
 int try_bind_local(int s, int ai_family, int ai_socktype,
 		   const char *bind_addr);
 int open_socket_out(char *host, int port, const char *bind_addr,
@@ -346,6 +439,9 @@ int open_socket_out_wrapped(char *host, int port, const char *bind_addr,
 int is_a_socket(int fd);
 void start_accept_loop(int port, int (*fn)(int, int));
 void set_socket_options(int fd, char *options);
+int sum_workers_begin(const char *path, int chain, OFF_T flength, int32 blength, int32 count);
+int sum_workers_read(uint32 *sum1, char *sum2);
+void sum_workers_finish(void);
 int do_unlink(const char *fname);
 int do_symlink(const char *lnk, const char *fname);
 ssize_t do_readlink(const char *path, char *buf, size_t bufsiz);
@@ -441,6 +537,9 @@ void *_realloc_array(void *ptr, unsigned int size, size_t num);
 const char *sum_as_hex(int csum_type, const char *sum, int flist_csum);
 NORETURN void out_of_memory(const char *str);
 NORETURN void overflow_exit(const char *str);
+void version_cache_setup(const char *dir, int size_mb);
+struct delta_chain *version_cache_open(const char *fname, const char *version, struct delta_chain *dc);
+void version_cache_invalidate(const char *fname);
 void free_xattr(stat_x *sxp);
 int get_xattr(const char *fname, stat_x *sxp);
 int copy_xattrs(const char *source, const char *dest);
@@ -461,6 +560,11 @@ int set_stat_xattr(const char *fname, struct file_struct *file, mode_t new_mode)
 int x_stat(const char *fname, STRUCT_STAT *fst, STRUCT_STAT *xst);
 int x_lstat(const char *fname, STRUCT_STAT *fst, STRUCT_STAT *xst);
 int x_fstat(int fd, STRUCT_STAT *fst, STRUCT_STAT *xst);
+struct zframe_file *zframe_create(int fd, int level);
+int zframe_write(struct zframe_file *zf, const char *buf, int32 len);
+int zframe_close(struct zframe_file *zf);
+int zframe_open(const char *fname, int fd, struct zframe_file **zfp);
+int32 zframe_read(struct zframe_file *zf, OFF_T offset, char *buf, int32 len);
 int sys_gettimeofday(struct timeval *tv);
 char *do_big_num(int64 num, int human_flag, const char *fract);
 char *do_big_dnum(double dnum, int human_flag, int decimal_digits);
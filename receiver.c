@@ -73,12 +73,16 @@ int first_backup = -1;								// 是否是第一次备份，0: 不是第一次
 
 extern int backup_type;
 extern int backup_version_num;
+extern int backup_compression;
 
 // ./path/to/xxxx.backup/incremental(differental)/delta/								增量备份完整路径
 char delta_backup_fpath[MAXPATHLEN];					// 增量备份文件的路径
 
 //./path/to/xxxx.backup/incremental(differental)/delta/xxxx.full.xxxx-xx-xx-xx:xx:xx	增量备份完整文件名
 char delta_backup_fname[MAXPATHLEN];					// 增量备份文件的路径
+int checkpoint_ratio = 100;							// 自上一个全量版本以来delta代价超过文件大小的该百分比时改写全量版本, 0: 不检查
+static OFF_T delta_literal_bytes;					// 本次写入的delta中的字面量字节数
+static int64 delta_op_count;						// 本次写入的delta中的操作数
 
 static struct bitbag *delayed_bits = NULL;
 static int phase = 0, redoing = 0;
@@ -361,23 +365,24 @@ int receive_data(int f_in, char *fname_r, int fd_r, OFF_T size_r,
 		}
 	}
 
-	FILE *delta_fp = NULL;
-	// char dir_name[MAXPATHLEN];
-	// char file_name[MAXPATHLEN];
-	// char delta_fname[MAXPATHLEN];
-	// char delta_fpath[MAXPATHLEN];
+	struct delta_file *delta_df = NULL;
 
+	delta_literal_bytes = 0;
+	delta_op_count = 0;
 	if(!task_type_backup_or_recovery_receiver && first_backup == 0) 
 	{
 		// rprintf(FWARNING, "[yee-%s] receiver.c: receive_data this is a *backup* task, backup_version = %s \n", who_am_i(), backup_version);
-	
-		delta_fp = fopen(delta_backup_fname, "wb");
+		struct delta_header hdr;
 
 		// delta文件元数据信息 -- blength文件块大小
-		char file_metadata[2048];
-		sprintf(file_metadata, "[delta file metadata] file_size = %ld, content_size = %ld, block_size = %d, block_count = %d, remainder_block = %d\n",
-				total_size, size_r, sum.blength, sum.count, sum.remainder);
-		fwrite(file_metadata, sizeof(char)*strlen(file_metadata), 1, delta_fp);
+		hdr.file_size = total_size;
+		hdr.content_size = size_r;
+		hdr.block_size = sum.blength;
+		hdr.block_count = sum.count;
+		hdr.remainder = sum.remainder;
+		hdr.format = DELTA_FORMAT_BINARY;
+		if (!(delta_df = delta_create(delta_backup_fname, &hdr)))
+			rsyserr(FERROR_XFER, errno, "create delta file %s failed", full_fname(delta_backup_fname));
 	}
 
 	while ((i = recv_token(f_in, &data)) != 0) {
@@ -402,25 +407,9 @@ int receive_data(int f_in, char *fname_r, int fd_r, OFF_T size_r,
 				goto report_write_error;
 
 			// 对于backup任务 记录增量信息 -- 写入不匹配的字面量数据
-			if ( !task_type_backup_or_recovery_receiver && first_backup == 0 && delta_fp != NULL && data != NULL) {	
-				char unmatch_info[512];
-				int write_len = -1;
-				
-				sprintf(unmatch_info, "unmatch data length = %d, offset = %ld\n", i, offset);
-				write_len = fwrite(unmatch_info, sizeof(char)*strlen(unmatch_info), 1, delta_fp);
-				// fwrite("\n", sizeof(char)*strlen("\n"), 1, delta_fp);
-				if (write_len < 1) {
-					rsyserr(FERROR_XFER, errno, "write unmatched length and offset on %s, i am %s\n", full_fname(delta_backup_fname), who_am_i());
-					goto report_write_error;
-				}
-
-				
-				write_len = fwrite(data, 1, i, delta_fp);
-				// rprintf(FWARNING, "[yee-%s] wirte unmatch data length is %d write %d\n",who_am_i(), i, write_len);
-				if (write_len != i) {
-					rsyserr(FERROR_XFER, errno, "write unmatched chunk failed on %s", full_fname(delta_backup_fname));			
-					goto report_write_error;
-				}
+			if (delta_df && delta_write_literal(delta_df, data, i) < 0) {
+				rsyserr(FERROR_XFER, errno, "write unmatched chunk failed on %s", full_fname(delta_backup_fname));
+				goto report_write_error;
 			}
 
 			offset += i;
@@ -449,6 +438,12 @@ int receive_data(int f_in, char *fname_r, int fd_r, OFF_T size_r,
 			sum_update(map, len);
 		}
 
+		// 对于backup任务 记录增量信息 -- 匹配的块在基准文件中的位置
+		if (delta_df && delta_write_copy(delta_df, offset2, len) < 0) {
+			rsyserr(FERROR_XFER, errno, "write matched token failed on %s", full_fname(delta_backup_fname));
+			goto report_write_error;
+		}
+
 		if (updating_basis_or_equiv) {
 			if (offset == offset2 && fd != -1) {
 				if (skip_matched(fd, offset, map, len) < 0)
@@ -460,31 +455,21 @@ int receive_data(int f_in, char *fname_r, int fd_r, OFF_T size_r,
 		if (fd != -1 && map && write_file(fd, 0, offset, map, len) != (int)len)
 			goto report_write_error;
 
-		// 对于backup任务 记录增量信息 -- 匹配的块号
-		if ( !task_type_backup_or_recovery_receiver && first_backup == 0 && delta_fp != NULL && map != NULL ) {  
-			int write_len = -1;
-			char match_chunk_id[512];
-			
-			sprintf(match_chunk_id, "match token = %d, offset = %ld, offset2 = %ld \n", i, offset, offset2);
-
-			write_len = fwrite(match_chunk_id, sizeof(char)*strlen(match_chunk_id), 1, delta_fp);
-			
-			// rprintf(FWARNING, "[yee-%s] wirte match index %s write_len = %d\n", who_am_i(), match_chunk_id, write_len);
-
-			if(write_len != 1)
-			{
-				rsyserr(FERROR_XFER, errno, "write matched token failed on %s", full_fname(fname));			
-				goto report_write_error;
-			}
-		}
-
 		offset += len;
 	}
 
 	/*读取结束*/
-	if (!task_type_backup_or_recovery_receiver && delta_fp != NULL) {
-		fclose(delta_fp);
-		delta_fp = NULL;
+	if (delta_df) {
+		int ret = delta_flush(delta_df);	// 写出最后一个COPY/LITERAL, 计数才是整个delta的
+		delta_literal_bytes = delta_df->literal_bytes;
+		delta_op_count = delta_df->op_count;
+		if (delta_close(delta_df) < 0)
+			ret = -1;
+		delta_df = NULL;
+		if (ret < 0) {
+			rsyserr(FERROR_XFER, errno, "close delta file %s failed", full_fname(delta_backup_fname));
+			goto report_write_error;
+		}
 	}
 
 	/*刷入文件*/
@@ -634,236 +619,203 @@ int gen_wants_ndx(int desired_ndx, int flist_num)
 	return 0;
 }
 
-// 更新全量版本文件, 即一次拼接, full_file_path 待更新的全量备份文件 delta_file_path 更新使用的增量部分文件
-int update_incre_full_backup(const char* full_file_path, const char* delta_file_path)
+// 由basis(delta不为NULL时再应用delta)生成全量版本文件dest. 配置了块存储或basis本身在块存储中时写成块列表,
+// 配置了压缩或basis本身已压缩时写成分帧压缩文件, 否则优先reflink克隆basis后只改写delta涉及的区域,
+// 文件系统不支持时整体重写
+static int write_full_version(const char *basis, const char *delta, const char *dest)
+{
+	struct delta_chain *dc;
+	char *deltas[1];
+	int ret;
+
+	deltas[0] = (char *)delta;
+	if(delta)
+		dc = delta_chain_open(basis, deltas, 1);
+	else
+		dc = delta_chain_open_file(basis);	// 接收到的文件本身, 不是备份版本
+	if(dc == NULL)
+		return -1;
+	ret = chunk_store_chain(dc, dest);
+	if(ret > 0 && (delta == NULL || backup_compression || dc->zfs[0]))	// 压缩存储的版本只能经由delta链读写
+		ret = delta_chain_write(dc, dest);
+	delta_chain_close(dc);
+
+	if(ret > 0 && (ret = delta_apply_cloned(basis, delta, dest)) > 0)
+		ret = delta_apply(basis, delta, dest);
+
+	return ret < 0 ? -1 : 0;
+}
+
+// 更新全量版本文件, 即一次拼接, full 待更新的全量备份版本 delta 更新使用的增量版本
+int update_incre_full_backup(struct backup_manifest *m, const struct backup_version *full,
+			     const struct backup_version *delta)
 {
+	struct backup_version d = *delta;			// manifest_add() 可能移动m->vers, 先复制
 	char updated_full_file_path[MAXPATHLEN];	// 新的全量文件路径
-	char new_timestamp[MAXPATHLEN];				// 新的全量文件的时间戳
-
-	
-	extract_file_name_timestamp(delta_file_path, new_timestamp);
-	rprintf(FWARNING, "[yee-%s] delta_file_path = %s, new_timestamp = %s\n",who_am_i(), delta_file_path, new_timestamp);
-	
-	// 分离目录和文件名
-	char *ptr = strrchr(full_file_path, '/');
-	char dir_name[MAXPATHLEN];				// 目录名 /path/to/fold
-	char file_name[MAXPATHLEN];				// 文件名 filename.delta.timestamp
-	char file_name_row[MAXPATHLEN];			// 文件名 filename
-	if(ptr != NULL)
+
+	if (manifest_path(m, d.mode, BACKUP_KIND_FULL, d.version, updated_full_file_path) < 0)
+		return -1;
+
+	rprintf(FWARNING, "[yee-%s] update backup version: %s -> %s\n", who_am_i(), full->path, updated_full_file_path);
+
+	// 以旧的全量文件为基准, 应用delta生成新的全量文件
+	int ret = write_full_version(full->path, d.path, updated_full_file_path);
+	if (ret < 0)
 	{
-		strncpy(dir_name, full_file_path, ptr - full_file_path);
-		dir_name[ptr - full_file_path] = '\0';
-		strcpy(file_name, ptr + 1);
+		rprintf(FWARNING, "[yee-%s] receiver.c: update_incre_full_backup apply %s failed\n", who_am_i(), d.path);
+		return -1;
 	}
-	else
+
+	manifest_add(m, d.mode, BACKUP_KIND_FULL, d.version, d.size, d.csum_type, d.digest, 0, 0);
+
+	return 0;
+}
+
+// 反向增量: 新版本已写为全量文件, 用本次的正向delta把上一个全量版本改写为反向delta,
+// 只保留最新版本为全量; fwd_delta 本次接收时写下的正向delta(上一版本 -> 新版本)
+int update_reverse_backup(struct backup_manifest *m, const char *fwd_delta)
+{
+	struct backup_version *full, prev;
+	char reverse_delta_path[MAXPATHLEN];
+	int full_num = manifest_range(m, BACKUP_MODE_REVERSE, BACKUP_KIND_FULL, &full);
+
+	if(full_num < 2)	// 同一版本号重复备份, 没有需要改写的旧全量版本
 	{
-		strcpy(dir_name, ".");
-		strcpy(file_name, full_file_path);
+		do_unlink(fwd_delta);
+		return 0;
 	}
-	// rprintf(FWARNING, "[yee-%s] dir_name = %s, file_name = %s\n",who_am_i(), dir_name, file_name);
-	
-	// 截取.delta.timestamp部分, 获取原始文件名
-	char *dot_pos = strchr(file_name, '.');
-	strlcpy(file_name_row, file_name, dot_pos - file_name + 1);
-	// rprintf(FWARNING, "[yee-%s] dir_name = %s, file_name = %s\n",who_am_i(), dir_name, file_name_row);
-
-	// 构建新的全量文件名
-	sprintf(updated_full_file_path, "%s/%s.full.%s", dir_name, file_name_row, new_timestamp);
-
-	rprintf(FWARNING, "[yee-%s] update backup version: %s -> %s\n", who_am_i(), full_file_path, updated_full_file_path);
-	
-	FILE *delta_file = fopen(delta_file_path, "rb");
-	FILE *updated_full_file = fopen(updated_full_file_path, "wb");
-	int full_fd = do_open(full_file_path, O_RDONLY, 0);
-
-	if(delta_file == NULL || updated_full_file == NULL || full_fd < 0)
+
+	prev = full[full_num - 2];		// manifest_add() 可能移动m->vers, 先复制
+	if (manifest_path(m, BACKUP_MODE_REVERSE, BACKUP_KIND_DELTA, prev.version, reverse_delta_path) < 0)
 	{
-		rprintf(FWARNING, "[yee-%s] receiver.c: updata_incre_full_backup open file failed\n", who_am_i());
-		rprintf(FWARNING, "[yee-%s] delta_file = %p, updated_full_file = %p, full_fd = %d\n", who_am_i(), delta_file, updated_full_file, full_fd);
+		do_unlink(fwd_delta);
 		return -1;
 	}
 
-	char line[1024*100];																	// delta行读取缓冲区
-	int delta_block_length = -1, delta_block_count = -1, delta_remainder_block_length = -1; // delta文件元数据 块大小 块数量 剩余块大小
-	OFF_T total_size = -1, content_size = -1;	// delta文件元数据 偏移量 总大小 内容大小
+	rprintf(FWARNING, "[yee-%s] rebase backup version: %s -> %s\n", who_am_i(), prev.path, reverse_delta_path);
 
-	// delta 文件元数据解析
-	if(fgets(line, sizeof(line), delta_file) != NULL)	
-	{
-		sscanf(line, "[delta file metadata] file_size = %ld, content_size = %ld, block_size = %d, block_count = %d, remainder_block = %d\n", 
-			&total_size, &content_size, &delta_block_length, &delta_block_count, &delta_remainder_block_length);
-	}	
-	else
+	// 失败时保留旧的全量版本, 恢复仍然可用
+	if(delta_invert(fwd_delta, prev.path, reverse_delta_path) < 0)
 	{
-		rprintf(FWARNING, "[yee-%s] sender.c: make_d2f fgets delta metadata error\n", who_am_i());
+		rprintf(FWARNING, "[yee-%s] receiver.c: update_reverse_backup invert %s failed\n", who_am_i(), fwd_delta);
+		do_unlink(fwd_delta);
+		return -1;
 	}
+	do_unlink(fwd_delta);
 
-	int32 read_size = MAX(delta_block_length*2, 16*1024);
-	struct map_struct *mapbuf = map_file(full_fd, content_size, read_size, delta_block_length);	// 构建map_struct 以供map_ptr使用
-	// delta 增量信息解析
-	while (fgets(line, sizeof(line), delta_file) != NULL)
-	{ 
-		int token = -1;
-		OFF_T offset = -1, offset2 = -1;
+	manifest_add(m, BACKUP_MODE_REVERSE, BACKUP_KIND_DELTA, prev.version, prev.size, prev.csum_type, prev.digest, 0, 0);
+	manifest_remove(m, BACKUP_MODE_REVERSE, BACKUP_KIND_FULL, prev.version);
 
-		if(strcmp(line, "\n") == 0 || strcmp(line, "\r\n") == 0)
-		{
-			continue;
-		}
-		else if(strncmp(line, "match token\0", strlen("match token\0")) == 0)	// 解析delta文件中匹配的部分 token
-		{
-			char *map_data = NULL;
-			size_t map_len = -1;
-			sscanf(line, "match token = %d, offset = %ld, offset2 = %ld\n", &token, &offset, &offset2);
-			
-			map_len = delta_block_length;
-			if( token == delta_block_count - 1 && delta_remainder_block_length != 0)
-			{
-				map_len = delta_remainder_block_length;
-			}
-						
-			map_data = map_ptr(mapbuf, offset2, map_len);	// 使用offset2
+	return 0;
+}
+
+// 代价检查点: 恢复时要重放自上一个全量版本以来的delta(差量备份只有本次的一个),
+// 其字面量字节数加上按CHECKPOINT_OP_COST折算的操作数超过文件大小的checkpoint_ratio%时,
+// 本次改写为全量版本, 使任一版本的恢复代价有上界
+static int need_full_checkpoint(struct backup_manifest *m, OFF_T file_size)
+{
+	struct backup_version *full, *delta;
+	int64 literal = delta_literal_bytes, ops = delta_op_count;
+	int full_num, delta_num, i;
+
+	if(checkpoint_ratio <= 0 || backup_type == BACKUP_MODE_REVERSE)	// 反向增量的最新版本总是全量
+		return 0;
 
-			if( map_data != NULL && fwrite(map_data, 1, map_len, updated_full_file) != map_len )
+	full_num = manifest_range(m, backup_type, BACKUP_KIND_FULL, &full);
+	if(backup_type == BACKUP_MODE_INCREMENTAL && full_num > 0)
+	{
+		delta_num = manifest_range(m, backup_type, BACKUP_KIND_DELTA, &delta);
+		for(i = 0; i < delta_num; i++)
+		{
+			if(delta[i].id > full[full_num - 1].id
+			 && strcmp(delta[i].version, backup_version) != 0)	// 同一版本号重复备份时旧delta会被替换
 			{
-				rprintf(FWARNING, "[yee-%s] sender.c: make_d2f fwrite match data error\n", who_am_i());
+				literal += delta[i].literal;
+				ops += delta[i].ops;
 			}
 		}
-		else if(strncmp(line, "unmatch data length\0", strlen("unmatch data length\0")) == 0) // 解析delta文件中不匹配的部分
-		{
+	}
 
-			char unmatch_data[1024*1000];	// 不匹配数据缓冲区
-			size_t unmatch_len = 0;			// 读取长度
-			sscanf(line, "unmatch data length = %ld, offset = %ld\n", &unmatch_len, &offset);
+	return (literal + ops * CHECKPOINT_OP_COST) * 100 > (int64)file_size * checkpoint_ratio;
+}
 
-			if( fread(unmatch_data, 1, unmatch_len, delta_file) != unmatch_len )
-			{
-				rprintf(FWARNING, "[yee-%s] sender.c: make_d2f fread unmatch data length error\n", who_am_i());
-			}
+// 写入全量检查点并丢弃本次的delta. 增量备份的delta以上一版本为基准, 接收到的文件就是新版本,
+// 由recv_files照常拷贝; 差量备份的delta以最新全量版本为基准, 需把delta应用到该全量版本上
+static int write_full_checkpoint(struct backup_manifest *m, const char *full_path, OFF_T size)
+{
+	struct backup_version *full;
 
-			if( fwrite(unmatch_data, 1, unmatch_len, updated_full_file) != unmatch_len ) // 直接将不匹配数据写入
-			{
-				rprintf(FWARNING, "[yee-%s] sender.c: make_d2f fwrite unmatch data length error\n", who_am_i());
-			}
-		}
-		else
+	if(backup_type == BACKUP_MODE_DIFFERENTIAL)
+	{
+		if((full = manifest_newest(m, backup_type, BACKUP_KIND_FULL)) == NULL)
+			return -1;
+		if(write_full_version(full->path, delta_backup_fname, full_path) < 0)
 		{
-			rprintf(FWARNING, "[yee-%s] sender.c: make_d2f line: %s is illegal\n", who_am_i(), line);
+			rprintf(FWARNING, "[yee-%s] receiver.c: write_full_checkpoint apply %s failed\n", who_am_i(), delta_backup_fname);
+			do_unlink(full_path);
+			return -1;
 		}
+		manifest_add(m, backup_type, BACKUP_KIND_FULL, backup_version, size,
+			     canonical_checksum(xfersum_type) ? xfersum_type : -1, sender_file_sum, 0, 0);
+		sig_sidecar_write(full_path);	// 之后的差量备份直接读取块签名, 不再重读全量文件
 	}
-	fclose(delta_file);
-	fclose(updated_full_file);
-	close(full_fd);
+	do_unlink(delta_backup_fname);
 
 	return 0;
 }
 
-/**管理备份版本 
- * 函数的参数：backup_path 指定到对应类型的备份路径[dir_name/file.backup/incremental(differential)/]
- * 所使用的全局变量： backup_type, backup_version_num
- * */ 
-int manage_backup_version(const char* backup_path)
+// 管理备份版本数目, 超过backup_version_num时删除最旧的版本
+int manage_backup_version(struct backup_manifest *m)
 {
-	char backup_full_path[MAXPATHLEN];
-	char backup_delta_path[MAXPATHLEN];
-
-	strcpy(backup_full_path, backup_path);
-	strlcat(backup_full_path, "full/", MAXPATHLEN);
-
-	strcpy(backup_delta_path, backup_path);
-	strlcat(backup_delta_path, "delta/", MAXPATHLEN);
-
-	backup_files_list *backup_files_list_full = (backup_files_list*)malloc(sizeof(backup_files_list));
-	backup_files_list *backup_files_list_delta = (backup_files_list*)malloc(sizeof(backup_files_list));
+	struct backup_version *full, *delta;
+	int64 full_id_1 = -1;
+	char full_version[BACKUP_VERSION_LEN], delta_version[BACKUP_VERSION_LEN];
+	int full_num = manifest_range(m, backup_type, BACKUP_KIND_FULL, &full);
+	int delta_num = manifest_range(m, backup_type, BACKUP_KIND_DELTA, &delta);
 
-	// rprintf(FWARNING, "[yee-%s] receiver.c: manage_backup_version backup_full_path = %s, backup_delta_path = %s\n", who_am_i(), backup_full_path, backup_delta_path);
-
-	backup_files_list_full->num = read_sort_dir_files(backup_full_path, backup_files_list_full->file_path);
-	backup_files_list_delta->num = read_sort_dir_files(backup_delta_path, backup_files_list_delta->file_path);
-
-	// rprintf(FWARNING, "[yee-%s] receiver.c: full_num = %d, delta_num = %d\n", who_am_i(), backup_files_list_full->num, backup_files_list_delta->num);
-
-	if(backup_files_list_full->num <= backup_version_num && backup_files_list_delta->num <= backup_version_num)
+	if(full_num <= backup_version_num && delta_num <= backup_version_num)
 	{
 		// 版本数目符合要求，不需要其他操作
 		return 0;
 	}
 
-	if(backup_type == 1) // 管理差量备份文件
+	if(full_num > backup_version_num && backup_type != BACKUP_MODE_REVERSE) 	// 如果全量备份数超过最大值, 删除最旧的全量版本, 以及依赖它的delta版本
 	{
-		int i = 0;
-
-		if(backup_files_list_full->num > backup_version_num) 	// 如果全量备份数超过最大值, 删除最旧的全量版本
-		{
-			char full_timestamp_0[MAXPATHLEN], full_timestamp_1[MAXPATHLEN];
-
-			extract_file_name_timestamp(backup_files_list_full->file_path[0], full_timestamp_0);
-			extract_file_name_timestamp(backup_files_list_full->file_path[1], full_timestamp_1);
+		if(full_num > 1)
+			full_id_1 = full[1].id;
 
-			remove(backup_files_list_full->file_path[0]);
-
-			for( ; i < backup_files_list_delta->num; i++)	// 删除差量备份文件中对应的全量备份文件, i同时计数
-			{
-				char delta_timestamp[MAXPATHLEN];
-				extract_file_name_timestamp(backup_files_list_delta->file_path[i], delta_timestamp);
+		manifest_remove(m, backup_type, BACKUP_KIND_FULL, full[0].version);
 
-				if(strcmp(full_timestamp_1, delta_timestamp) >= 0)
-				{
-					remove(backup_files_list_delta->file_path[i]);
-				}
-				else
-					break;
-			}
-		}
-
-		if(backup_files_list_delta->num - i > backup_version_num)	// 如果差量备份数超过最大值, 删除最旧的差量版本
+		while((delta_num = manifest_range(m, backup_type, BACKUP_KIND_DELTA, &delta)) > 0
+		   && full_id_1 >= delta->id)
 		{
-			remove(backup_files_list_delta->file_path[i]);
+			manifest_remove(m, backup_type, BACKUP_KIND_DELTA, delta->version);
 		}
 	}
-	else if(backup_type == 0)	// 管理增量备份文件
+
+	if(delta_num > backup_version_num)	// 如果delta版本数超过最大值, 删除最旧的delta版本
 	{
-		int i = 0;		// i计数增量备份文件
-		int j = 0;		// j计数全量备份文件
+		strlcpy(delta_version, delta->version, sizeof delta_version);
 
-		if(backup_files_list_full->num > backup_version_num) 	// 如果全量备份数超过最大值, 删除最旧的全量版本, 不涉及拼接操作
+		// 有检查点全量版本时, 最旧的delta可能不依赖最旧的全量版本; 此时最旧的全量版本单独成为一个版本, 先删除它
+		full_num = manifest_range(m, backup_type, BACKUP_KIND_FULL, &full);
+		if(backup_type == BACKUP_MODE_INCREMENTAL && full_num > 1 && full[1].id < delta->id)
 		{
-			char full_timestamp_0[MAXPATHLEN], full_timestamp_1[MAXPATHLEN];
-
-			extract_file_name_timestamp(backup_files_list_full->file_path[0], full_timestamp_0);
-			extract_file_name_timestamp(backup_files_list_full->file_path[1], full_timestamp_1);
-
-			remove(backup_files_list_full->file_path[0]);	// 删除最旧的全量版本
-			j = 1;
-
-			for( ; i < backup_files_list_delta->num; i++)	// 删除增量量备份文件无效的增量备份文件, i同时计数
-			{
-				char delta_timestamp[MAXPATHLEN];
-				extract_file_name_timestamp(backup_files_list_delta->file_path[i], delta_timestamp);
-
-				if(strcmp(full_timestamp_1, delta_timestamp) >= 0)
-				{
-					remove(backup_files_list_delta->file_path[i]);
-				}
-				else
-					break;
-			}
+			manifest_remove(m, backup_type, BACKUP_KIND_FULL, full[0].version);
+			return 0;
 		}
 
-		if((backup_files_list_delta->num) - i > backup_version_num)	// 如果差量备份数超过最大值, 删除最旧的差量版本, 涉及拼接操作
+		if(backup_type == 0 && manifest_range(m, backup_type, BACKUP_KIND_FULL, &full) > 0)	// 增量备份涉及拼接操作
 		{
-			rprintf(FWARNING, "[yee-%s] receiver.c: j = %d, i = %d\n", who_am_i(), j, i);
-			print_backup_files_list(backup_files_list_full);
-			print_backup_files_list(backup_files_list_delta);
-			update_incre_full_backup(backup_files_list_full->file_path[j], backup_files_list_delta->file_path[i]);	// 更新用于比较的上一次全量备份文件
-			remove(backup_files_list_delta->file_path[i]);			// 删除最旧的增量版本
-			remove(backup_files_list_full->file_path[j]);			// 全量版本更新完毕, 删除最旧的全量版本
+			strlcpy(full_version, full->version, sizeof full_version);
+			// 更新用于比较的上一次全量备份文件, 失败时保留整条链
+			if(update_incre_full_backup(m, full, delta) != 0)
+				return -1;
+			manifest_remove(m, backup_type, BACKUP_KIND_FULL, full_version);	// 全量版本更新完毕, 删除最旧的全量版本
 		}
-
+		manifest_remove(m, backup_type, BACKUP_KIND_DELTA, delta_version);		// 删除最旧的delta版本
 	}
 
-	free(backup_files_list_full);
-	free(backup_files_list_delta);
 	return 0;
 }
 
@@ -900,6 +852,9 @@ int recv_files(int f_in, int f_out, char *local_name)
 
 	rprintf(FWARNING, "[yee-%s] receiver.c: recv_files backup_type=%d, backup_version_num=%d\n", who_am_i(), backup_type, backup_version_num);
 
+	if(task_type_backup_or_recovery_receiver == 0)
+		retention_start();
+
 	// The main process of the receive side, which runs on the same host as the generate process
 	int fd1,fd2;
 	STRUCT_STAT st;
@@ -918,7 +873,12 @@ int recv_files(int f_in, int f_out, char *local_name)
 #ifdef SUPPORT_ACLS
 	const char *parent_dirname = "";
 #endif
-	int ndx, recv_ok;
+	int ndx, recv_ok, checkpoint, packed, full_failed;
+	struct backup_manifest manifest;		// 当前文件的备份版本清单
+
+	manifest.vers = NULL;
+	manifest.count = 0;
+	manifest.lock_fp = NULL;
 
 	if (DEBUG_GTE(RECV, 1))
 		rprintf(FINFO, "recv_files(%d) starting\n", cur_flist->used);
@@ -944,6 +904,8 @@ int recv_files(int f_in, int f_out, char *local_name)
 					ndx = first_flist->used + first_flist->ndx_start;
 					gen_wants_ndx(ndx, first_flist->flist_num);
 				}
+				if (task_type_backup_or_recovery_receiver == 0)
+					catalog_add_flist(first_flist);
 				flist_free(first_flist);
 				if (first_flist)
 					continue;
@@ -1133,8 +1095,8 @@ int recv_files(int f_in, int f_out, char *local_name)
 				fnamecmp = fname;
 		}
 
-		first_backup = 1;					// 预设为是第一次备份,搜索文件夹存在同名.full.文件则不是第一次备份
-		char full_backup_name_prefix[MAXPATHLEN];	// xxxx.full.
+		first_backup = 1;					// 预设为是第一次备份,版本清单中已有全量版本则不是第一次备份
+		packed = 0;
 		char full_backup_fpath[MAXPATHLEN];			// ./path/to/xxxx.backup/incremental(differental)/full/									全量备份完整路径
 		char full_backup_fname[MAXPATHLEN];			// ./path/to/xxxx.backup/incremental(differental)/full/xxxx.full.xxxx-xx-xx-xx:xx:xx	全量备份完整文件名
 
@@ -1162,51 +1124,36 @@ int recv_files(int f_in, int f_out, char *local_name)
 				strcpy(file_name, fname);
 			}
 
-			sprintf(full_backup_name_prefix, "%s.full.", file_name);	// xxxx.full.
-
 			// ./path/to/xxxx.backup/incremental(differental)/full/
-			sprintf(full_backup_fpath, "%s/%s.backup/%s/full/", dir_name, file_name, backup_type?"differential":"incremental");
+			sprintf(full_backup_fpath, "%s/%s.backup/%s/full/", dir_name, file_name, backup_mode_name(backup_type));
 
 			// ./path/to/xxxx.backup/incremental(differental)/delta/
-			sprintf(delta_backup_fpath, "%s/%s.backup/%s/delta/", dir_name, file_name, backup_type?"differential":"incremental");
+			sprintf(delta_backup_fpath, "%s/%s.backup/%s/delta/", dir_name, file_name, backup_mode_name(backup_type));
 
-			mkdir_recursive(full_backup_fpath, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
-			mkdir_recursive(delta_backup_fpath,S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+			// 小文件的各版本整体追加到所在目录的打包文件中, 不建立xxxx.backup目录
+			packed = pack_wanted(fname, file_name, F_LENGTH(file));
+			if(!packed)
+			{
+				mkdir_recursive(full_backup_fpath, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+				mkdir_recursive(delta_backup_fpath,S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+			}
 
 			// ./path/to/xxxx.backup/incremental(differential)/full/xxxx.full.xxxx-xx-xx-xx:xx:xx
 			sprintf(full_backup_fname, "%s%s.full.%s", full_backup_fpath, file_name, backup_version);
 
 			// ./path/to/xxxx.backup/incremental(differential)/delta/xxxx.full.xxxx-xx-xx-xx:xx:xx
 			sprintf(delta_backup_fname, "%s%s.delta.%s", delta_backup_fpath, file_name, backup_version);	
+			// 反向增量接收时写下的是正向delta, 改写完上一个全量版本后即删除, 不用.delta.命名以免被当作版本
+			if(backup_type == BACKUP_MODE_REVERSE)
+				sprintf(delta_backup_fname, "%s%s.forward.%s", delta_backup_fpath, file_name, backup_version);
 			
 
-			// rprintf(FWARNING, "[yee-%s] receiver.c: recv_files full_backup_name_prefix: %s, full_backup_fpath:%s\n", 
-			// 		who_am_i(), full_backup_name_prefix, full_backup_fpath);
-
-			int full_prefix_len = strlen(full_backup_name_prefix);
-
-			// rprintf(FWARNING, "[yee-%s] receiver.c: backup_path=%s\n", who_am_i(), backup_path);
-
-			DIR *dir = opendir(full_backup_fpath);
-			if (dir != NULL)
-			{
-				struct dirent *entry;
-				while ((entry = readdir(dir)) != NULL)
-				{
-
-					if(strncmp(entry->d_name, full_backup_name_prefix, full_prefix_len) == 0)
-					{
-						first_backup = 0;
-						break;
-					}
-				}
-				closedir(dir);
-			}
-			else
-			{
-				rprintf(FWARNING, "[yee-%s] opendir failed\n", who_am_i());
-			}
-
+			// 该备份类型下已有全量版本则不是第一次备份; 打包的版本总是整体保存, 不写delta
+			manifest_close(&manifest);
+			if (!packed)
+				manifest_open(&manifest, fname);
+			if (!packed && manifest_newest(&manifest, backup_type, BACKUP_KIND_FULL) != NULL)
+				first_backup = 0;
 		}
 		
 		/* open the file*/
@@ -1403,39 +1350,54 @@ int recv_files(int f_in, int f_out, char *local_name)
 			break;
 		}
 
+		// 备份任务 记录新写入的delta版本(反向增量的正向delta只用于改写上一个全量版本, 不记录)
+		// delta链的重放代价过高时丢弃本次delta, 改为写入全量检查点
+		// 文件未通过校验(将重传)或没能落地时, delta描述的不是fname的实际内容, 丢弃不记录
+		checkpoint = 0;
+		if (task_type_backup_or_recovery_receiver == 0 && first_backup == 0
+		 && backup_type != BACKUP_MODE_REVERSE) {
+			if (recv_ok <= 0)
+				do_unlink(delta_backup_fname);
+			else if (need_full_checkpoint(&manifest, F_LENGTH(file))
+			 && write_full_checkpoint(&manifest, full_backup_fname, F_LENGTH(file)) == 0) {
+				rprintf(FWARNING, "[yee-%s] receiver.c: recv_files %s: %s literal bytes, %s ops since last full, writing a full checkpoint\n",
+					who_am_i(), fname, big_num(delta_literal_bytes), big_num(delta_op_count));
+				checkpoint = backup_type == BACKUP_MODE_INCREMENTAL;	// 增量备份的全量检查点由下面的全量拷贝写入
+				stats.checkpoint_files++;
+				send_msg_int(MSG_CHECKPOINT, ndx);	// generator汇总后随--stats发给客户端
+			} else {
+				manifest_add(&manifest, backup_type, BACKUP_KIND_DELTA, backup_version, F_LENGTH(file),
+					     canonical_checksum(xfersum_type) ? xfersum_type : -1, sender_file_sum,
+					     delta_literal_bytes, delta_op_count);
+			}
+		}
+
 		// rprintf(FWARNING, "[yee-%s] receiver.c: recv_files pre_write_full_file fname = %s, first_backup = %d, whole_file = %d\n", who_am_i(), fname, first_backup, whole_file);
 		// 备份任务 并且是第一次备份 全量文件管理 将最新版本文件写入全量备份文件
-		if(task_type_backup_or_recovery_receiver == 0  && (first_backup == 1 || whole_file == 1) )	
+		// 文件未通过校验或没能落地时fname仍是旧内容, 不写全量版本
+		full_failed = recv_ok <= 0;
+		if(task_type_backup_or_recovery_receiver == 0 && packed)
 		{
-			FILE *full_tmp = fopen(fname,"rb");
-			FILE *full_backup = fopen(full_backup_fname,"wb");
-			
-			if(full_tmp == NULL || full_backup == NULL)
+			if(!full_failed && pack_add(dir_name, file_name, fname, backup_version,
+				    canonical_checksum(xfersum_type) ? xfersum_type : -1, sender_file_sum) < 0)
+				rprintf(FWARNING, "[yee-%s] pack backup of %s failed\n", who_am_i(), fname);
+		}
+		else if(task_type_backup_or_recovery_receiver == 0 && !full_failed
+		 && (first_backup == 1 || whole_file == 1 || checkpoint || backup_type == BACKUP_MODE_REVERSE))
+		{
+			if(write_full_version(fname, NULL, full_backup_fname) < 0)
 			{
-				rprintf(FWARNING, "[yee-%s] open %s or %s failed\n", who_am_i(), fname, full_backup_fname);
+				rprintf(FWARNING, "[yee-%s] write full backup %s failed\n", who_am_i(), full_backup_fname);
+				full_failed = 1;
 			}
 			else
-			{	
-				char buf[1024*100];
-				size_t read_len = 0;
-				size_t buffer_size = sizeof(buf);
-				while((read_len = fread(buf, sizeof(char), buffer_size, full_tmp)) > 0)
-				{
-					// rprintf(FWARNING, "[yee-%s] write_full_files write %ld chars to %s\n", who_am_i(), read_len, full_backup_fname);
-					fwrite(buf, sizeof(char), read_len, full_backup);
-					if(read_len < buffer_size)	// 读到了文件末尾
-					{
-						break;
-					}	
-				}
+			{
+				manifest_add(&manifest, backup_type, BACKUP_KIND_FULL, backup_version, F_LENGTH(file),
+					     canonical_checksum(xfersum_type) ? xfersum_type : -1, sender_file_sum, 0, 0);
+				if(backup_type == BACKUP_MODE_DIFFERENTIAL)
+					sig_sidecar_write(full_backup_fname);	// 差量备份的基准, 写下其块签名
 			}
 
-			fclose(full_tmp);
-			fclose(full_backup);
-
-			full_tmp = NULL;
-			full_backup = NULL;
-
 			// finish_transfer(fname, fnametmp, fnamecmp,partialptr, file, recv_ok, 1);
 			// rprintf(FWARNING, "[yee-%s] first full backup set file attr of %s\n", who_am_i(), full_backup_name);
 			// rprintf(FWARNING, "[yee-%s] first full backup set file attr of %s\n", who_am_i(), full_backup_fpath);
@@ -1457,19 +1419,31 @@ int recv_files(int f_in, int f_out, char *local_name)
 		// 	// 		full_fname(fname), full_backup_name);
 		// 	// }
 		// }
-		if(task_type_backup_or_recovery_receiver == 0)
+		if(task_type_backup_or_recovery_receiver == 0 && !packed)
 		{
-			char manage_backup_path[MAXPATHLEN];
-			sprintf(manage_backup_path, "%s/%s.backup/%s/", dir_name, file_name, backup_type?"differential":"incremental");
-
-			// rprintf(FWARNING, "[yee-%s] receiver.c: recv_files manage_backup_version %s\n", who_am_i(), manage_backup_path);
-			if(manage_backup_version(manage_backup_path) != 0)
-			{
-				rprintf(FWARNING, "[yee-%s] receiver.c: recv_files manage_backup_version %s failed\n", who_am_i(), manage_backup_path);
-			}
+			// 新版本的全量文件没有写入时, 最新的全量版本仍是上一个, 不能用它改写更早的版本; 保留正向delta
+			if(backup_type == BACKUP_MODE_REVERSE && first_backup == 0 && full_failed)
+				rprintf(FWARNING, "[yee-%s] receiver.c: keeping forward delta %s, previous full version not rebased\n",
+					who_am_i(), delta_backup_fname);
+			else if(backup_type == BACKUP_MODE_REVERSE && first_backup == 0)
+				update_reverse_backup(&manifest, delta_backup_fname);
+			retention_queue(fname, &manifest);	// 版本清理交给后台worker, 不阻塞传输
 		}
 	} // 单个文件处理结束
 
+	manifest_close(&manifest);
+	if(task_type_backup_or_recovery_receiver == 0)
+	{
+		struct file_list *flist;
+		pack_flush();
+		retention_finish();
+		for (flist = first_flist; flist; flist = flist->next)
+			catalog_add_flist(flist);
+		catalog_run_end();	// 本次备份的快照追加到模块的目录清单
+		if(stats.checkpoint_files)
+			rprintf(FWARNING, "[yee-%s] receiver.c: recv_files wrote %d full checkpoints instead of deltas\n", who_am_i(), stats.checkpoint_files);
+	}		// 等待worker处理完队列中剩余的版本清理
+
 	if (make_backups < 0)
 		make_backups = -make_backups;
 
@@ -0,0 +1,275 @@
+/*
+ * Retention of versioned backups: pruning old versions and compacting
+ * the incremental chain, away from the transfer when possible.
+ *
+ * manage_backup_version() may rewrite a whole full file, so by default
+ * it runs in a worker process that the receiver feeds over a pipe.  The
+ * pipe is the bounded queue: once it is full the receiver blocks until
+ * the worker catches up, and at the end of the transfer the receiver
+ * waits for the worker to drain it.  A daemon module can instead set
+ * "backup compaction = deferred", which only appends the jobs to its
+ * "compaction queue" file; "rsync --compact_backups=QUEUE" then runs
+ * them outside the backup window (e.g. from cron).
+ *
+ * A job is one line: "TYPE KEEP PATH\n".
+ *
+ * Whoever ran the jobs then lets a module's chunk store (chunkstore.c)
+ * reclaim the space of chunks that the removed versions released.
+ */
+
+#include "rsync.h"
+
+extern int msgs2stderr;
+extern int backup_type;
+extern int backup_version_num;
+
+static int compaction_mode = BACKUP_COMPACTION_BACKGROUND;
+static int queue_fd = -1;		/* deferred: the module's queue file */
+static char queue_root[MAXPATHLEN];	/* deferred: chroot dir, prefixed to paths */
+static int worker_fd = -1;		/* background: write end of the job pipe */
+static pid_t worker_pid = -1;
+
+/* Both sides hold a write lock on the queue file, so a job that a
+ * backup queues while the queue is being run waits instead of being
+ * truncated away.  This only covers the queue: what keeps the backup
+ * and the job from losing each other's MANIFEST records is the lock
+ * that compact_manifest() holds on the file's manifest. */
+static int lock_queue(int fd, int type)
+{
+	struct flock lock;
+
+	lock.l_type = type;
+	lock.l_whence = SEEK_SET;
+	lock.l_start = 0;
+	lock.l_len = 0;
+	lock.l_pid = 0;
+
+	while (fcntl(fd, F_SETLKW, &lock) < 0) {
+		if (errno != EINTR)
+			return -1;
+	}
+	return 0;
+}
+
+static int over_limit(struct backup_manifest *m)
+{
+	struct backup_version *v;
+
+	/* A reverse chain's full files are its newest versions; only its
+	 * deltas expire. */
+	return (backup_type != BACKUP_MODE_REVERSE
+	     && manifest_range(m, backup_type, BACKUP_KIND_FULL, &v) > backup_version_num)
+	    || manifest_range(m, backup_type, BACKUP_KIND_DELTA, &v) > backup_version_num;
+}
+
+/* Prune fname's versions down to the limit.  A deferred job can be
+ * several backups behind, so keep going until nothing is over. */
+static int compact_manifest(struct backup_manifest *m)
+{
+	char fname[MAXPATHLEN];
+	int len, ret = 0;
+
+	if (!over_limit(m))
+		return 0;
+	/* Hold the manifest for the whole job, so a backup of the file that
+	 * runs meanwhile waits to record its version instead of losing it
+	 * to the pruned manifest that gets written. */
+	if (manifest_lock(m) < 0)
+		return -1;
+	while (over_limit(m)) {
+		if (manage_backup_version(m) != 0) {
+			rprintf(FWARNING, "[yee-%s] retention.c: manage_backup_version %s failed\n", who_am_i(), m->backup_dir);
+			ret = -1;
+			break;
+		}
+	}
+	manifest_unlock(m);
+
+	// 版本链已改变, 版本缓存中该文件的副本作废
+	len = strlcpy(fname, m->backup_dir, sizeof fname);
+	if (len > 7 && len < (int)sizeof fname && strcmp(fname + len - 7, ".backup") == 0) {
+		fname[len - 7] = '\0';
+		version_cache_invalidate(fname);
+	}
+
+	return ret;
+}
+
+static int run_job(char *line)
+{
+	struct backup_manifest m;
+	int type, keep, len, ret;
+	char *path;
+
+	if ((len = strlen(line)) > 0 && line[len-1] == '\n')
+		line[--len] = '\0';
+	if (sscanf(line, "%d %d", &type, &keep) != 2
+	 || !(path = strchr(line, ' ')) || !(path = strchr(path + 1, ' '))) {
+		rprintf(FERROR, "[yee-%s] retention.c: bad job \"%s\"\n", who_am_i(), line);
+		return -1;
+	}
+	path++;
+
+	backup_type = type;
+	backup_version_num = keep;
+	m.vers = NULL;
+	m.count = 0;
+	manifest_open(&m, path);
+	ret = compact_manifest(&m);
+	manifest_close(&m);
+
+	return ret;
+}
+
+static NORETURN void worker_main(int fd)
+{
+	char line[MAXPATHLEN + 64];
+	FILE *in;
+
+	/* Our messages must not interleave with the receiver's multiplexed
+	 * stream, so send them to stderr or the daemon log instead. */
+	msgs2stderr = 1;
+
+	if (!(in = fdopen(fd, "r")))
+		_exit(RERR_IPC);
+	while (fgets(line, sizeof line, in))
+		run_job(line);
+	fclose(in);
+	chunk_store_reclaim();
+
+	_exit(0);
+}
+
+/* Called by a daemon before any chroot so that the queue file can live
+ * outside the module. */
+void retention_daemon_setup(int i, const char *chroot_dir)
+{
+	const char *queue;
+
+	if ((compaction_mode = lp_backup_compaction(i)) != BACKUP_COMPACTION_DEFERRED)
+		return;
+
+	if (!(queue = lp_compaction_queue(i)) || !*queue) {
+		rprintf(FLOG, "module %s: deferred compaction needs a \"compaction queue\", running it in the background\n",
+			lp_name(i));
+		compaction_mode = BACKUP_COMPACTION_BACKGROUND;
+		return;
+	}
+	if ((queue_fd = open(queue, O_WRONLY|O_CREAT|O_APPEND, 0600)) < 0) {
+		rsyserr(FLOG, errno, "open compaction queue %s", queue);
+		compaction_mode = BACKUP_COMPACTION_BACKGROUND;
+		return;
+	}
+	strlcpy(queue_root, chroot_dir ? chroot_dir : "", sizeof queue_root);
+}
+
+/* Called by the receiver before the first file of a backup. */
+void retention_start(void)
+{
+	int fds[2];
+
+	if (compaction_mode != BACKUP_COMPACTION_BACKGROUND)
+		return;
+
+	if (pipe(fds) < 0 || (worker_pid = do_fork()) < 0) {
+		rsyserr(FWARNING, errno, "retention worker");
+		compaction_mode = BACKUP_COMPACTION_INLINE;
+		return;
+	}
+	if (worker_pid == 0) {
+		close(fds[1]);
+		worker_main(fds[0]);
+	}
+	close(fds[0]);
+	worker_fd = fds[1];
+}
+
+/* Hand fname's retention off after its new version was recorded in m. */
+void retention_queue(const char *fname, struct backup_manifest *m)
+{
+	char line[MAXPATHLEN * 2 + 64], cwd[MAXPATHLEN];
+	int len;
+
+	switch (compaction_mode) {
+	case BACKUP_COMPACTION_INLINE:
+		compact_manifest(m);
+		return;
+	case BACKUP_COMPACTION_BACKGROUND:
+		len = snprintf(line, sizeof line, "%d %d %s\n", backup_type, backup_version_num, fname);
+		if (len >= (int)sizeof line || write(worker_fd, line, len) != len) {
+			rsyserr(FWARNING, errno, "queue retention of %s", full_fname(fname));
+			compact_manifest(m);
+		}
+		return;
+	case BACKUP_COMPACTION_DEFERRED:
+		if (!getcwd(cwd, sizeof cwd))
+			*cwd = '\0';
+		len = snprintf(line, sizeof line, "%d %d %s%s/%s\n", backup_type, backup_version_num,
+			       queue_root, strcmp(cwd, "/") == 0 ? "" : cwd, fname);
+		if (len >= (int)sizeof line || lock_queue(queue_fd, F_WRLCK) < 0
+		 || write(queue_fd, line, len) != len) {
+			rsyserr(FWARNING, errno, "queue retention of %s", full_fname(fname));
+			compact_manifest(m);
+		}
+		lock_queue(queue_fd, F_UNLCK);
+		return;
+	}
+}
+
+/* Called by the receiver after the last file; waits for the worker to
+ * drain whatever is still queued. */
+void retention_finish(void)
+{
+	int status;
+
+	if (worker_fd >= 0) {
+		close(worker_fd);
+		worker_fd = -1;
+		if (waitpid(worker_pid, &status, 0) == worker_pid
+		 && (!WIFEXITED(status) || WEXITSTATUS(status) != 0))
+			rprintf(FWARNING, "[yee-%s] retention.c: retention worker failed\n", who_am_i());
+		worker_pid = -1;
+	}
+	if (queue_fd >= 0) {
+		close(queue_fd);
+		queue_fd = -1;
+	}
+	if (compaction_mode == BACKUP_COMPACTION_INLINE)
+		chunk_store_reclaim();
+}
+
+/* --compact_backups=QUEUE: run and then empty a deferred queue. */
+int retention_run_queue(const char *queue)
+{
+	char line[MAXPATHLEN * 2 + 64];
+	int fd, failed = 0;
+	FILE *in;
+
+	if ((fd = open(queue, O_RDWR)) < 0) {
+		if (errno == ENOENT)
+			return 0;
+		rsyserr(FERROR, errno, "open %s", queue);
+		return RERR_FILEIO;
+	}
+	if (lock_queue(fd, F_WRLCK) < 0) {
+		rsyserr(FERROR, errno, "lock %s", queue);
+		close(fd);
+		return RERR_FILEIO;
+	}
+	if (!(in = fdopen(fd, "r"))) {
+		close(fd);
+		return RERR_FILEIO;
+	}
+
+	while (fgets(line, sizeof line, in)) {
+		if (run_job(line) != 0)
+			failed = 1;
+	}
+
+	if (do_ftruncate(fd, 0) < 0)
+		rsyserr(FERROR, errno, "truncate %s", queue);
+	fclose(in);
+	chunk_store_reclaim();
+
+	return failed ? RERR_PARTIAL : 0;
+}
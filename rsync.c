@@ -330,6 +330,10 @@ int read_ndx_and_attrs(int f_in, int f_out, int *iflag_ptr, uchar *type_ptr,
 				write_del_stats(f_out);
 			continue;
 		}
+		if (ndx == NDX_CHECKPOINT_STATS) {
+			read_checkpoint_stats(f_in);
+			continue;
+		}
 		if (!inc_recurse || am_sender) {
 			int last;
 			if (first_flist)
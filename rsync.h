@@ -43,6 +43,13 @@
    incompatible with older versions :-( */
 #define CHAR_OFFSET 0
 
+/* get_checksum1() hands whole blocks to a vector loop (see simdsum.c) on
+   x86 when the compiler can target SSE2/SSSE3/AVX2 per function. */
+#if (defined __x86_64__ || defined __i386__) && !defined NO_SIMD_CHECKSUM \
+ && (defined __clang__ || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define SIMD_CHECKSUM 1
+#endif
+
 /* These flags are only used during the flist transfer. */
 
 #define XMIT_TOP_DIR (1<<0)
@@ -248,11 +255,13 @@ enum msgcode {
 	MSG_SUCCESS=100,/* successfully updated indicated flist index */
 	MSG_DELETED=101,/* successfully deleted a file on receiving side */
 	MSG_NO_SEND=102,/* sender failed to open a file we wanted */
+	MSG_CHECKPOINT=103,/* a full checkpoint was written for indicated flist index (siblings) */
 };
 
 #define NDX_DONE -1
 #define NDX_FLIST_EOF -2
 #define NDX_DEL_STATS -3
+#define NDX_CHECKPOINT_STATS -4
 #define NDX_FLIST_OFFSET -101
 
 /* For calling delete_item() and delete_dir_contents(). */
@@ -866,6 +875,7 @@ struct map_struct {
 	int32 def_window_size;	/* Default window size			*/
 	int fd;			/* File Descriptor			*/
 	int status;		/* first errno from read errors		*/
+	struct delta_chain *chain; /* read this instead of fd if set	*/
 };
 
 #define NAME_IS_FILE		(0)    /* filter name as a file */
@@ -906,6 +916,97 @@ typedef struct backup_files_list
 	char* file_path[MAXBACKUPNUM];
 	int num;
 } backup_files_list;
+
+/* Delta files in <file>.backup/ (see delta.c). */
+#define DELTA_FORMAT_TEXT	0	/* legacy "[delta file metadata]" lines */
+#define DELTA_FORMAT_BINARY	1
+#define DELTA_FORMAT_VERSION	1	/* written into binary headers */
+#define DELTA_FLAG_INDEXED	0x01	/* an offset index follows the END op */
+
+#define DELTA_OP_COPY		1	/* bytes taken from the basis file */
+#define DELTA_OP_LITERAL	2	/* bytes stored in the delta itself */
+
+struct delta_header {
+	OFF_T file_size;	/* length of the version it produces */
+	OFF_T content_size;	/* length of the basis it was made from */
+	int32 block_size;
+	int32 block_count;
+	int32 remainder;
+	int format;		/* DELTA_FORMAT_* */
+};
+
+struct delta_op {
+	int type;		/* DELTA_OP_COPY or DELTA_OP_LITERAL */
+	OFF_T offset;		/* COPY: basis offset; LITERAL: data offset in delta */
+	OFF_T len;
+};
+
+struct delta_file {
+	FILE *fp;
+	struct zframe_file *zf;	/* set when the file is compressed */
+	OFF_T zpos;		/* read position in zf's data */
+	struct delta_header hdr;
+	OFF_T literal_left;	/* unread data of the current LITERAL */
+	OFF_T copy_offset;	/* COPY being extended by delta_write_copy() */
+	OFF_T copy_len;
+	char *lit_buf;		/* LITERAL being gathered by delta_write_literal() */
+	int32 lit_len;
+	OFF_T literal_bytes;	/* LITERAL data written or read so far */
+	int64 op_count;		/* ops written or read so far */
+	OFF_T out_pos;		/* version bytes the ops so far describe */
+	OFF_T ops_start;	/* where the first op is */
+	int flags;		/* DELTA_FLAG_* from the header */
+	struct delta_index_entry *index; /* see seek_op() in delta.c */
+	int32 index_count, index_malloced;
+	int index_loaded;
+	int writing;
+};
+
+/* A version described as extents of its basis and of the literal data
+ * in a chain of deltas, see delta_chain_open(). */
+struct delta_extent {
+	OFF_T pos;		/* where the extent starts in the version */
+	OFF_T len;
+	OFF_T offset;		/* where its data starts in the source */
+	int src;		/* 0 for the basis, n for the nth delta */
+};
+
+/* A full version kept in the module's chunk store (see chunkstore.c). */
+#define CHUNK_DIGEST_LEN 16
+struct chunk_list {
+	OFF_T size;
+	int count;
+	struct chunk_ref *refs;
+};
+
+struct delta_chain {
+	struct delta_extent *ext;	/* sorted by pos, covering [0, size) */
+	int count, malloced;
+	OFF_T size;
+	int *fds;		/* basis and delta files, indexed by src */
+	int nsrc;
+	struct chunk_list *list; /* the basis, when it is a chunk list */
+	struct zframe_file **zfs; /* sources stored compressed, by src */
+	struct delta_file **dfs; /* deltas of a chain from delta_chain_open_lazy() */
+	OFF_T base;		/* where a lazy chain's view starts in its version */
+};
+
+/* A backup file stored as compressed frames (see zframe.c). */
+#define ZFRAME_DEFAULT_LEVEL 6
+struct zframe_file {
+	int fd;
+	int writing;
+	OFF_T size;		/* uncompressed length */
+	int32 frame_size;
+	int32 count, malloced;
+	struct zframe_entry *index;
+	char *frame;		/* uncompressed data of frame cur, or pending */
+	int32 frame_len;
+	int32 cur;		/* frame held in frame, -1 for none */
+	char *zbuf;
+	void *zs;		/* the z_stream */
+	OFF_T pos;		/* where the next frame is written */
+};
 typedef struct filter_struct {
 	struct filter_struct *next;
 	char *pattern;
@@ -936,6 +1037,7 @@ struct stats {
 	int created_files, created_dirs, created_symlinks, created_devices, created_specials;
 	int deleted_files, deleted_dirs, deleted_symlinks, deleted_devices, deleted_specials;
 	int xferred_files;
+	int checkpoint_files;	/* full backups written instead of a delta */
 };
 
 struct chmod_mode_struct;
@@ -1029,6 +1131,63 @@ typedef struct {
 #define ACL_READY(sx) ((sx).acc_acl != NULL)
 #define XATTR_READY(sx) ((sx).xattr != NULL)
 
+/* The versions kept in <file>.backup/ are listed in its MANIFEST file
+ * (see manifest.c), so finding them doesn't need a directory scan. */
+#define BACKUP_MODE_INCREMENTAL	0	/* same values as --backup_type */
+#define BACKUP_MODE_DIFFERENTIAL 1
+#define BACKUP_MODE_REVERSE	2	/* newest version full, older ones reverse deltas */
+#define BACKUP_MODE_COUNT	3
+#define BACKUP_KIND_FULL	0
+#define BACKUP_KIND_DELTA	1
+#define BACKUP_VERSION_LEN	32
+
+/* Where retention runs (see retention.c, "backup compaction" in rsyncd.conf). */
+#define BACKUP_COMPACTION_INLINE	0
+#define BACKUP_COMPACTION_BACKGROUND	1
+#define BACKUP_COMPACTION_DEFERRED	2
+
+/* Bytes of literal data one delta op is weighed as when deciding whether
+ * to write a full checkpoint ("checkpoint ratio" in rsyncd.conf). */
+#define CHECKPOINT_OP_COST	512
+
+struct backup_version {
+	char version[BACKUP_VERSION_LEN]; /* yyyy-mm-dd-HH:MM:SS */
+	int64 id;		/* version as seconds since the epoch, -1 if it isn't one */
+	char *path;		/* where this version's full or delta file is */
+	OFF_T size;		/* length of the file at this version */
+	uchar mode;		/* BACKUP_MODE_* */
+	uchar kind;		/* BACKUP_KIND_* */
+	short csum_type;	/* CSUM_* of digest, -1 if none was recorded */
+	char digest[MAX_DIGEST_LEN];
+	OFF_T literal;		/* delta: bytes of literal data in it */
+	int64 ops;		/* delta: number of ops in it */
+};
+
+struct backup_manifest {
+	char backup_dir[MAXPATHLEN];	/* ./path/to/xxxx.backup */
+	char name[MAXNAMLEN];		/* xxxx */
+	struct backup_version *vers;	/* sorted by mode, kind, version id */
+	int count, malloced;
+	int dead;			/* removal records since last rewrite */
+	FILE *lock_fp;			/* MANIFEST while manifest_lock() holds it */
+};
+
+/* A file or directory of a module's snapshot catalog (see catalog.c). */
+struct catalog_entry {
+	char *path;		/* relative to the module, "" for its top */
+	int64 id;		/* version id of a file, 0 for a directory */
+	OFF_T size;		/* length of that version */
+	time_t mtime;
+	uint32 mode;
+	short csum_type;	/* CSUM_* of digest, -1 if none was recorded */
+	char digest[MAX_DIGEST_LEN];
+	int32 next;		/* next entry with the same name_key(), -1 for none */
+	char gone;		/* removed; 2 if by this run */
+	char seen;		/* in this run's file list */
+};
+
+struct sig_sidecar;		/* see sigfile.c */
+
 #include "proto.h"
 
 #ifndef SUPPORT_XATTRS
@@ -51,9 +51,13 @@ extern struct file_list *cur_flist, *first_flist, *dir_flist;
 extern int source_is_remote_or_local;  // 0: local, 1: remote 相较于client客户端而言
 int task_type_backup_or_recovery_sender = -1; // 0: backup, 1: recovery
 extern char *recovery_version;
+extern char *recovery_range;
+extern OFF_T recovery_range_offset, recovery_range_len;
 
 extern int backup_type;
 extern int backup_version_num;
+extern int checksum_type;
+extern int flist_csum_len;
 
 int recovery_type = -1;	// 0 使用增量备份文件, 1 使用差量备份文件
 
@@ -197,428 +201,6 @@ static void write_ndx_and_attrs(int f_out, int ndx, int iflags,
 #endif
 }
 
-int compare_delta_file_name(const void *a, const void *b)
-{
-	return strcmp(*(char **)a, *(char **)b);
-}
-
-void extract_file_name_timestamp(const char *file_name, char *timestamp)
-{
-	char *timestamp_start = strrchr(file_name, '.');	// xxxx.full(delta).xxxx-xx-xx-xx:xx:xx
-
-	if (timestamp_start != NULL ) {
-		// rprintf(FWARNING, "[yee-%s] sender.c: extract_file_name_timestamp {%s} time = {%s}\n", who_am_i(), file_name, timestamp_start+1);
-		strcpy(timestamp, timestamp_start+1);
-	}
-	else 
-	{
-		rprintf(FWARNING, "[yee-%s] sender.c: extract_file_name_timestamp fname{%s} is illegal\n", who_am_i(), file_name);
-	}
-}
-
-// TODO: 已将xxxx_fname全换成了xxxx_fpath 需要删除冗余的代码
-int make_delta_to_full(const char* fname, const char* recovery_timestamp)
-{
-	char cwd[MAXPATHLEN];
-
-	rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full fname: %s time: %s\n", who_am_i(), fname, recovery_timestamp);
-
-	if (getcwd(cwd, sizeof(cwd)) != NULL) {
-		rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full current working directory: %s\n", who_am_i(), cwd);
-	} else {
-		rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full getcwd() error\n", who_am_i());
-	}
-
-	// fname可能是子目录下的文件 需要分割出目录名和文件名
-	char *ptr = strrchr(fname, '/');
-	char dir_name[MAXPATHLEN];
-	char file_name[MAXNAMLEN];
-
-	if(ptr != NULL)
-	{
-		strncpy(dir_name, fname, ptr - fname);
-		dir_name[ptr - fname] = '\0';
-		strcpy(file_name, ptr + 1);
-	}
-	else
-	{
-		strcpy(dir_name, ".");
-		strcpy(file_name, fname);
-	}
-
-	rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full dir_name: %s file_name: %s\n", who_am_i(), dir_name, file_name);
-
-	char backup_path[MAXPATHLEN];
-	strcpy(backup_path, dir_name);
-	strcat(backup_path, "/");
-	strcat(backup_path, file_name);
-	strcat(backup_path, ".backup/");
-
-
-	// 打开备份文件路径
-	DIR *dir = opendir(backup_path);
-	if ( dir )
-	{
-		// rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full opendir() success\n", who_am_i());
-		char full_fname[MAXPATHLEN];
-		char full_fpath[MAXPATHLEN];
-		char full_fname_prefix[MAXPATHLEN];
-		int full_count = 0;
-
-		char delta_fname[100][MAXPATHLEN];
-		char delta_fpath[100][MAXPATHLEN];
-		char delta_fname_prefix[MAXPATHLEN];
-		int delta_count = 0;
-		int delta_count_in_range = 0;
-
-		strcpy(full_fname_prefix, file_name);
-		strcat(full_fname_prefix, ".full.");
-		// rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full full_fname_prefix: %s\n", who_am_i(), full_fname_prefix);
-
-		strcpy(delta_fname_prefix, file_name);
-		strcat(delta_fname_prefix, ".delta.");
-		// rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full delta_fname_prefix: %s\n", who_am_i(), delta_fname_prefix);
-
-		// 在当前路径下 找到对应的full_file_name文件和delta文件
-		struct dirent *ent;
-		while((ent = readdir(dir)) != NULL)
-		{
-			// rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full ent->d_name: %s\n", who_am_i(), ent->d_name);
-			if(strncmp(ent->d_name, full_fname_prefix, strlen(full_fname_prefix)) == 0)
-			{
-
-				if(full_count == 0)	// 未找到full文件
-				{
-					strcpy(full_fname, ent->d_name);
-					
-					strcpy(full_fpath, dir_name);
-					strcat(full_fpath, "/");
-					strcat(full_fpath, file_name);
-					strcat(full_fpath, ".backup/");
-					strcat(full_fpath, full_fname);
-
-					full_count = 1;
-				}
-				else if(full_count == 1 )
-				{
-					char time_old[512], time_new[512];
-					extract_file_name_timestamp(full_fname, time_old);
-					extract_file_name_timestamp(ent->d_name, time_new);
-					if( strncmp(time_old, time_new, strlen(time_old)) < 0 )	// 找到最新的full文件
-					{
-						strcpy(full_fname, ent->d_name);
-						
-						strcpy(full_fpath, dir_name);
-						strcat(full_fpath, "/");
-						strcat(full_fpath, file_name);
-						strcat(full_fpath, ".backup/");
-						strcat(full_fpath, full_fname);
-					}
-				}
-
-			}
-			else if(strncmp(ent->d_name, delta_fname_prefix, strlen(delta_fname_prefix)) == 0)
-			{
-				// rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full delta_fname[%d]: %s\n", who_am_i(), delta_count, ent->d_name);
-				strcpy(delta_fname[delta_count], ent->d_name);
-
-				strcpy(delta_fpath[delta_count], dir_name);
-				strcat(delta_fpath[delta_count], "/");
-				strcat(delta_fpath[delta_count], file_name);
-				strcat(delta_fpath[delta_count], ".backup/");
-
-				strcat(delta_fpath[delta_count], delta_fname[delta_count]);
-
-				delta_count++;
-			}
-		}
-
-		rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full full_count: %d full_fname: %s\n", who_am_i(), full_count, full_fname);
-		// rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full delta_count: %d\n", who_am_i(), delta_count);
-		
-		if(full_count == 0)
-		{
-			rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full hasn't find [%s]'s full backup\n", who_am_i(), fname);
-
-			return 0;
-		}
-
-		if(delta_count == 0)
-		{
-			char recovery_fname[MAXPATHLEN], recovery_fpath[MAXPATHLEN];
-			strcpy(recovery_fname, file_name);
-			strcat(recovery_fname, ".recovery.tmp1");
-
-			strcpy(recovery_fpath, dir_name);
-			strcat(recovery_fpath, "/");
-			strcat(recovery_fpath, file_name);
-			strcat(recovery_fpath, ".backup/");
-			strcat(recovery_fpath, recovery_fname);
-
-			// rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full delta_count = 0, copy full_fname: %s to recovery_fname: %s\n", who_am_i(), full_fpath, recovery_fpath);
-			
-			if(copy_file(full_fpath, recovery_fpath, -1, 0666) != 0)
-			{
-				rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full delta_count is 0 copy_full_file error\n", who_am_i());
-			}
-			
-			return 0;
-		}
-
-		char full_file_timestamp[100];
-		extract_file_name_timestamp(full_fname, full_file_timestamp);
-		// rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full full_file_timestamp: %s\n", who_am_i(), full_file_timestamp);
-
-		// 按照文件名的时间时间戳，找到所需要的delta文件
-		char delta_file_timestamp[100];
-		const char* delta_name_ptrs[100];
-		const char* delta_path_ptrs[100];
-		for (int i = 0; i < delta_count; i++) {
-			extract_file_name_timestamp(delta_fname[i], delta_file_timestamp);
-			// rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full {%s} time = {%s}\n", who_am_i(), delta_fname[i], delta_file_timestamp);
-			if( strcmp(delta_file_timestamp, full_file_timestamp) > 0 && strcmp(delta_file_timestamp, recovery_timestamp) <= 0 )
-			{
-				// rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full delta_fname[%d]: %s is in the range, timestamp: %s\n", who_am_i(), i, delta_fname[i], delta_file_timestamp);
-				delta_name_ptrs[delta_count_in_range] = delta_fname[i];
-				delta_path_ptrs[delta_count_in_range] = delta_fpath[i];
-				delta_count_in_range++;
-
-			}
-			// else
-			// {
-			// 	rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full delta_fname[%d]: %s is not in the range\n", who_am_i(), i, delta_fname[i]);
-			// }
-		}
-
-		rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full delta_count_in_range = %d\n", who_am_i(), delta_count_in_range);
-		qsort(delta_name_ptrs, delta_count_in_range, sizeof(const char*), compare_delta_file_name);
-		qsort(delta_path_ptrs, delta_count_in_range, sizeof(const char*), compare_delta_file_name);
-
-		// for(int i = 0; i < delta_count_in_range; i++)
-		// {
-		// 	rprintf(FWARNING, "[yee-%s] sneder.c: make_d2f delta_name_ptrs[%d]: %s\n", who_am_i(), i, delta_name_ptrs[i]);
-		// }
-
-		char recovery_fname[MAXPATHLEN], tmp_file_name[MAXPATHLEN];
-		char recovery_fpath[MAXPATHLEN], tmp_file_path[MAXPATHLEN];
-		
-		strcpy(recovery_fname, file_name);
-		strcat(recovery_fname, ".recovery.tmp1");
-		
-		strcpy(recovery_fpath, dir_name);
-		strcat(recovery_fpath, "/");
-		strcat(recovery_fpath, file_name);
-		strcat(recovery_fpath, ".backup/");
-		strcat(recovery_fpath, recovery_fname);
-		
-		strcpy(tmp_file_name, file_name);
-		strcat(tmp_file_name, ".recovery.tmp2");
-		
-		strcpy(tmp_file_path, dir_name);
-		strcat(tmp_file_path, "/");
-		strcat(tmp_file_path, file_name);
-		strcat(tmp_file_path, ".backup/");
-		strcat(tmp_file_path, tmp_file_name);
-
-		FILE *full_file = fopen(full_fpath, "rb");	// 打开全量文件 拼接的基准文件
-		FILE *delta_file = NULL;	// 打开增量文件 记录了所拼接的信息
-		FILE *recovery_file = fopen(recovery_fpath, "wb");	// 打开恢复文件 也用作拼接临时写入文件
-
-		
-
-		for(int i = 0; i < delta_count_in_range; i++ ) // 需要做delta_count_in_range次拼接
-		{
-			// rprintf(FWARNING, "[yee-%s] sender.c: make_d2f start make delta_fpath[%d]: %s\n", who_am_i(), i, delta_path_ptrs[i]);
-			delta_file = fopen(delta_path_ptrs[i], "rb");
-			if( delta_file == NULL )
-			{
-				rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full delta_file open failed\n", who_am_i());
-				return -1;
-			}
-
-			char line[1024];		// delta行读取缓冲区
-			int delta_block_length = -1, delta_block_count = -1, delta_remainder_block_length = -1; // delta文件元数据 块大小 块数量 剩余块大小
-			OFF_T total_size = -1, content_size = -1;	// delta文件元数据 偏移量 总大小 内容大小
-			
-			struct map_struct *mapbuf = NULL;	// map_struct 快速找到全量文件中匹配的内容
-			int fd_full = do_open(full_fpath, O_RDONLY, 0);	// 以文件描述符的方式打开全量文件
-			if( fd_full < 0 )
-			{
-				rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full full_file %s open failed\n", who_am_i(), full_fpath);
-				return -1;
-			}
-
-
-			// delta 文件元数据解析
-			if(fgets(line, sizeof(line), delta_file) != NULL)	
-			{
-				sscanf(line, "[delta file metadata] file_size = %ld, content_size = %ld, block_size = %d, block_count = %d, remainder_block = %d\n", 
-					&total_size, &content_size, &delta_block_length, &delta_block_count, &delta_remainder_block_length);
-			}	
-			else
-			{
-				rprintf(FWARNING, "[yee-%s] sender.c: make_d2f fgets delta metadata error\n", who_am_i());
-			}
-
-			// 构建map_struct 以供map_ptr使用 参见receiver->receive_data
-			int32 read_size = MAX(delta_block_length*2, 16*1024);
-			mapbuf = map_file(fd_full, content_size, read_size, delta_block_length);	// 构建map_struct 以供map_ptr使用
-
-			// delta 增量信息解析
-			while ( fgets(line, sizeof(line), delta_file) != NULL)
-			{ 
-				int token = -1;
-				OFF_T offset = -1, offset2 = -1;
-
-				// rprintf(FWARNING, "[yee-%s] sender.c: make_d2f line: %s\n", who_am_i(), line);
-				if(strcmp(line, "\n") == 0 || strcmp(line, "\r\n") == 0)
-				{
-					continue;
-				}
-				else if(strncmp(line, "match token\0", strlen("match token\0")) == 0)	// 解析delta文件中匹配的部分 token
-				{
-					char *map_data = NULL;
-					size_t map_len = -1;
-					sscanf(line, "match token = %d, offset = %ld, offset2 = %ld\n", &token, &offset, &offset2);
-					
-					map_len = delta_block_length;
-					if( token == delta_block_count - 1 && delta_remainder_block_length != 0)
-					{
-						map_len = delta_remainder_block_length;
-					}
-					
-					
-					map_data = map_ptr(mapbuf, offset2, map_len);	// 使用offset2
-
-					if( map_data != NULL && fwrite(map_data, 1, map_len, recovery_file) != map_len )
-					{
-						rprintf(FWARNING, "[yee-%s] sender.c: make_d2f fwrite match data error\n", who_am_i());
-					}
-
-					// rprintf(FWARNING, "[yee-%s] sender.c: make_d2f match token = %d, offset = %ld, offset2 = %ld\nmap_data = \n%s\n", 
-					// 		who_am_i(), token, offset, offset2, map_data);
-
-					// rprintf(FWARNING, "[yee-%s] sender.c: make_d2f match token = %d, offset = %ld, offset2 = %ld\n", 
-					// 		who_am_i(), token, offset, offset2);
-				}
-				else if(strncmp(line, "unmatch data length\0", strlen("unmatch data length\0")) == 0) // 解析delta文件中不匹配的部分
-				{
-
-					char unmatch_data[1024*1000];	// 不匹配数据缓冲区
-				  	size_t unmatch_len = 0;			// 读取长度
-					sscanf(line, "unmatch data length = %ld, offset = %ld\n", &unmatch_len, &offset);
-
-					if( fread(unmatch_data, 1, unmatch_len, delta_file) != unmatch_len )
-					{
-						rprintf(FWARNING, "[yee-%s] sender.c: make_d2f fread unmatch data length error\n", who_am_i());
-					}
-
-					// rprintf(FWARNING, "[yee-%s] sender.c: make_d2f unmatch data length = %ld, offset = %ld\nunmatch_data = \n%s\n",
-					// 		 who_am_i(), unmatch_len, offset, unmatch_data);
-
-
-					// rprintf(FWARNING, "[yee-%s] sender.c: make_d2f unmatch data length = %ld, offset = %ld\n",
-					// 		 who_am_i(), unmatch_len, offset);
-
-
-					if( fwrite(unmatch_data, 1, unmatch_len, recovery_file) != unmatch_len ) // 直接将不匹配数据写入
-					{
-						rprintf(FWARNING, "[yee-%s] sender.c: make_d2f fwrite unmatch data length error\n", who_am_i());
-					}
-				}
-				else
-				{
-					rprintf(FWARNING, "[yee-%s] sender.c: make_d2f line: %s is illegal\n", who_am_i(), line);
-				}
-			}
-		
-			fclose(delta_file);
-			fclose(full_file);
-			fclose(recovery_file);
-			close(fd_full);
-			
-			if(i != delta_count_in_range - 1)
-			{
-				
-				// delta_file = fopen(delta_path_ptrs[i+1], "rb");
-
-				copy_file(recovery_fpath, tmp_file_path, -1, 0666);
-				
-				full_file = fopen(tmp_file_path, "rb");
-				recovery_file = fopen(recovery_fpath, "wb");
-
-				strcpy(full_fpath, tmp_file_path);
-			}
-			else
-			{
-				remove(tmp_file_path);
-			}
-		}
-
-	} else {
-		if (errno == ENOENT) {
-            rprintf(FWARNING, "[yee-%s] sender.c:Error: directory %s does not exist\n", who_am_i(), backup_path);
-        } else if (errno == EACCES) {
-            rprintf(FWARNING, "[yee-%s] sender.c:Error: directory %s cannot be accessed\n", who_am_i(), backup_path);
-        } else {
-            rprintf(FWARNING, "[yee-%s] sender.c:Error: failed to open directory %s, errno = %d\n", who_am_i(), backup_path, errno);
-        }
-		rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full opendir() %s error\n", who_am_i(), backup_path);
-        // exit(EXIT_FAILURE); // 退出程序
-	}
-	closedir(dir);
-	return 0;
-}
-
-// 读取path下的所有文件,并按照时间戳排序, dir_name: 文件夹路径, files: 文件名数组
-int read_sort_dir_files(const char* dir_name, char* files[])
-{
-    DIR *dirp = NULL;
-    struct dirent *dp = NULL;
-    int n = 0;
-
-    // 打开目录
-    if ((dirp = opendir(dir_name)) == NULL) {
-		char cwd[4096];
-		getcwd(cwd, sizeof(cwd));
-		rprintf(FWARNING, "[yee-%s] sender.c: read_sort_dir_files opendir() %s error, cwd=%s\n", who_am_i(), dir_name, cwd);
-		return -1;
-    }
-
-    // 统计目录下的文件数
-    while ((dp = readdir(dirp)) != NULL) {
-        if (strcmp(dp->d_name, ".") != 0 && strcmp(dp->d_name, "..") != 0) {
-            n++;
-        }
-    }
-
-    // 重新设置目录位置
-    rewinddir(dirp);
-
-    // 分配动态内存，保存文件名
-    for (int i = 0; i < n; i++) {
-        files[i] = (char *)malloc(MAXPATHLEN * sizeof(char));
-    }
-
-    // 保存文件名到字符串指针数组中
-    int i = 0;
-    while ((dp = readdir(dirp)) != NULL) {
-        if (strcmp(dp->d_name, ".") != 0 && strcmp(dp->d_name, "..") != 0) {
-			strcpy(files[i], dir_name);
-            strcat(files[i], dp->d_name);
-            i++;
-        }
-    }
-
-    // 关闭目录
-    closedir(dirp);
-
-    // 对文件名进行排序
-    qsort(files, n, sizeof(char *), compare_delta_file_name);
-
-    return n;
-}
-
 void print_backup_files_list(const backup_files_list * backup_files)
 {
 	rprintf(FWARNING, "\n[yee-%s] sender.c: print_backup_files_list backup_files->num: %d\n", who_am_i(), backup_files->num);
@@ -629,49 +211,40 @@ void print_backup_files_list(const backup_files_list * backup_files)
 }
 
 // 恢复时,选用的备份文件类型  0: incremental 使用增量备份, 	 	1: differential 使用差量备份
-int decide_recovery_type(const char* dir_name, const char* file_name, 
-						backup_files_list * incremental_full_files, backup_files_list * incremental_delta_files, 
-						backup_files_list * differential_full_files, backup_files_list * differential_delta_files, 
-						const char* recovery_timestamp )
+// 版本都以版本号的秒数(version_id())比较, 在版本清单中二分查找
+// mode模式下不晚于until的最新版本(全量或delta), 没有则返回NULL
+static struct backup_version *newest_version_until(const struct backup_manifest *m, int mode, int64 until)
 {
-	// 生成备份文件路径
-	char incre_full_backup_path[MAXPATHLEN];
-	char incre_delta_backup_path[MAXPATHLEN];
-	char diffe_full_backup_path[MAXPATHLEN];
-	char diffe_delta_backup_path[MAXPATHLEN];
-
-	sprintf(incre_full_backup_path, "%s/%s.backup/incremental/full/", dir_name, file_name);
-	sprintf(incre_delta_backup_path, "%s/%s.backup/incremental/delta/", dir_name, file_name);
-	sprintf(diffe_full_backup_path, "%s/%s.backup/differential/full/", dir_name, file_name);
-	sprintf(diffe_delta_backup_path, "%s/%s.backup/differential/delta/", dir_name, file_name);
-
-	// 读取路径下文件并按时间排序
-	int incre_delta_count = 0, incre_full_count = 0;
-	int diffe_delta_count = 0, diffe_full_count = 0;
-
-	if((incre_full_count = read_sort_dir_files(incre_full_backup_path, incremental_full_files->file_path)) == -1)
-		incre_full_count = 0;
-	else
-		incremental_full_files->num = incre_full_count;
+	struct backup_version *full = manifest_until(m, mode, BACKUP_KIND_FULL, until);
+	struct backup_version *delta = manifest_until(m, mode, BACKUP_KIND_DELTA, until);
 
-	if((incre_delta_count = read_sort_dir_files(incre_delta_backup_path, incremental_delta_files->file_path)) == -1)
-		incre_delta_count = 0;
-	else
-		incremental_delta_files->num = incre_delta_count;
-
-	if((diffe_full_count = read_sort_dir_files(diffe_full_backup_path, differential_full_files->file_path)) == -1)
-		diffe_full_count = 0;
-	else
-		differential_full_files->num = diffe_full_count;
+	if (!full || (delta && delta->id > full->id))
+		return delta;
+	return full;
+}
 
-	if((diffe_delta_count = read_sort_dir_files(diffe_delta_backup_path, differential_delta_files->file_path)) == -1)
-		diffe_delta_count = 0;
-	else
-		differential_delta_files->num = diffe_delta_count;
+int decide_recovery_type(const struct backup_manifest *m, int64 until)
+{
+	struct backup_version *v;
+	int incre_full_count = manifest_range(m, BACKUP_MODE_INCREMENTAL, BACKUP_KIND_FULL, &v);
+	int incre_delta_count = manifest_range(m, BACKUP_MODE_INCREMENTAL, BACKUP_KIND_DELTA, &v);
+	int diffe_full_count = manifest_range(m, BACKUP_MODE_DIFFERENTIAL, BACKUP_KIND_FULL, &v);
+	int diffe_delta_count = manifest_range(m, BACKUP_MODE_DIFFERENTIAL, BACKUP_KIND_DELTA, &v);
 
 	rprintf(FWARNING, "[yee-%s] sender.c: decide_recovery_type incre_full_count: %d, incre_delta_count: %d, diffe_full_count: %d, diffe_delta_count: %d\n", 
 			who_am_i(), incre_full_count, incre_delta_count, diffe_full_count, diffe_delta_count);
 
+	// 反向增量备份的版本不比增量/差量备份旧时优先使用, 最新版本无需拼接
+	struct backup_version *reverse_best = newest_version_until(m, BACKUP_MODE_REVERSE, until);
+	if (reverse_best != NULL)
+	{
+		struct backup_version *incre_best = newest_version_until(m, BACKUP_MODE_INCREMENTAL, until);
+		struct backup_version *diffe_best = newest_version_until(m, BACKUP_MODE_DIFFERENTIAL, until);
+		if ((!incre_best || reverse_best->id >= incre_best->id)
+		 && (!diffe_best || reverse_best->id >= diffe_best->id))
+			return BACKUP_MODE_REVERSE;
+	}
+
 	if(incre_full_count == 0 && diffe_full_count == 0)		// 增量备份和差量备份都不存在
 	{
 		return -1;
@@ -688,73 +261,26 @@ int decide_recovery_type(const char* dir_name, const char* file_name,
 	}
 	else	// 增量备份和差量备份都存在
 	{
-		/*找delta文件的版本*/
-		char incre_delta_timestamp[100] = "\0";
-		char diffe_delta_timestamp[100] = "\0";
-		int find_incre_delta = 0, find_diffe_delta = 0;
-
-
-		// 找到增量备份和差量备份的delta文件中, 最新的时间戳小于等于恢复版本号的文件 delta_timestamp <= recovery_timestamp
-		for(int i = incre_delta_count; i != 0; i--)
-		{
-			extract_file_name_timestamp(incremental_delta_files->file_path[i - 1], incre_delta_timestamp);
-			if(strcmp(incre_delta_timestamp, recovery_timestamp) <= 0)
-			{
-				find_incre_delta = 1;
-				break;
-			}
-		}
-
-		for(int i = diffe_delta_count; i != 0; i--)
-		{
-			extract_file_name_timestamp(differential_delta_files->file_path[i - 1], diffe_delta_timestamp);
-			if(strcmp(diffe_delta_timestamp, recovery_timestamp) <= 0)
-			{
-				find_diffe_delta = 1;
-				break;
-			}
-		}
-
-		/*找full文件的版本*/
-		char incre_full_timestamp[100] = "\0";
-		char diffe_full_timestamp[100] = "\0";
-		int find_incre_full = 0, find_diffe_full = 0;
+		// 增量备份和差量备份中, 不晚于恢复版本的最新delta和full版本
+		struct backup_version *incre_delta = manifest_until(m, BACKUP_MODE_INCREMENTAL, BACKUP_KIND_DELTA, until);
+		struct backup_version *diffe_delta = manifest_until(m, BACKUP_MODE_DIFFERENTIAL, BACKUP_KIND_DELTA, until);
+		struct backup_version *incre_full = manifest_until(m, BACKUP_MODE_INCREMENTAL, BACKUP_KIND_FULL, until);
+		struct backup_version *diffe_full = manifest_until(m, BACKUP_MODE_DIFFERENTIAL, BACKUP_KIND_FULL, until);
 
-		for(int i = incre_full_count; i != 0; i--)
+		if(incre_delta == NULL && diffe_delta == NULL)
 		{
-			extract_file_name_timestamp(incremental_full_files->file_path[i - 1], incre_full_timestamp);
-			if(strcmp(incre_full_timestamp, recovery_timestamp) <= 0)
+			if(incre_full != NULL && diffe_full != NULL)
 			{
-				find_incre_full = 1;
-				break;
-			}
-		}
-
-		for(int i = diffe_full_count; i != 0; i--)
-		{
-			extract_file_name_timestamp(differential_full_files->file_path[i - 1], diffe_full_timestamp);
-			if(strcmp(diffe_full_timestamp, recovery_timestamp) <= 0)
-			{
-				find_diffe_full = 1;
-				break;
-			}
-		}
-
-
-		if(find_incre_delta == 0 && find_diffe_delta == 0)
-		{
-			if(find_incre_full == 1 && find_diffe_full == 1)
-			{
-				if(strcmp(incre_full_timestamp, diffe_full_timestamp) > 0)	// 增量备份full最新 使用增量备份
+				if(incre_full->id > diffe_full->id)	// 增量备份full最新 使用增量备份
 					return 0;
-				else														// 差量备份full最新 使用差量备份
+				else								// 差量备份full最新 使用差量备份
 					return 1;
 			}
-			else if(find_incre_full == 1 && find_diffe_full == 0)
+			else if(incre_full != NULL)
 			{
 				return 0;
 			}
-			else if(find_incre_full == 0 && find_diffe_full == 1)
+			else if(diffe_full != NULL)
 			{
 				return 1;
 			}
@@ -763,25 +289,25 @@ int decide_recovery_type(const char* dir_name, const char* file_name,
 				return -1;
 			}
 		}
-		else if(find_incre_delta == 0 && find_diffe_delta == 1)				// 无合规的增量备份delta
+		else if(incre_delta == NULL)				// 无合规的增量备份delta
 		{
-			if(find_incre_full == 1)
+			if(incre_full != NULL)
 				return 0;
 			else
 				return 1;
 		}
-		else if(find_incre_delta == 1 && find_diffe_delta == 0)				// 无合规的差量备份delta
+		else if(diffe_delta == NULL)				// 无合规的差量备份delta
 		{
-			if(find_diffe_full == 1)
+			if(diffe_full != NULL)
 				return 1;
 			else
 				return 0;
 		}
-		else if(strcmp(incre_delta_timestamp, diffe_delta_timestamp) > 0)	// 增量备份delta最新 使用增量备份
+		else if(incre_delta->id > diffe_delta->id)	// 增量备份delta最新 使用增量备份
 		{
 			return 0;
 		}	
-		else																// 差量备份delta最新(或差量与增量delta版本一致) 使用差量备份
+		else										// 差量备份delta最新(或差量与增量delta版本一致) 使用差量备份
 		{
 			return 1;
 		}
@@ -789,385 +315,340 @@ int decide_recovery_type(const char* dir_name, const char* file_name,
 	}
 }
 
-// 将增量文件拼接为完整文件
-int combine_incremental_files(const char* dir_name, const char* file_name,
-							const backup_files_list * full_files, const backup_files_list * delta_files, 
-							const char* recovery_version, char* recovery_file_path)	
+static int lazy_chains = 0;	// 只读取版本中的若干区间, delta链不预先合成
+
+// 打开full + deltas[0..n)组成的delta链, reverse时deltas从新到旧应用; 只读区间时由各delta的偏移索引随读随查
+static struct delta_chain *open_chain(const struct backup_version *full, const struct backup_version *deltas,
+				      int n, int reverse)
 {
-	char full_timestamp[128], delta_timestamp[128];
-	int full_count = full_files->num;
-	int delta_count = delta_files->num;
+	struct delta_chain *chain;
+	char **paths = NULL;
+	int i;
 
-	int full_index = 0, delta_index = 0, find_full = 0;
+	if (n && !(paths = new_array(char *, n)))
+		out_of_memory("open_chain");
+	for (i = 0; i < n; i++)
+		paths[i] = deltas[reverse ? n - 1 - i : i].path;
 
-	char cwd[4096];
-	getcwd(cwd, 4096);
-	rprintf(FWARNING, "[yee-%s] sender.c: combine_incremental_files cwd: %s\n", who_am_i(), cwd);
+	if (lazy_chains)
+		chain = delta_chain_open_lazy(full->path, paths, n);
+	else
+		chain = delta_chain_open(full->path, paths, n);
+	if (paths)
+		free(paths);
 
-	// 确定full文件
-	for(full_index = full_count; full_index; full_index--)
-	{
-		extract_file_name_timestamp(full_files->file_path[full_index - 1], full_timestamp);
-		int cmp = strcmp(full_timestamp, recovery_version);
-		if(cmp < 0)	// 该full文件时间戳小于恢复版本号, 满足要求,用于后续拼接
-		{	
-			find_full = 1;
-			full_index = full_index - 1;
-			break;
-		}
-		else if(cmp == 0)	// 该full文件时间戳等于恢复版本号,直接发送
-		{
-			strcpy(recovery_file_path, full_files->file_path[full_index - 1]);
-			return 0;
-		}
+	return chain;
+}
 
-	}
-	rprintf(FWARNING, "[yee-%s] sender.c: combine_incremental_files full_index: %d, full_timestamp = %s\n", who_am_i(), full_index, full_timestamp);
-	if( find_full == 0 )	// 没有找到满足要求的full文件
-	{
-		rprintf(FWARNING, "[yee-%s] sender.c: combine_incremental_files full file %s not find\n", who_am_i(), recovery_version);
-		return -1;
-	}
+// 将增量文件合成为恢复版本的delta链, 由map_delta_chain()直接读取, 不再写出.recovery文件
+struct delta_chain *combine_incremental_files(const struct backup_manifest *m, int64 until)
+{
+	struct backup_version *full, *delta;
+	int delta_count;
 
-	int delta_index_start = -1, delta_index_end = -1;
-	for(delta_index = delta_count; delta_index; delta_index--)
+	// 确定full文件: 不晚于恢复版本的最新full文件, 与恢复版本相同时直接发送
+	if ((full = manifest_until(m, BACKUP_MODE_INCREMENTAL, BACKUP_KIND_FULL, until)) == NULL)
 	{
-		extract_file_name_timestamp(delta_files->file_path[delta_index - 1], delta_timestamp);
-		rprintf(FWARNING, "[yee-%s] sender.c: combine_incremental_files delta_index: %d, delta_timestamp = %s, recovery_version = %s\n", 
-			who_am_i(), delta_index, delta_timestamp, recovery_version);
-		if(delta_index_end == -1 && strcmp(delta_timestamp, recovery_version) <= 0)	// 找到增量文件的结束位置
-		{
-			delta_index_end = delta_index - 1;
-		}
-		if(delta_index_end != -1 && strcmp(delta_timestamp, full_timestamp) > 0)	// 找到增量文件的起始位置
-		{
-			delta_index_start = delta_index - 1;
-		}
-		else if(delta_index_end != -1)
-		{
-			break;
-		}
-	}
-	rprintf(FWARNING, "[yee-%s] sender.c: combine_incremental_files delta_index_start: %d, delta_index_end: %d\n", who_am_i(), delta_index_start, delta_index_end);
-	if(delta_index_start == -1 || delta_index_end == -1 || delta_index_start > delta_index_end)	// 增量版本号不满足要求
+		rprintf(FWARNING, "[yee-%s] sender.c: combine_incremental_files no full file until version id %s\n", who_am_i(), do_big_num(until, 0, NULL));
+		return NULL;
+	}
+	if (full->id == until)
+		return open_chain(full, NULL, 0, 0);
+
+	// (full, 恢复版本]之间的delta文件依次拼接
+	delta_count = manifest_span(m, BACKUP_MODE_INCREMENTAL, BACKUP_KIND_DELTA, full->id + 1, until, &delta);
+	rprintf(FWARNING, "[yee-%s] sender.c: combine_incremental_files full_timestamp = %s, %d deltas\n",
+			who_am_i(), full->version, delta_count);
+	if (delta_count == 0)
+		return open_chain(full, NULL, 0, 0);
+ 
+	// 把整条delta链合成为一份基于full文件和delta字面量的操作表
+	struct delta_chain *chain = open_chain(full, delta, delta_count, 0);
+	if (chain == NULL)
 	{
-		strcpy(recovery_file_path, full_files->file_path[full_index]);
-		return 0;
+		rprintf(FWARNING, "[yee-%s] sender.c: combine_incremental_files compose delta[%s..%s] on %s failed\n",
+				who_am_i(), delta->version, delta[delta_count - 1].version, full->path);
+		return NULL;
 	}
+	rprintf(FWARNING, "[yee-%s] sender.c: combine_incremental_files %d deltas -> %d extents\n",
+			who_am_i(), delta_count, chain->count);
 
-	char tmp_file_path[MAXPATHLEN], full_file_path[MAXPATHLEN], delta_file_path[MAXPATHLEN];
+	return chain;
+}
 
-	sprintf(recovery_file_path, "%s/%s.backup/%s.%s", dir_name, file_name, file_name, "recovery");
-	sprintf(tmp_file_path,"%s/%s.backup/%s.%s", dir_name, file_name, file_name, "recovery.tmp");
-	
-	strcpy(full_file_path, full_files->file_path[full_index]);
- 
-	FILE *full_file = fopen(full_file_path, "rb");
-	FILE *delta_file = NULL;
-	FILE *recovery_file = fopen(recovery_file_path, "wb");
+// 将差量文件合成为恢复版本的delta链(full + 一个delta)
+struct delta_chain *combine_differental_files(const struct backup_manifest *m, int64 until)
+{
+	struct backup_version *full, *delta;
 
-	if(full_file == NULL)
+	// 确定full文件
+	if ((full = manifest_until(m, BACKUP_MODE_DIFFERENTIAL, BACKUP_KIND_FULL, until)) == NULL)
 	{
-		rprintf(FWARNING, "[yee-%s] sender.c: combine_incremental_files full file %s fopen failed\n", who_am_i(), full_file_path);
+		rprintf(FWARNING, "[yee-%s] sender.c: combine_differental_files full file until version id %s not find\n", who_am_i(), do_big_num(until, 0, NULL));
+		return NULL;
 	}
-	else
+	if (full->id == until)	// 该full文件时间戳等于恢复版本号,直接发送
+		return open_chain(full, NULL, 0, 0);
+
+	// (full, 恢复版本]之间最新的delta文件
+	if ((delta = manifest_until(m, BACKUP_MODE_DIFFERENTIAL, BACKUP_KIND_DELTA, until)) == NULL || delta->id <= full->id)
 	{
-		rprintf(FWARNING, "[yee-%s] sender.c: combine_incremental_files full file %s fopen success\n", who_am_i(), full_file_path);
+		rprintf(FWARNING, "[yee-%s] sender.c: combine_differental_files delta file after %s until version id %s not find\n", who_am_i(), full->version, do_big_num(until, 0, NULL));
+		return NULL;
 	}
+	rprintf(FWARNING, "[yee-%s] sender.c: combine_differental_files delta_file_path: %s\n", who_am_i(), delta->path);
 
-	// 开始拼接文件
-	for(delta_index = delta_index_start; delta_index <= delta_index_end; delta_index++)
-	{	
-		rprintf(FWARNING,"[yee-%s] sender.c: combine_incremental_files in loop delta_file[%d] %s\n", who_am_i(), delta_index, delta_files->file_path[delta_index]);
-		
-		strcpy(delta_file_path, delta_files->file_path[delta_index]);
-		delta_file = fopen(delta_file_path, "rb");
+	struct delta_chain *chain = open_chain(full, delta, 1, 0);
+	if (chain == NULL)
+	{
+		rprintf(FWARNING, "[yee-%s] sender.c: combine_differental_files apply %s to %s failed\n", who_am_i(), delta->path, full->path);
+		return NULL;
+	}
+	return chain;
+}
 
-		if( delta_file == NULL )
-		{
-			rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full delta_file %s open failed\n", who_am_i(), delta_file_path);
-			return -1;
-		}
+// 反向增量: 从不早于恢复版本的最近全量版本出发, 按时间倒序应用反向delta
+struct delta_chain *combine_reverse_files(const struct backup_manifest *m, int64 until)
+{
+	struct backup_version *full, *delta;
+	int full_count = manifest_range(m, BACKUP_MODE_REVERSE, BACKUP_KIND_FULL, &full);
+	const struct backup_version *target = newest_version_until(m, BACKUP_MODE_REVERSE, until);
+	int full_index, n;
 
-		char line[1024*100];																	// delta行读取缓冲区
-		int delta_block_length = -1, delta_block_count = -1, delta_remainder_block_length = -1; // delta文件元数据 块大小 块数量 剩余块大小
-		OFF_T total_size = -1, content_size = -1;	// delta文件元数据 偏移量 总大小 内容大小
-		
-		struct map_struct *mapbuf = NULL;	// map_struct 快速找到全量文件中匹配的内容
-		int fd_full = do_open(full_file_path, O_RDONLY, 0);	// 以文件描述符的方式打开全量文件
-		if( fd_full < 0 )
-		{
-			rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full full_file %s open failed\n", who_am_i(), full_file_path);
-			return -1;
-		}
-		else
-		{
-			rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full full_file %s open success\n", who_am_i(), full_file_path);
-		}
+	if (target == NULL)
+	{
+		rprintf(FWARNING, "[yee-%s] sender.c: combine_reverse_files version id %s not find\n", who_am_i(), do_big_num(until, 0, NULL));
+		return NULL;
+	}
 
-		// delta 文件元数据解析
-		if(fgets(line, sizeof(line), delta_file) != NULL)	
-		{
-			sscanf(line, "[delta file metadata] file_size = %ld, content_size = %ld, block_size = %d, block_count = %d, remainder_block = %d\n", 
-				&total_size, &content_size, &delta_block_length, &delta_block_count, &delta_remainder_block_length);
-		}	
-		else
-		{
-			rprintf(FWARNING, "[yee-%s] sender.c: make_d2f fgets delta metadata error\n", who_am_i());
-		}
+	// 最早的不早于目标版本的全量版本
+	for (full_index = 0; full_index < full_count; full_index++)
+	{
+		if (full[full_index].id >= target->id)
+			break;
+	}
+	if (full_index == full_count)
+	{
+		rprintf(FWARNING, "[yee-%s] sender.c: combine_reverse_files no full version after %s\n", who_am_i(), target->version);
+		return NULL;
+	}
+	full += full_index;
+	if (full->id == target->id)	// 目标就是全量版本(通常是最新版本), 直接发送
+		return open_chain(full, NULL, 0, 0);
 
-		// 构建map_struct 以供map_ptr使用 参见receiver->receive_data
-		int32 read_size = MAX(delta_block_length*2, 16*1024);
-		mapbuf = map_file(fd_full, content_size, read_size, delta_block_length);	// 构建map_struct 以供map_ptr使用
+	// 反向delta [target, full) 从新到旧依次应用
+	n = manifest_span(m, BACKUP_MODE_REVERSE, BACKUP_KIND_DELTA, target->id, full->id - 1, &delta);
 
-		// delta 增量信息解析
-		while ( fgets(line, sizeof(line), delta_file) != NULL)
-		{ 
-			int token = -1;
-			OFF_T offset = -1, offset2 = -1;
+	rprintf(FWARNING, "[yee-%s] sender.c: combine_reverse_files %s <- %d deltas <- %s\n",
+			who_am_i(), target->version, n, full->version);
 
-			if(strcmp(line, "\n") == 0 || strcmp(line, "\r\n") == 0)
-			{
-				continue;
-			}
-			else if(strncmp(line, "match token\0", strlen("match token\0")) == 0)	// 解析delta文件中匹配的部分 token
-			{
-				char *map_data = NULL;
-				size_t map_len = -1;
-				sscanf(line, "match token = %d, offset = %ld, offset2 = %ld\n", &token, &offset, &offset2);
-				
-				map_len = delta_block_length;
-				if( token == delta_block_count - 1 && delta_remainder_block_length != 0)
-				{
-					map_len = delta_remainder_block_length;
-				}
-							
-				map_data = map_ptr(mapbuf, offset2, map_len);	// 使用offset2
+	return open_chain(full, delta, n, 1);
+}
 
-				if( map_data != NULL && fwrite(map_data, 1, map_len, recovery_file) != map_len )
-				{
-					rprintf(FWARNING, "[yee-%s] sender.c: make_d2f fwrite match data error\n", who_am_i());
-				}
-			}
-			else if(strncmp(line, "unmatch data length\0", strlen("unmatch data length\0")) == 0) // 解析delta文件中不匹配的部分
-			{
+// 打包文件中的版本packed_id是否是until之前最近的版本(版本目录中没有更新的)
+static int packed_is_newest(const struct backup_manifest *m, int64 packed_id, int64 until)
+{
+	int mode;
 
-				char unmatch_data[1024*1000];	// 不匹配数据缓冲区
-				size_t unmatch_len = 0;			// 读取长度
-				sscanf(line, "unmatch data length = %ld, offset = %ld\n", &unmatch_len, &offset);
+	for (mode = 0; mode < BACKUP_MODE_COUNT; mode++)
+	{
+		struct backup_version *best = newest_version_until(m, mode, until);
+		if (best && best->id > packed_id)
+			return 0;
+	}
 
-				if( fread(unmatch_data, 1, unmatch_len, delta_file) != unmatch_len )
-				{
-					rprintf(FWARNING, "[yee-%s] sender.c: make_d2f fread unmatch data length error\n", who_am_i());
-				}
+	return 1;
+}
 
-				if( fwrite(unmatch_data, 1, unmatch_len, recovery_file) != unmatch_len ) // 直接将不匹配数据写入
-				{
-					rprintf(FWARNING, "[yee-%s] sender.c: make_d2f fwrite unmatch data length error\n", who_am_i());
-				}
-			}
-			else
-			{
-				rprintf(FWARNING, "[yee-%s] sender.c: make_d2f line: %s is illegal\n", who_am_i(), line);
-			}
-		}
-		fclose(delta_file);
-		fclose(full_file);
-		fclose(recovery_file);
-		close(fd_full);
+// 为恢复版本构建delta链, 目录或无可用备份时返回NULL
+static struct delta_chain *open_recovery_chain(const char *fname, const char *dir_name, const char *file_name,
+						const char *version)
+{
+	struct delta_chain *chain = NULL;
+	struct backup_manifest manifest;
+	char packed_version[BACKUP_VERSION_LEN];
+	int64 until = version_id(version);
+	struct stat path_stat;
+
+	if (strcmp(fname, ".") == 0 || strcmp(fname, "..") == 0)
+		return NULL;
+	// 目录清单中已删除的文件只剩版本目录, 同样可以恢复
+	if (stat(fname, &path_stat) == 0 && S_ISDIR(path_stat.st_mode))
+		return NULL;
+
+	rprintf(FWARNING, "[yee-%s] sender.c: send_files make d2f dir_name = %s, file_name = %s\n", who_am_i(), dir_name, file_name);
+	rprintf(FWARNING, "[yee-%s] sender.c: send_files make d2f version = %s\n", who_am_i(), version);
+	if (until < 0)
+	{
+		rprintf(FWARNING, "[yee-%s] sender.c: send_files version %s is not yyyy-mm-dd-HH:MM:SS\n", who_am_i(), version);
+		return NULL;
+	}
+	manifest_open(&manifest, fname);
 
-		if(delta_index != delta_index_end)
+	// 小文件的版本可能整体保存在所在目录的打包文件中; 版本目录中有更新的可用版本时以版本目录为准
+	if ((chain = pack_open_version(dir_name, file_name, until, packed_version)) != NULL)
+	{
+		if (packed_is_newest(&manifest, version_id(packed_version), until))
 		{
-			copy_file(recovery_file_path, tmp_file_path, -1, 0666);
-
-			full_file = fopen(tmp_file_path, "rb");
-			recovery_file = fopen(recovery_file_path, "wb");
-
-			strcpy(full_file_path, tmp_file_path);
+			rprintf(FWARNING, "[yee-%s] sender.c: send_files %s version %s is packed\n", who_am_i(), fname, packed_version);
+			manifest_close(&manifest);
+			return chain;
 		}
-		else
+		delta_chain_close(chain);
+		chain = NULL;
+	}
+
+	recovery_type =  decide_recovery_type(&manifest, until);
+	rprintf(FWARNING, "[yee-%s] sender.c: send_files recovery_type = *%s*\n", who_am_i(), backup_mode_name(recovery_type));
+	if(recovery_type == 0)		// 使用增量备份
+	{
+		if((chain = combine_incremental_files(&manifest, until)) == NULL)
 		{
-			remove(tmp_file_path);
+			rprintf(FWARNING, "[yee-%s] sender.c: send_files combine_incremental_files error\n", who_am_i());
 		}
 	}
-	return 0;
-}
-
-// 将差量文件拼接为完整文件
-int combine_differental_files(const char* dir_name, const char* file_name,
-							const backup_files_list * full_files, const backup_files_list * delta_files, 
-							const char* recovery_version, char* recovery_file_path)	
-{
-	char full_timestamp[128], delta_timestamp[128];
-	int full_count = full_files->num;
-	int delta_count = delta_files->num;
-
-	int full_index = 0, delta_index = 0, find_full = 0, find_delta = 0;
-	
-
-	// 确定full文件
-	for(full_index = full_count; full_index; full_index--)
+	else if(recovery_type == 1)	// 使用差量备份
 	{
-		extract_file_name_timestamp(full_files->file_path[full_index - 1], full_timestamp);
-		int cmp = strcmp(full_timestamp, recovery_version);
-		if(cmp < 0)	// 该full文件时间戳小于恢复版本号, 满足要求,用于后续拼接
+		if((chain = combine_differental_files(&manifest, until)) == NULL)
 		{
-			find_full = 1;
-			full_index = full_index - 1;
-			break;
+			rprintf(FWARNING, "[yee-%s] sender.c: send_files combine_differental_files error\n", who_am_i());
 		}
-		else if(cmp == 0)	// 该full文件时间戳等于恢复版本号,直接发送
+	}
+	else if(recovery_type == BACKUP_MODE_REVERSE)	// 使用反向增量备份
+	{
+		if((chain = combine_reverse_files(&manifest, until)) == NULL)
 		{
-			strcpy(recovery_file_path, full_files->file_path[full_index - 1]);
-			return 0;
+			rprintf(FWARNING, "[yee-%s] sender.c: send_files combine_reverse_files error\n", who_am_i());
 		}
 	}
-	if( find_full == 0 )	// 没有找到满足要求的full文件
+	else
 	{
-		rprintf(FWARNING, "[yee-%s] sender.c: combine_differental_files full file %s not find\n", who_am_i(), recovery_version);
-		return -1;
+		rprintf(FWARNING, "[yee-%s] sender.c: send_files decide_recovery_type error\n", who_am_i());
 	}
+	// 版本的路径指向manifest内部, 合成完成后才能关闭
+	manifest_close(&manifest);
 
+	// 整个版本的读取优先使用版本缓存中已还原的副本
+	if (!lazy_chains)
+		chain = version_cache_open(fname, version, chain);
 
+	return chain;
+}
 
-	for(delta_index = delta_count; delta_index; delta_index--)
-	{
-		extract_file_name_timestamp(delta_files->file_path[delta_index - 1], delta_timestamp);
-		if(strcmp(delta_timestamp, recovery_version) <= 0 && strcmp(delta_timestamp, full_timestamp) > 0)	// 找到增量文件的结束位置
-		{
-			find_delta = 1;
-			delta_index = delta_index - 1;
-			break;
-		}
-	}
-	if(find_delta == 0)	// 增量版本号不满足要求
+// 把路径fname拆成所在目录dir_name(MAXPATHLEN)和文件名, 返回文件名
+static const char *split_fname(const char *fname, char *dir_name)
+{
+	const char *ptr = strrchr(fname, '/');
+
+	if (ptr)
 	{
-		rprintf(FWARNING, "[yee-%s] sender.c: combine_differental_files delta file [%s -- %s] not find\n", who_am_i(), full_timestamp, recovery_version);
-		return -1;
+		strlcpy(dir_name, fname, MIN((size_t)(ptr - fname) + 1, MAXPATHLEN));
+		return ptr + 1;
 	}
+	strlcpy(dir_name, ".", MAXPATHLEN);
+	return fname;
+}
 
-	char full_file_path[MAXPATHLEN], delta_file_path[MAXPATHLEN];
-
-	sprintf(recovery_file_path, "%s/%s.backup/%s.%s", dir_name, file_name, file_name, "recovery");
-	
-	strcpy(full_file_path, full_files->file_path[full_index]);
+// 按路径fname打开version(或之前最近的版本)的delta链, lazy时不预先合成
+static struct delta_chain *open_version_chain(const char *fname, const char *version, int lazy)
+{
+	char dir_name[MAXPATHLEN];
+	const char *file_name = split_fname(fname, dir_name);
+	struct delta_chain *chain;
+	int save = lazy_chains;
 
-	FILE *full_file = fopen(full_file_path, "rb");
-	FILE *delta_file = NULL;
-	FILE *recovery_file = fopen(recovery_file_path, "wb");
+	lazy_chains = lazy;
+	chain = open_recovery_chain(fname, dir_name, file_name, version);
+	lazy_chains = save;
 
-	// 开始拼接文件
+	return chain;
+}
 
-	char cwd[MAXPATHLEN];
+// 打开fname在version(或之前最近的版本)时的内容, 供delta_chain_read()按区间读取,
+// 不重建整个文件: delta不预先合成, 读取时按各delta的偏移索引只解析所读区间附近的操作
+struct delta_chain *backup_version_open(const char *fname, const char *version)
+{
+	return open_version_chain(fname, version, 1);
+}
 
-	if (getcwd(cwd, sizeof(cwd)) != NULL) {
-		rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full current working directory: %s\n", who_am_i(), cwd);
-	} else {
-		rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full getcwd() error\n", who_am_i());
-	}
+// 将fname在version时的内容写成普通文件dest (还原预取的工作进程使用, 见prefetch.c)
+int backup_version_extract(const char *fname, const char *version, const char *dest)
+{
+	struct delta_chain *chain;
+	int ret;
 
-	strcpy(delta_file_path, delta_files->file_path[delta_index]);
-	rprintf(FWARNING, "[yee-%s] sender.c: combine_differental_files delta_file_path: %s\n", who_am_i(), delta_file_path);
-	delta_file = fopen(delta_file_path, "rb");
-	if( delta_file == NULL )
-	{
-		rprintf(FWARNING, "[yee-%s] sender.c: combine_differental_files delta_file open failed\n", who_am_i());
-		if (errno == ENOENT) {
-            rprintf(FWARNING, "[yee-%s] sender.c:Error: file %s does not exist\n", who_am_i(), delta_file_path);
-        } else if (errno == EACCES) {
-            rprintf(FWARNING, "[yee-%s] sender.c:Error: file %s cannot be accessed\n", who_am_i(), delta_file_path);
-        } else {
-            rprintf(FWARNING, "[yee-%s] sender.c:Error: failed to open file %s, errno = %d\n", who_am_i(), delta_file_path, errno);
-        }
+	if ((chain = open_version_chain(fname, version, 0)) == NULL)
 		return -1;
-	}
+	ret = delta_chain_extract(chain, dest);
+	delta_chain_close(chain);
+	if (ret < 0)
+		do_unlink(dest);
 
-	char line[1024*100];																	// delta行读取缓冲区
-	int delta_block_length = -1, delta_block_count = -1, delta_remainder_block_length = -1; // delta文件元数据 块大小 块数量 剩余块大小
-	OFF_T total_size = -1, content_size = -1;	// delta文件元数据 偏移量 总大小 内容大小
-	
-	struct map_struct *mapbuf = NULL;	// map_struct 快速找到全量文件中匹配的内容
-	int fd_full = do_open(full_file_path, O_RDONLY, 0);	// 以文件描述符的方式打开全量文件
-	if( fd_full < 0 )
-	{
-		rprintf(FWARNING, "[yee-%s] sender.c: make_delta_to_full full_file %s open failed\n", who_am_i(), full_file_path);
-		return -1;
-	}
+	return ret;
+}
 
-	// delta 文件元数据解析
-	if(fgets(line, sizeof(line), delta_file) != NULL)	
-	{
-		sscanf(line, "[delta file metadata] file_size = %ld, content_size = %ld, block_size = %d, block_count = %d, remainder_block = %d\n", 
-			&total_size, &content_size, &delta_block_length, &delta_block_count, &delta_remainder_block_length);
-	}	
-	else
-	{
-		rprintf(FWARNING, "[yee-%s] sender.c: make_d2f fgets delta metadata error\n", who_am_i());
-	}
+// 读取fname在version时[offset, offset+len)的内容, 返回读到的字节数(只在版本结尾处变短), 出错返回-1
+int32 backup_read_range(const char *fname, const char *version, OFF_T offset, char *buf, int32 len)
+{
+	struct delta_chain *chain;
+	int32 n;
 
-	// 构建map_struct 以供map_ptr使用 参见receiver->receive_data
-	int32 read_size = MAX(delta_block_length*2, 16*1024);
-	mapbuf = map_file(fd_full, content_size, read_size, delta_block_length);	// 构建map_struct 以供map_ptr使用
+	if ((chain = backup_version_open(fname, version)) == NULL)
+		return -1;
+	n = delta_chain_read(chain, offset, buf, len);
+	delta_chain_close(chain);
 
-	// delta 增量信息解析
-	while ( fgets(line, sizeof(line), delta_file) != NULL)
-	{ 
-		int token = -1;
-		OFF_T offset = -1, offset2 = -1;
+	return n;
+}
 
-		// rprintf(FWARNING, "[yee-%s] sender.c: make_d2f line: %s\n", who_am_i(), line);
-		if(strcmp(line, "\n") == 0 || strcmp(line, "\r\n") == 0)
-		{
-			continue;
-		}
-		else if(strncmp(line, "match token\0", strlen("match token\0")) == 0)	// 解析delta文件中匹配的部分 token
-		{
-			char *map_data = NULL;
-			size_t map_len = -1;
-			sscanf(line, "match token = %d, offset = %ld, offset2 = %ld\n", &token, &offset, &offset2);
-			
-			map_len = delta_block_length;
-			if( token == delta_block_count - 1 && delta_remainder_block_length != 0)
-			{
-				map_len = delta_remainder_block_length;
-			}
-						
-			map_data = map_ptr(mapbuf, offset2, map_len);	// 使用offset2
+// 取得恢复fname到version时实际使用的版本(同open_recovery_chain()的选择)的版本号、长度和
+// 备份时记录的整个文件的校验和, 只读版本清单, 不合成版本. 没有可用版本时返回-1
+int backup_version_info(const char *fname, const char *version, struct backup_version *info)
+{
+	char dir_name[MAXPATHLEN];
+	const char *file_name = split_fname(fname, dir_name);
+	struct backup_manifest manifest;
+	struct backup_version *v = NULL;
+	int64 until = version_id(version);
+	int mode;
 
-			if( map_data != NULL && fwrite(map_data, 1, map_len, recovery_file) != map_len )
-			{
-				rprintf(FWARNING, "[yee-%s] sender.c: make_d2f fwrite match data error\n", who_am_i());
-			}
-		}
-		else if(strncmp(line, "unmatch data length\0", strlen("unmatch data length\0")) == 0) // 解析delta文件中不匹配的部分
-		{
+	if (until < 0)
+		return -1;
+	manifest_open(&manifest, fname);
+	if (pack_version_info(dir_name, file_name, until, info) == 0
+	 && packed_is_newest(&manifest, info->id, until))
+	{
+		manifest_close(&manifest);
+		return 0;
+	}
 
-			char unmatch_data[1024*1000];	// 不匹配数据缓冲区
-			size_t unmatch_len = 0;			// 读取长度
-			sscanf(line, "unmatch data length = %ld, offset = %ld\n", &unmatch_len, &offset);
+	mode = decide_recovery_type(&manifest, until);
+	if (mode >= 0 && (v = newest_version_until(&manifest, mode, until)) != NULL)
+	{
+		strlcpy(info->version, v->version, sizeof info->version);
+		info->id = v->id;
+		info->size = v->size;
+		info->csum_type = v->csum_type;
+		memcpy(info->digest, v->digest, sizeof info->digest);
+	}
+	manifest_close(&manifest);
 
-			if( fread(unmatch_data, 1, unmatch_len, delta_file) != unmatch_len )
-			{
-				rprintf(FWARNING, "[yee-%s] sender.c: make_d2f fread unmatch data length error\n", who_am_i());
-			}
+	return v ? 0 : -1;
+}
 
-			if( fwrite(unmatch_data, 1, unmatch_len, recovery_file) != unmatch_len ) // 直接将不匹配数据写入
-			{
-				rprintf(FWARNING, "[yee-%s] sender.c: make_d2f fwrite unmatch data length error\n", who_am_i());
-			}
-		}
-		else
-		{
-			rprintf(FWARNING, "[yee-%s] sender.c: make_d2f line: %s is illegal\n", who_am_i(), line);
-		}
-	}
-	fclose(delta_file);
-	fclose(full_file);
-	fclose(recovery_file);
-	close(fd_full);
+// 恢复时文件列表中fname的长度和校验和(--checksum)取自要恢复的版本, 客户端的文件已经是该版本时
+// 比对校验和后直接跳过, 既不合成版本也不传输. 没有记录校验和的版本填入全零的校验和,
+// 总是传输, 也不读取当前文件
+void restore_version_sum(const char *fname, STRUCT_STAT *st, char *sum)
+{
+	struct backup_version info;
 
-	
-	return 0;
+	memset(sum, 0, flist_csum_len);
+	if (backup_version_info(fname, recovery_version, &info) < 0)
+		return;
+	st->st_size = info.size;
+	if (info.csum_type == checksum_type)
+		memcpy(sum, info.digest, flist_csum_len);
 }
 
 void send_files(int f_in, int f_out)    
@@ -1213,6 +694,7 @@ void send_files(int f_in, int f_out)
 		int f_xfer = write_batch < 0 ? batch_fd : f_out;
 		int save_io_error = io_error;
 		int ndx, j;
+		struct delta_chain *recovery_chain = NULL;
 
 		if (DEBUG_GTE(SEND, 1))
 			rprintf(FINFO, "send_files starting\n");
@@ -1287,55 +769,6 @@ void send_files(int f_in, int f_out)
 				strcpy(file_name, fname);
 			}
 
-			recovery_type = -1;
-
-			backup_files_list *incremental_full_files = (backup_files_list*)malloc(sizeof(backup_files_list));
-			backup_files_list *incremental_delta_files = (backup_files_list*)malloc(sizeof(backup_files_list));
-			backup_files_list *differential_full_files = (backup_files_list*)malloc(sizeof(backup_files_list));
-			backup_files_list *differential_delta_files = (backup_files_list*)malloc(sizeof(backup_files_list));
-
-			char recovery_path[MAXPATHLEN] = "";
-
-			
-			if(task_type_backup_or_recovery_sender == 1 && strcmp(fname, ".") != 0 && strcmp(fname, "..") != 0 )
-			{	
-				struct stat path_stat;
-				if (stat(fname, &path_stat) == 0) 
-				{
-					if (!S_ISDIR(path_stat.st_mode)) 
-					{
-						rprintf(FWARNING, "[yee-%s] sender.c: send_files make d2f dir_name = %s, file_name = %s\n", who_am_i(), dir_name, file_name);
-						rprintf(FWARNING, "[yee-%s] sender.c: send_files make d2f version = %s, iflags = %d\n", who_am_i(), recovery_version, iflags);
-						recovery_type =  decide_recovery_type(dir_name, file_name, incremental_full_files, incremental_delta_files, 
-																differential_full_files, differential_delta_files, recovery_version);
-						rprintf(FWARNING, "[yee-%s] sender.c: send_files recovery_type = *%s*\n", who_am_i(), recovery_type?"diffe 差量备份":"incre 增量备份");
-						// print_backup_files_list(incremental_full_files);
-						// print_backup_files_list(incremental_delta_files);
-						// print_backup_files_list(differential_full_files);
-						// print_backup_files_list(differential_delta_files);
-						if(recovery_type == 0)		// 使用增量备份
-						{
-							if(combine_incremental_files(dir_name, file_name, incremental_full_files, incremental_delta_files, recovery_version, recovery_path) != 0)
-							{
-								rprintf(FWARNING, "[yee-%s] sender.c: send_files combine_incremental_files error\n", who_am_i());
-							}
-						}
-						else if(recovery_type == 1)	// 使用差量备份
-						{
-							if(combine_differental_files(dir_name, file_name, differential_full_files, differential_delta_files, recovery_version, recovery_path) != 0)
-							{
-								rprintf(FWARNING, "[yee-%s] sender.c: send_files combine_differental_files error\n", who_am_i());
-							}
-						}
-						else
-						{
-							rprintf(FWARNING, "[yee-%s] sender.c: send_files decide_recovery_type error\n", who_am_i());
-						}
-					}
-				// make_delta_to_full(fname, recovery_version);
-				}
-			}
-
 			if (DEBUG_GTE(SEND, 1))
 				rprintf(FINFO, "send_files(%d, %s%s%s)\n", ndx, path,slash,fname);
 
@@ -1424,11 +857,22 @@ void send_files(int f_in, int f_out)
 			
 			// fd = do_open(fname, O_RDONLY, 0);
 			// rprintf(FWARNING, "[yee-%s] sender.c: task_type = %d, backup_type = %d\n", who_am_i(), task_type_backup_or_recovery_sender, backup_type);
-			if(task_type_backup_or_recovery_sender == 1)		// 恢复,待发送文件定位到xxxx.backup中的已拼接的全量文件
+			if(task_type_backup_or_recovery_sender == 1)		// 恢复, 待发送文件是xxxx.backup中full+delta合成的delta链, 由map_ptr直接读取
 			{
-				rprintf(FWARNING, "[yee-%s] sender.c: send_files recovery_files fname(before alter): %s\n", who_am_i(), fname);
-				rprintf(FWARNING, "[yee-%s] sender.c: send_files recovery_files recovery_path: %s\n", who_am_i(), recovery_path);
-				fd = do_open(recovery_path, O_RDONLY, 0);
+				// 只还原一段时(--recovery_range)按区间读取, 不合成整条delta链
+				lazy_chains = recovery_range != NULL;
+				if (recovery_range)
+				{
+					recovery_chain = open_recovery_chain(fname, dir_name, file_name, recovery_version);
+					if (recovery_chain)
+						delta_chain_limit(recovery_chain, recovery_range_offset, recovery_range_len);
+				}
+				// 预取进程已还原好的版本直接读取, 否则在这里合成
+				else if ((recovery_chain = prefetch_take(ndx)) == NULL)
+					recovery_chain = open_recovery_chain(fname, dir_name, file_name, recovery_version);
+				fd = recovery_chain ? recovery_chain->fds[0] : -1;
+				if (fd == -1)
+					errno = ENOENT;
 			}
 
 			else
@@ -1454,7 +898,9 @@ void send_files(int f_in, int f_out)
 			}
 
 			/* map the local file */
-			if (do_fstat(fd, &st) != 0) {
+			if (recovery_chain)
+				st.st_size = recovery_chain->size;
+			else if (do_fstat(fd, &st) != 0) {
 				io_error |= IOERR_GENERAL;
 				rsyserr(FERROR_XFER, errno, "fstat failed");
 				free_sums(s);
@@ -1464,7 +910,10 @@ void send_files(int f_in, int f_out)
 
 			if (st.st_size) {
 				int32 read_size = MAX(s->blength * 3, MAX_MAP_SIZE);
-				mbuf = map_file(fd, st.st_size, read_size, s->blength);
+				if (recovery_chain)
+					mbuf = map_delta_chain(recovery_chain, read_size, s->blength);
+				else
+					mbuf = map_file(fd, st.st_size, read_size, s->blength);
 			} else
 				mbuf = NULL;
 
@@ -1503,15 +952,14 @@ void send_files(int f_in, int f_out)
 							full_fname(fname));
 				}
 			}
-			close(fd);
+			if (recovery_chain) {
+				delta_chain_close(recovery_chain);
+				recovery_chain = NULL;
+			} else
+				close(fd);
 
 			free_sums(s);
 
-			free(incremental_full_files);
-			free(incremental_delta_files);
-			free(differential_full_files);
-			free(differential_delta_files);
-
 			if (DEBUG_GTE(SEND, 1))
 				rprintf(FINFO, "sender finished %s%s%s\n", path,slash,fname);
 
@@ -1521,6 +969,9 @@ void send_files(int f_in, int f_out)
 		if (make_backups < 0)
 			make_backups = -make_backups;
 
+		if (task_type_backup_or_recovery_sender == 1)
+			prefetch_finish();
+
 		if (io_error != save_io_error && protocol_version >= 30)
 			send_msg_int(MSG_IO_ERROR, io_error);
 
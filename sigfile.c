@@ -0,0 +1,277 @@
+/*
+ * Block-signature sidecars of differential full versions.
+ *
+ * A differential backup sends the block checksums of the newest full
+ * version as its basis, and that full file never changes once written.
+ * With "signature sidecars" enabled the receiver writes those checksums
+ * next to each differential full file when it stores it:
+ *
+ *	<file>.backup/differential/full/<file>.sig.<version>
+ *
+ * and the generator streams them from there instead of reading the
+ * whole full file again for every backup.  A sidecar starts with a
+ * header naming everything its checksums depend on (block length,
+ * checksum type, seed and seed order, plus the size and mtime of the
+ * full file it describes), followed by one record per block: the
+ * rolling checksum and the whole strong checksum, which is cut down to
+ * the transfer's s2length when it is sent.  A sidecar whose header does
+ * not match the transfer is simply not used, and the generator writes a
+ * fresh one while it computes the checksums itself.
+ *
+ * The strong checksums are seeded, so a daemon with sidecars enabled
+ * uses a fixed per-module seed (see signature_seed()) unless the client
+ * asks for one with --checksum-seed.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, visit the http://fsf.org website.
+ */
+
+#include "rsync.h"
+
+#define SIG_MAGIC 0x47535352	/* "RSSG" */
+#define SIG_HEADER_LEN 52
+#define SIG_IO_BUF (256 * 1024)
+
+extern int checksum_seed;
+extern int proper_seed_order;
+extern int xfersum_type;
+
+int signature_sidecars = 0;
+
+struct sig_sidecar {
+	FILE *fp;
+	char *iobuf;
+	int digest_len;
+	int writing;
+	char path[MAXPATHLEN];	/* final name */
+	char tmp[MAXPATHLEN];	/* name being written */
+};
+
+/* The seed a daemon with sidecars uses for module: derived from its
+ * name so that it stays the same from one connection to the next. */
+uint32 signature_seed(const char *module)
+{
+	char digest[MD5_DIGEST_LEN];
+	md_context ctx;
+	uint32 seed;
+
+	md5_begin(&ctx);
+	md5_update(&ctx, (const uchar *)module, strlen(module));
+	md5_result(&ctx, (uchar *)digest);
+	seed = IVAL(digest, 0);
+
+	return seed ? seed : 1;
+}
+
+/* The sidecar name of the full file full_path ("x.full.V" -> "x.sig.V"). */
+static int sidecar_name(const char *full_path, char *buf)
+{
+	const char *slash = strrchr(full_path, '/');
+	const char *base = slash ? slash + 1 : full_path;
+	const char *p, *kind = NULL;
+
+	for (p = base; (p = strstr(p, ".full.")) != NULL; p++)
+		kind = p;
+	if (!kind)
+		return -1;
+
+	return snprintf(buf, MAXPATHLEN, "%.*s.sig.%s", (int)(kind - full_path), full_path,
+			kind + 6) < MAXPATHLEN ? 0 : -1;
+}
+
+static void make_header(char *hdr, const struct sum_struct *sum, const STRUCT_STAT *st, int digest_len)
+{
+	SIVAL(hdr, 0, SIG_MAGIC);
+	SIVAL(hdr, 4, xfersum_type);
+	SIVAL(hdr, 8, checksum_seed);
+	SIVAL(hdr, 12, proper_seed_order);
+	SIVAL(hdr, 16, sum->blength);
+	SIVAL(hdr, 20, digest_len);
+	SIVAL(hdr, 24, sum->count);
+	SIVAL64(hdr, 28, sum->flength);
+	SIVAL64(hdr, 36, st->st_size);
+	SIVAL64(hdr, 44, st->st_mtime);
+}
+
+static struct sig_sidecar *new_sidecar(FILE *fp, int writing)
+{
+	struct sig_sidecar *s = new0(struct sig_sidecar);
+
+	if (!s || !(s->iobuf = new_array(char, SIG_IO_BUF)))
+		out_of_memory("new_sidecar");
+	s->fp = fp;
+	s->writing = writing;
+	s->digest_len = csum_len_for_type(xfersum_type, 0);
+	setvbuf(fp, s->iobuf, _IOFBF, SIG_IO_BUF);
+
+	return s;
+}
+
+static void free_sidecar(struct sig_sidecar *s)
+{
+	if (s->fp)
+		fclose(s->fp);
+	free(s->iobuf);
+	free(s);
+}
+
+/* Open the sidecar of full_path for reading the checksums described by
+ * sum, or return NULL if there is none that matches them. */
+struct sig_sidecar *sig_sidecar_open(const char *full_path, const struct sum_struct *sum)
+{
+	char path[MAXPATHLEN], hdr[SIG_HEADER_LEN], want[SIG_HEADER_LEN];
+	struct sig_sidecar *s;
+	STRUCT_STAT st;
+	FILE *fp;
+
+	if (sidecar_name(full_path, path) < 0 || do_stat(full_path, &st) < 0)
+		return NULL;
+	if (!(fp = fopen(path, "rb")))
+		return NULL;
+	s = new_sidecar(fp, 0);
+
+	make_header(want, sum, &st, s->digest_len);
+	if (fread(hdr, 1, sizeof hdr, fp) != sizeof hdr || memcmp(hdr, want, sizeof hdr) != 0
+	 || s->digest_len < sum->s2length) {
+		free_sidecar(s);
+		return NULL;
+	}
+
+	return s;
+}
+
+/* Read the next block's checksums.  Returns -1 on a short or failed read. */
+int sig_sidecar_read(struct sig_sidecar *s, uint32 *sum1, char *sum2)
+{
+	char buf[4];
+
+	if (fread(buf, 1, 4, s->fp) != 4 || fread(sum2, 1, s->digest_len, s->fp) != (size_t)s->digest_len)
+		return -1;
+	*sum1 = IVAL(buf, 0);
+
+	return 0;
+}
+
+/* Start writing a new sidecar for full_path holding the checksums described
+ * by sum; the records are added with sig_sidecar_add() and the sidecar
+ * only replaces an old one when sig_sidecar_close() finds it complete. */
+struct sig_sidecar *sig_sidecar_create(const char *full_path, const struct sum_struct *sum)
+{
+	char path[MAXPATHLEN], tmp[MAXPATHLEN], hdr[SIG_HEADER_LEN];
+	struct sig_sidecar *s;
+	STRUCT_STAT st;
+	FILE *fp;
+	int fd;
+
+	if (do_stat(full_path, &st) < 0 || sidecar_name(full_path, path) < 0
+	 || snprintf(tmp, sizeof tmp, "%s.XXXXXX", path) >= (int)sizeof tmp
+	 || (fd = do_mkstemp(tmp, 0644)) < 0)
+		return NULL;
+	if (!(fp = fdopen(fd, "wb"))) {
+		close(fd);
+		do_unlink(tmp);
+		return NULL;
+	}
+	s = new_sidecar(fp, 1);
+	strlcpy(s->path, path, sizeof s->path);
+	strlcpy(s->tmp, tmp, sizeof s->tmp);
+
+	make_header(hdr, sum, &st, s->digest_len);
+	fwrite(hdr, 1, sizeof hdr, fp);
+
+	return s;
+}
+
+void sig_sidecar_add(struct sig_sidecar *s, uint32 sum1, const char *sum2)
+{
+	char buf[4];
+
+	SIVAL(buf, 0, sum1);
+	fwrite(buf, 1, 4, s->fp);
+	fwrite(sum2, 1, s->digest_len, s->fp);
+}
+
+/* Finish with a sidecar.  A new one is renamed into place if ok is set and
+ * all of it was written, otherwise removed.  Returns -1 if it was not. */
+int sig_sidecar_close(struct sig_sidecar *s, int ok)
+{
+	int ret = 0;
+
+	if (s->writing) {
+		if (ferror(s->fp))
+			ok = 0;
+		if (fclose(s->fp) != 0)
+			ok = 0;
+		s->fp = NULL;
+		if (!ok || do_rename(s->tmp, s->path) < 0) {
+			do_unlink(s->tmp);
+			ret = -1;
+		}
+	}
+	free_sidecar(s);
+
+	return ret;
+}
+
+/* Write the sidecar of a differential full file the receiver has just
+ * stored, reading it once through its delta chain. */
+int sig_sidecar_write(const char *full_path)
+{
+	struct delta_chain *dc;
+	struct map_struct *mapbuf = NULL;
+	struct sig_sidecar *s;
+	struct sum_struct sum;
+	OFF_T offset = 0, len;
+	int32 i, group;
+
+	if (!signature_sidecars)
+		return 0;
+	if (!(dc = delta_chain_open(full_path, NULL, 0)))
+		return -1;
+	len = dc->size;
+	sum_sizes_sqroot(&sum, len);
+	if (sum.count < 0 || !(s = sig_sidecar_create(full_path, &sum))) {
+		delta_chain_close(dc);
+		return -1;
+	}
+
+	if (len > 0)
+		mapbuf = map_delta_chain(dc, MAX_MAP_SIZE, sum.blength);
+	group = (int32)MAX(1, MIN(MD_LANES, MAX_MAP_SIZE / sum.blength));
+	for (i = 0; i < sum.count; ) {
+		int32 n1 = (int32)MIN(len, (OFF_T)group * sum.blength);
+		char *map = map_ptr(mapbuf, offset, n1);
+		char sum2[MD_LANES * MAX_DIGEST_LEN];
+		uint32 sum1[MD_LANES];
+		int j, cnt = get_block_sums(map, n1, sum.blength, sum1, sum2);
+
+		len -= n1;
+		offset += n1;
+		for (j = 0; j < cnt; j++, i++)
+			sig_sidecar_add(s, sum1[j], sum2 + j * MAX_DIGEST_LEN);
+	}
+	if (mapbuf)
+		unmap_file(mapbuf);
+	delta_chain_close(dc);
+
+	return sig_sidecar_close(s, 1);
+}
+
+/* Remove the sidecar of full_path, if it has one. */
+void sig_sidecar_unlink(const char *full_path)
+{
+	char path[MAXPATHLEN];
+
+	if (sidecar_name(full_path, path) == 0)
+		do_unlink(path);
+}
@@ -0,0 +1,174 @@
+/*
+ * Vectorized block loop of the rolling checksum (get_checksum1()).
+ *
+ * The rolling checksum of a block is s1 = sum of its bytes and s2 = sum
+ * of the running s1 after each byte (both plus CHAR_OFFSET per byte,
+ * modulo 2^32).  Over a run of n bytes b[0..n-1] that is
+ *
+ *	s2 += n * s1 + sum((n - k) * b[k])
+ *	s1 += sum(b[k])
+ *
+ * so a vector unit can take 16 or 32 bytes at a time with one multiply
+ * by the weights n..1 and one plain sum, keeping per-lane partial sums
+ * until the end.  Everything is done modulo 2^32 like the scalar loop,
+ * so the result is bit for bit the same for any length and alignment.
+ *
+ * The AVX2, SSSE3 or SSE2 loop is picked on the first call by asking the
+ * CPU what it supports; anything else (or a compiler without the target
+ * attribute) leaves all of the work to the scalar loop in checksum.c.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, visit the http://fsf.org website.
+ */
+
+#include "rsync.h"
+
+#ifdef SIMD_CHECKSUM
+
+#include <immintrin.h>
+
+typedef int32 (*checksum1_fn)(const schar *buf, int32 len, uint32 *ps1, uint32 *ps2);
+
+static int32 choose_checksum1(const schar *buf, int32 len, uint32 *ps1, uint32 *ps2);
+static checksum1_fn checksum1_blocks = choose_checksum1;
+
+/* Fold the per-lane sums of nblocks blocks of blen bytes into s1 and s2. */
+static inline void fold_sums(uint32 *ps1, uint32 *ps2, int32 nblocks, int32 blen,
+			     const uint32 *s1, const uint32 *prev, const uint32 *s2, int lanes)
+{
+	uint32 sum1 = 0, sum_prev = 0, sum2 = 0, n = (uint32)nblocks * blen;
+	int i;
+
+	for (i = 0; i < lanes; i++) {
+		sum1 += s1[i];
+		sum_prev += prev[i];
+		sum2 += s2[i];
+	}
+	*ps2 += n * *ps1 + blen * sum_prev + sum2
+	      + (n % 2 ? (n + 1) / 2 * n : n / 2 * (n + 1)) * CHAR_OFFSET;
+	*ps1 += sum1 + n * CHAR_OFFSET;
+}
+
+__attribute__((target("sse2")))
+static int32 checksum1_sse2(const schar *buf, int32 len, uint32 *ps1, uint32 *ps2)
+{
+	const __m128i ones = _mm_set1_epi16(1);
+	const __m128i w_lo = _mm_setr_epi16(16, 15, 14, 13, 12, 11, 10, 9);
+	const __m128i w_hi = _mm_setr_epi16(8, 7, 6, 5, 4, 3, 2, 1);
+	__m128i s1 = _mm_setzero_si128(), prev = s1, s2 = s1;
+	uint32 l1[4], lp[4], l2[4];
+	int32 i, nblocks = len / 16;
+
+	for (i = 0; i < nblocks; i++) {
+		__m128i x = _mm_loadu_si128((const __m128i *)(buf + i * 16));
+		/* sign-extend the bytes to 16 bits */
+		__m128i lo = _mm_srai_epi16(_mm_unpacklo_epi8(x, x), 8);
+		__m128i hi = _mm_srai_epi16(_mm_unpackhi_epi8(x, x), 8);
+
+		prev = _mm_add_epi32(prev, s1);
+		s1 = _mm_add_epi32(s1, _mm_add_epi32(_mm_madd_epi16(lo, ones), _mm_madd_epi16(hi, ones)));
+		s2 = _mm_add_epi32(s2, _mm_add_epi32(_mm_madd_epi16(lo, w_lo), _mm_madd_epi16(hi, w_hi)));
+	}
+	_mm_storeu_si128((__m128i *)l1, s1);
+	_mm_storeu_si128((__m128i *)lp, prev);
+	_mm_storeu_si128((__m128i *)l2, s2);
+	fold_sums(ps1, ps2, nblocks, 16, l1, lp, l2, 4);
+
+	return nblocks * 16;
+}
+
+__attribute__((target("ssse3")))
+static int32 checksum1_ssse3(const schar *buf, int32 len, uint32 *ps1, uint32 *ps2)
+{
+	const __m128i ones8 = _mm_set1_epi8(1), ones16 = _mm_set1_epi16(1);
+	const __m128i weights = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+	__m128i s1 = _mm_setzero_si128(), prev = s1, s2 = s1;
+	uint32 l1[4], lp[4], l2[4];
+	int32 i, nblocks = len / 16;
+
+	for (i = 0; i < nblocks; i++) {
+		__m128i x = _mm_loadu_si128((const __m128i *)(buf + i * 16));
+
+		/* unsigned weights times signed bytes, summed in pairs */
+		prev = _mm_add_epi32(prev, s1);
+		s1 = _mm_add_epi32(s1, _mm_madd_epi16(_mm_maddubs_epi16(ones8, x), ones16));
+		s2 = _mm_add_epi32(s2, _mm_madd_epi16(_mm_maddubs_epi16(weights, x), ones16));
+	}
+	_mm_storeu_si128((__m128i *)l1, s1);
+	_mm_storeu_si128((__m128i *)lp, prev);
+	_mm_storeu_si128((__m128i *)l2, s2);
+	fold_sums(ps1, ps2, nblocks, 16, l1, lp, l2, 4);
+
+	return nblocks * 16;
+}
+
+__attribute__((target("avx2")))
+static int32 checksum1_avx2(const schar *buf, int32 len, uint32 *ps1, uint32 *ps2)
+{
+	const __m256i ones8 = _mm256_set1_epi8(1), ones16 = _mm256_set1_epi16(1);
+	const __m256i weights = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21,
+						 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9,
+						 8, 7, 6, 5, 4, 3, 2, 1);
+	__m256i s1 = _mm256_setzero_si256(), prev = s1, s2 = s1;
+	uint32 l1[8], lp[8], l2[8];
+	int32 i, nblocks = len / 32;
+
+	for (i = 0; i < nblocks; i++) {
+		__m256i x = _mm256_loadu_si256((const __m256i *)(buf + i * 32));
+
+		prev = _mm256_add_epi32(prev, s1);
+		s1 = _mm256_add_epi32(s1, _mm256_madd_epi16(_mm256_maddubs_epi16(ones8, x), ones16));
+		s2 = _mm256_add_epi32(s2, _mm256_madd_epi16(_mm256_maddubs_epi16(weights, x), ones16));
+	}
+	_mm256_storeu_si256((__m256i *)l1, s1);
+	_mm256_storeu_si256((__m256i *)lp, prev);
+	_mm256_storeu_si256((__m256i *)l2, s2);
+	fold_sums(ps1, ps2, nblocks, 32, l1, lp, l2, 8);
+
+	return nblocks * 32;
+}
+
+static int32 checksum1_none(UNUSED(const schar *buf), UNUSED(int32 len),
+			    UNUSED(uint32 *ps1), UNUSED(uint32 *ps2))
+{
+	return 0;
+}
+
+/* The first call picks the loop the CPU can run; the choice is the same
+ * whichever thread makes it. */
+static int32 choose_checksum1(const schar *buf, int32 len, uint32 *ps1, uint32 *ps2)
+{
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		checksum1_blocks = checksum1_avx2;
+	else if (__builtin_cpu_supports("ssse3"))
+		checksum1_blocks = checksum1_ssse3;
+	else if (__builtin_cpu_supports("sse2"))
+		checksum1_blocks = checksum1_sse2;
+	else
+		checksum1_blocks = checksum1_none;
+
+	return checksum1_blocks(buf, len, ps1, ps2);
+}
+
+/* Add the whole vector-sized blocks at the start of buf to the rolling
+ * sums *ps1 and *ps2 and return how many bytes that was; the caller
+ * does the rest. */
+int32 get_checksum1_blocks(const schar *buf, int32 len, uint32 *ps1, uint32 *ps2)
+{
+	if (len < 32)
+		return 0;
+	return checksum1_blocks(buf, len, ps1, ps2);
+}
+
+#endif
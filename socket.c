@@ -847,7 +847,9 @@ static int sock_exec(const char *prog)
 			fprintf(stderr, "Failed to run \"%s\"\n", prog);
 			exit(1);
 		}
-		exit(system(prog));
+		/* _exit(): flushing the stdio buffers we inherited
+		 * would write them down the socket. */
+		_exit(system(prog));
 	}
 
 	close(fd[1]);
@@ -0,0 +1,259 @@
+/*
+ * Checksum workers: forked processes that compute the block checksums
+ * the generator sends for a large basis file.
+ *
+ * generate_and_send_sums() otherwise reads the basis through one
+ * map_struct and computes sum1 and sum2 of every block itself, so a
+ * big backup image is checksummed by a single core while the sender
+ * waits.  With "checksum workers" set, the generator hands each file
+ * of more than SUM_STRIPE_BLOCKS blocks to a pool of workers instead.
+ * The blocks are dealt out in stripes of SUM_STRIPE_BLOCKS: worker w
+ * does stripes w, w + n, w + 2n, ..., reading the basis through its
+ * own map_struct (or delta chain), and the generator reads the stripes
+ * back in block order.  A worker can only run as far ahead as its pipe
+ * holds, so the memory this takes stays bounded.
+ *
+ * A job is a 24-byte header (file length, block length, block count,
+ * whether the basis is a delta chain, path length) and the path, sent
+ * to every worker; each answers with 20 bytes per block of its
+ * stripes (sum1, then SUM_LENGTH bytes of sum2).  If a worker fails,
+ * the pool is shut down and the generator computes the rest itself.
+ */
+
+#include "rsync.h"
+
+extern int msgs2stderr;
+
+int checksum_workers = 0;
+
+#define SUM_STRIPE_BLOCKS 1024
+#define SUM_MAX_WORKERS 32
+#define SUM_RECORD_LEN (4 + SUM_LENGTH)
+#define SUM_JOB_HEAD 24
+
+static struct {
+	int started, nworkers;
+	pid_t pids[SUM_MAX_WORKERS];
+	int job_fds[SUM_MAX_WORKERS];
+	int result_fds[SUM_MAX_WORKERS];
+} sw;
+
+/* The current file. */
+static struct {
+	int32 count, next;	/* blocks in the file, the next to be read */
+	int32 avail;		/* records left in buf */
+	char *pos, buf[SUM_STRIPE_BLOCKS * SUM_RECORD_LEN];
+} job;
+
+static int read_full(int fd, char *buf, size_t len)
+{
+	while (len > 0) {
+		ssize_t n = read(fd, buf, len);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return -1;
+		buf += n;
+		len -= n;
+	}
+	return 0;
+}
+
+/* Checksum the blocks of stripes w, w + nworkers, ... of one file. */
+static int worker_job(int w, int nworkers, int out_fd, const char *path, int chain,
+		      OFF_T flength, int32 blength, int32 count)
+{
+	struct delta_chain *dc = NULL;
+	struct map_struct *mapbuf;
+	int32 group = (int32)MAX(1, MIN(MD_LANES, MAX_MAP_SIZE / blength));
+	int32 stripe;
+	int fd = -1, ret = 0;
+
+	if (chain) {
+		if (!(dc = delta_chain_open(path, NULL, 0)))
+			return -1;
+		mapbuf = map_delta_chain(dc, MAX_MAP_SIZE, blength);
+	} else {
+		if ((fd = do_open(path, O_RDONLY, 0)) < 0)
+			return -1;
+		mapbuf = map_file(fd, flength, MAX_MAP_SIZE, blength);
+	}
+
+	for (stripe = w; ret == 0 && (OFF_T)stripe * SUM_STRIPE_BLOCKS < count; stripe += nworkers) {
+		int32 i = stripe * SUM_STRIPE_BLOCKS, last = MIN(count, i + SUM_STRIPE_BLOCKS);
+		char *rec = job.buf;
+
+		while (i < last) {
+			OFF_T offset = (OFF_T)i * blength;
+			int32 len = (int32)MIN(flength - offset, (OFF_T)MIN(group, last - i) * blength);
+			char sum2[MD_LANES * MAX_DIGEST_LEN];
+			uint32 sum1[MD_LANES];
+			int j, cnt = get_block_sums(map_ptr(mapbuf, offset, len), len, blength, sum1, sum2);
+
+			for (j = 0; j < cnt; j++, rec += SUM_RECORD_LEN) {
+				SIVAL(rec, 0, sum1[j]);
+				memcpy(rec + 4, sum2 + j * MAX_DIGEST_LEN, SUM_LENGTH);
+			}
+			i += cnt;
+		}
+		if (full_write(out_fd, job.buf, rec - job.buf) != rec - job.buf)
+			ret = -1;
+	}
+
+	unmap_file(mapbuf);
+	if (dc)
+		delta_chain_close(dc);
+	else
+		close(fd);
+
+	return ret;
+}
+
+static NORETURN void worker_main(int w, int nworkers, int in_fd, int out_fd)
+{
+	char head[SUM_JOB_HEAD], path[MAXPATHLEN];
+	int32 blength, count, path_len;
+
+	/* Our messages must not interleave with the generator's multiplexed
+	 * stream, so send them to stderr or the daemon log instead. */
+	msgs2stderr = 1;
+
+	while (read_full(in_fd, head, sizeof head) == 0) {
+		blength = IVAL(head, 8);
+		count = IVAL(head, 12);
+		path_len = IVAL(head, 20);
+		if (blength <= 0 || path_len <= 0 || path_len >= MAXPATHLEN
+		 || read_full(in_fd, path, path_len) < 0)
+			_exit(RERR_IPC);
+		path[path_len] = '\0';
+		if (worker_job(w, nworkers, out_fd, path, IVAL(head, 16),
+			       (OFF_T)IVAL64(head, 0), blength, count) < 0)
+			_exit(RERR_FILEIO);
+	}
+
+	_exit(0);
+}
+
+static void start_workers(void)
+{
+	int i;
+
+	sw.started = 1;
+	if (checksum_workers <= 1)
+		return;
+
+	for (i = 0; i < MIN(checksum_workers, SUM_MAX_WORKERS); i++) {
+		int jobs[2], results[2];
+		if (pipe(jobs) < 0)
+			break;
+		if (pipe(results) < 0) {
+			close(jobs[0]);
+			close(jobs[1]);
+			break;
+		}
+		if ((sw.pids[i] = do_fork()) < 0) {
+			close(jobs[0]);
+			close(jobs[1]);
+			close(results[0]);
+			close(results[1]);
+			break;
+		}
+		if (sw.pids[i] == 0) {
+			int j;
+			for (j = 0; j < i; j++) {
+				close(sw.job_fds[j]);
+				close(sw.result_fds[j]);
+			}
+			close(jobs[1]);
+			close(results[0]);
+			worker_main(i, MIN(checksum_workers, SUM_MAX_WORKERS), jobs[0], results[1]);
+		}
+		close(jobs[0]);
+		close(results[1]);
+		sw.job_fds[i] = jobs[1];
+		sw.result_fds[i] = results[0];
+	}
+	sw.nworkers = i;
+
+	/* Every worker was told how many there would be. */
+	if (sw.nworkers < MIN(checksum_workers, SUM_MAX_WORKERS))
+		sum_workers_finish();
+}
+
+/* Start the checksums of the count blocks of blength bytes in the basis
+ * path (a delta chain if chain is set, else a plain file of flength
+ * bytes).  Returns 0 if the workers took the file, after which
+ * sum_workers_read() must be called count times, or -1 if the caller
+ * should compute the checksums itself. */
+int sum_workers_begin(const char *path, int chain, OFF_T flength, int32 blength, int32 count)
+{
+	char head[SUM_JOB_HEAD];
+	int32 path_len = strlen(path);
+	int w;
+
+	if (!sw.started)
+		start_workers();
+	if (!sw.nworkers || count <= SUM_STRIPE_BLOCKS || path_len >= MAXPATHLEN)
+		return -1;
+
+	SIVAL64(head, 0, flength);
+	SIVAL(head, 8, blength);
+	SIVAL(head, 12, count);
+	SIVAL(head, 16, chain);
+	SIVAL(head, 20, path_len);
+	for (w = 0; w < sw.nworkers; w++) {
+		if (full_write(sw.job_fds[w], head, sizeof head) != sizeof head
+		 || full_write(sw.job_fds[w], path, path_len) != path_len) {
+			sum_workers_finish();
+			return -1;
+		}
+	}
+
+	job.count = count;
+	job.next = job.avail = 0;
+
+	return 0;
+}
+
+/* Get the checksums of the next block of the current file.  On an error
+ * the pool is shut down and -1 returned; the caller computes this block
+ * and the rest itself. */
+int sum_workers_read(uint32 *sum1, char *sum2)
+{
+	if (!job.avail) {
+		int32 cnt = MIN(SUM_STRIPE_BLOCKS, job.count - job.next);
+		int w = (job.next / SUM_STRIPE_BLOCKS) % sw.nworkers;
+
+		if (read_full(sw.result_fds[w], job.buf, cnt * SUM_RECORD_LEN) < 0) {
+			rprintf(FWARNING, "[yee-%s] sumworkers.c: checksum worker %d failed\n", who_am_i(), w);
+			sum_workers_finish();
+			return -1;
+		}
+		job.avail = cnt;
+		job.pos = job.buf;
+	}
+
+	*sum1 = IVAL(job.pos, 0);
+	memcpy(sum2, job.pos + 4, SUM_LENGTH);
+	job.pos += SUM_RECORD_LEN;
+	job.avail--;
+	job.next++;
+
+	return 0;
+}
+
+/* Shut the pool down; nothing more is handed to it. */
+void sum_workers_finish(void)
+{
+	int w, status;
+
+	for (w = 0; w < sw.nworkers; w++) {
+		close(sw.job_fds[w]);
+		close(sw.result_fds[w]);
+	}
+	/* A worker still writing a file's checksums gets EPIPE and exits. */
+	for (w = 0; w < sw.nworkers; w++)
+		wait_process(sw.pids[w], &status, 0);
+	sw.started = 1;
+	sw.nworkers = 0;
+}
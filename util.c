@@ -531,7 +531,7 @@ int robust_rename(const char *from, const char *to, const char *partialptr,
 	return -1;
 }
 
-static pid_t all_pids[10];
+static pid_t all_pids[64];
 static int num_pids;
 
 /** Fork and record the pid of the child. **/
@@ -539,7 +539,8 @@ pid_t do_fork(void)
 {
 	pid_t newpid = fork();
 
-	if (newpid != 0  &&  newpid != -1) {
+	/* The worker pools fork more children than rsync itself does. */
+	if (newpid != 0  &&  newpid != -1  &&  num_pids < (int)(sizeof all_pids / sizeof all_pids[0])) {
 		all_pids[num_pids++] = newpid;
 	}
 	return newpid;
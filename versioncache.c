@@ -0,0 +1,237 @@
+/*
+ * A size-bounded cache of rebuilt versions ("version cache" in
+ * rsyncd.conf), so that restoring the same version again is a plain
+ * file read instead of another replay of its delta chain.
+ *
+ * The cache directory has a subdirectory per file, named by the MD5 of
+ * the file's absolute path, holding one plain copy per version:
+ *
+ *	<cache>/<md5 of path>/<md5 of version and chain fingerprint>
+ *
+ * The fingerprint (see delta_chain_fingerprint()) covers the backup files
+ * the chain was built from, so a copy made before retention rebuilt or
+ * removed them is never served; retention run by the daemon also drops
+ * the file's whole subdirectory.  A hit sets the copy's mtime to now,
+ * and whenever a copy is added the least recently used ones are removed
+ * until the cache fits in "version cache size" megabytes again.
+ *
+ * Copies are written to a temporary name and renamed into place, so
+ * several daemons can share a cache; one that evicts a copy someone is
+ * still reading only takes the name away.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, visit the http://fsf.org website.
+ */
+
+#include "rsync.h"
+
+extern char curr_dir[MAXPATHLEN];
+
+static char cache_dir[MAXPATHLEN];	/* absolute, "" when there is no cache */
+static OFF_T cache_limit;
+
+struct cache_entry {
+	time_t mtime;
+	OFF_T size;
+	char *path;
+};
+
+/* Called by a daemon once it is in the module's directory; dir is the
+ * "version cache" parameter, relative to the module unless absolute. */
+void version_cache_setup(const char *dir, int size_mb)
+{
+	extern char *module_dir;
+
+	if (!dir || !*dir || size_mb <= 0)
+		return;
+	if (*dir == '/')
+		strlcpy(cache_dir, dir, sizeof cache_dir);
+	else
+		pathjoin(cache_dir, sizeof cache_dir, module_dir, dir);
+	cache_limit = (OFF_T)size_mb * 1024 * 1024;
+}
+
+static void hex_digest(char *buf, const char *digest)
+{
+	int i;
+
+	for (i = 0; i < MD5_DIGEST_LEN; i++)
+		sprintf(buf + i * 2, "%02x", (uchar)digest[i]);
+}
+
+/* The subdirectory of fname (relative to the current directory). */
+static int file_dir(const char *fname, char *buf)
+{
+	char path[MAXPATHLEN], digest[MD5_DIGEST_LEN], hex[MD5_DIGEST_LEN * 2 + 1];
+	md_context ctx;
+
+	if (*fname == '/')
+		strlcpy(path, fname, sizeof path);
+	else if (pathjoin(path, sizeof path, curr_dir, fname) >= sizeof path)
+		return -1;
+	clean_fname(path, CFN_COLLAPSE_DOT_DOT_DIRS);
+
+	md5_begin(&ctx);
+	md5_update(&ctx, (const uchar *)path, strlen(path));
+	md5_result(&ctx, (uchar *)digest);
+	hex_digest(hex, digest);
+
+	return pathjoin(buf, MAXPATHLEN, cache_dir, hex) < MAXPATHLEN ? 0 : -1;
+}
+
+static int entry_cmp(const void *a, const void *b)
+{
+	const struct cache_entry *x = a, *y = b;
+
+	return x->mtime < y->mtime ? -1 : x->mtime > y->mtime;
+}
+
+/* Remove the least recently used copies until the cache fits. */
+static void evict(void)
+{
+	struct cache_entry *entries = NULL;
+	int count = 0, malloced = 0, i;
+	char path[MAXPATHLEN];
+	struct dirent *di, *fi;
+	OFF_T total = 0;
+	DIR *d, *f;
+
+	if (!(d = opendir(cache_dir)))
+		return;
+	while ((di = readdir(d)) != NULL) {
+		if (*di->d_name == '.')
+			continue;
+		pathjoin(path, sizeof path, cache_dir, di->d_name);
+		if (!(f = opendir(path)))
+			continue;
+		while ((fi = readdir(f)) != NULL) {
+			char entry[MAXPATHLEN];
+			STRUCT_STAT st;
+			if (*fi->d_name == '.')
+				continue;
+			pathjoin(entry, sizeof entry, path, fi->d_name);
+			if (do_stat(entry, &st) < 0 || !S_ISREG(st.st_mode))
+				continue;
+			if (count == malloced) {
+				malloced = malloced ? malloced * 2 : 64;
+				if (!(entries = realloc_array(entries, struct cache_entry, malloced)))
+					out_of_memory("version cache");
+			}
+			entries[count].mtime = st.st_mtime;
+			entries[count].size = st.st_size;
+			if (!(entries[count].path = strdup(entry)))
+				out_of_memory("version cache");
+			total += st.st_size;
+			count++;
+		}
+		closedir(f);
+	}
+	closedir(d);
+
+	qsort(entries, count, sizeof entries[0], entry_cmp);
+	for (i = 0; i < count; i++) {
+		if (total > cache_limit && do_unlink(entries[i].path) == 0) {
+			char *slash = strrchr(entries[i].path, '/');
+			total -= entries[i].size;
+			*slash = '\0';
+			rmdir(entries[i].path);
+		}
+		free(entries[i].path);
+	}
+	if (entries)
+		free(entries);
+}
+
+/* Take dc, the chain of version of fname, and return the chain to read
+ * it through: a cached copy if there is one, otherwise (after adding a
+ * copy to the cache) one over the new copy.  dc itself comes back when
+ * there is no cache, when its version is just a stretch of one plain
+ * file anyway, or when it can't be cached. */
+struct delta_chain *version_cache_open(const char *fname, const char *version, struct delta_chain *dc)
+{
+	char dir[MAXPATHLEN], path[MAXPATHLEN], tmp[MAXPATHLEN];
+	char digest[MD5_DIGEST_LEN], hex[MD5_DIGEST_LEN * 2 + 1];
+	struct delta_chain *cached;
+	md_context ctx;
+	int fd;
+
+	if (!*cache_dir || !dc || dc->dfs || dc->size > cache_limit
+	 || (dc->nsrc == 1 && !dc->list && !dc->zfs[0]))
+		return dc;
+	if (file_dir(fname, dir) < 0)
+		return dc;
+
+	delta_chain_fingerprint(dc, digest);
+	md5_begin(&ctx);
+	md5_update(&ctx, (const uchar *)version, strlen(version) + 1);
+	md5_update(&ctx, (const uchar *)digest, MD5_DIGEST_LEN);
+	md5_result(&ctx, (uchar *)digest);
+	hex_digest(hex, digest);
+	if (pathjoin(path, sizeof path, dir, hex) >= sizeof path)
+		return dc;
+
+	if (access(path, F_OK) == 0 && (cached = delta_chain_open_file(path)) != NULL) {
+		if (cached->size == dc->size) {
+			utimes(path, NULL);
+			rprintf(FWARNING, "[yee-%s] versioncache.c: %s %s served from the cache\n",
+				who_am_i(), fname, version);
+			delta_chain_close(dc);
+			return cached;
+		}
+		delta_chain_close(cached);
+		do_unlink(path);
+	}
+
+	if ((do_mkdir(cache_dir, 0700) < 0 && errno != EEXIST)
+	 || (do_mkdir(dir, 0700) < 0 && errno != EEXIST)) {
+		rsyserr(FWARNING, errno, "version cache %s", dir);
+		return dc;
+	}
+	if (snprintf(tmp, sizeof tmp, "%s/.%s.XXXXXX", dir, hex) >= (int)sizeof tmp)
+		return dc;
+	if ((fd = do_mkstemp(tmp, 0600)) < 0) {
+		rsyserr(FWARNING, errno, "version cache %s", tmp);
+		return dc;
+	}
+	close(fd);
+	if (delta_chain_extract(dc, tmp) < 0 || do_rename(tmp, path) < 0) {
+		do_unlink(tmp);
+		return dc;
+	}
+	evict();
+
+	if (!(cached = delta_chain_open_file(path)))
+		return dc;
+	delta_chain_close(dc);
+
+	return cached;
+}
+
+/* Called when retention has changed fname's versions. */
+void version_cache_invalidate(const char *fname)
+{
+	char dir[MAXPATHLEN], path[MAXPATHLEN];
+	struct dirent *di;
+	DIR *d;
+
+	if (!*cache_dir || file_dir(fname, dir) < 0 || !(d = opendir(dir)))
+		return;
+	while ((di = readdir(d)) != NULL) {
+		if (strcmp(di->d_name, ".") == 0 || strcmp(di->d_name, "..") == 0)
+			continue;
+		pathjoin(path, sizeof path, dir, di->d_name);
+		do_unlink(path);
+	}
+	closedir(d);
+	rmdir(dir);
+}
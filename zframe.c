@@ -0,0 +1,353 @@
+/*
+ * Seekable compressed storage for the files kept in <file>.backup/
+ * ("backup compression" in rsyncd.conf).
+ *
+ * A compressed full version or delta is cut into frames of ZFRAME_SIZE
+ * bytes (the last one may be shorter), each deflated on its own, and
+ * ends with an index of where every frame starts.  A read at any offset
+ * inflates only the frames it touches, so delta chains and map_ptr()
+ * keep their random access:
+ *
+ *	magic		4 bytes, "RSZF"
+ *	version		1 byte, ZFRAME_VERSION
+ *	reserved	3 bytes
+ *	frame_size	4 bytes, little-endian
+ *	reserved	4 bytes
+ *	frames		raw deflate data, or the bytes as they are for a
+ *			frame that deflate could not shrink
+ *	index		one entry per frame:
+ *			  offset 8 bytes, stored length 4, flags 4
+ *	trailer		index_offset 8, file_size 8, frame count 4, "RSZI"
+ *
+ * A file without the magic is read as it is, so backups written before
+ * (or without) the parameter need nothing special.  The caller owns the
+ * file descriptor in both directions.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, visit the http://fsf.org website.
+ */
+
+#include "rsync.h"
+#include <zlib.h>
+
+#define ZFRAME_MAGIC "RSZF"
+#define ZFRAME_INDEX_MAGIC "RSZI"
+#define ZFRAME_VERSION 1
+#define ZFRAME_HEADER_LEN 16
+#define ZFRAME_ENTRY_LEN 16
+#define ZFRAME_TRAILER_LEN 24
+#define ZFRAME_SIZE (64*1024)
+#define ZFRAME_SIZE_MAX (16*1024*1024)
+
+#define ZFRAME_STORED 0x01	/* frame kept uncompressed */
+
+/* The deflate level for new backup files; 0 writes them plain. */
+int backup_compression = 0;
+
+struct zframe_entry {
+	OFF_T offset;		/* where the frame starts in the file */
+	int32 len;		/* its stored length */
+	int32 flags;
+};
+
+static int read_at(int fd, OFF_T offset, char *buf, int32 len)
+{
+	if (do_lseek(fd, offset, SEEK_SET) != offset)
+		return -1;
+	while (len > 0) {
+		int32 n = read(fd, buf, len);
+		if (n <= 0) {
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n == 0)
+				errno = ENODATA;
+			return -1;
+		}
+		buf += n;
+		len -= n;
+	}
+	return 0;
+}
+
+static void add_frame(struct zframe_file *zf, OFF_T offset, int32 len, int32 flags)
+{
+	if (zf->count == zf->malloced) {
+		zf->malloced = zf->malloced ? zf->malloced * 2 : 64;
+		if (!(zf->index = realloc_array(zf->index, struct zframe_entry, zf->malloced)))
+			out_of_memory("add_frame");
+	}
+	zf->index[zf->count].offset = offset;
+	zf->index[zf->count].len = len;
+	zf->index[zf->count].flags = flags;
+	zf->count++;
+}
+
+/* Start a compressed file on fd, which must be empty.  Returns NULL
+ * (with errno set) if the header can't be written. */
+struct zframe_file *zframe_create(int fd, int level)
+{
+	struct zframe_file *zf;
+	char buf[ZFRAME_HEADER_LEN];
+	z_stream *zs;
+
+	memset(buf, 0, sizeof buf);
+	memcpy(buf, ZFRAME_MAGIC, 4);
+	CVAL(buf, 4) = ZFRAME_VERSION;
+	SIVAL(buf, 8, ZFRAME_SIZE);
+	if (full_write(fd, buf, sizeof buf) != sizeof buf)
+		return NULL;
+
+	if (!(zf = new0(struct zframe_file))
+	 || !(zf->frame = new_array(char, ZFRAME_SIZE))
+	 || !(zf->zbuf = new_array(char, ZFRAME_SIZE))
+	 || !(zs = new0(z_stream)))
+		out_of_memory("zframe_create");
+	if (level < 1 || level > 9)
+		level = Z_DEFAULT_COMPRESSION;
+	if (deflateInit2(zs, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		out_of_memory("zframe_create");
+	zf->zs = zs;
+	zf->fd = fd;
+	zf->writing = 1;
+	zf->frame_size = ZFRAME_SIZE;
+	zf->pos = ZFRAME_HEADER_LEN;
+
+	return zf;
+}
+
+/* Compress the pending frame and append it to the file.  A frame that
+ * deflate can't fit in fewer bytes than it already has is stored. */
+static int flush_frame(struct zframe_file *zf)
+{
+	z_stream *zs = zf->zs;
+	const char *data = zf->zbuf;
+	int32 len, flags = 0;
+
+	if (!zf->frame_len)
+		return 0;
+
+	deflateReset(zs);
+	zs->next_in = (Bytef *)zf->frame;
+	zs->avail_in = zf->frame_len;
+	zs->next_out = (Bytef *)zf->zbuf;
+	zs->avail_out = zf->frame_len - 1;
+	if (deflate(zs, Z_FINISH) == Z_STREAM_END)
+		len = (int32)zs->total_out;
+	else {
+		data = zf->frame;
+		len = zf->frame_len;
+		flags = ZFRAME_STORED;
+	}
+
+	if (full_write(zf->fd, data, len) != len)
+		return -1;
+	add_frame(zf, zf->pos, len, flags);
+	zf->pos += len;
+	zf->size += zf->frame_len;
+	zf->frame_len = 0;
+
+	return 0;
+}
+
+int zframe_write(struct zframe_file *zf, const char *buf, int32 len)
+{
+	while (len > 0) {
+		int32 n = MIN(len, zf->frame_size - zf->frame_len);
+		memcpy(zf->frame + zf->frame_len, buf, n);
+		zf->frame_len += n;
+		buf += n;
+		len -= n;
+		if (zf->frame_len == zf->frame_size && flush_frame(zf) < 0)
+			return -1;
+	}
+	return 0;
+}
+
+/* Finish a file being written (the last frame, the index and the
+ * trailer) or forget one being read.  The fd is left open. */
+int zframe_close(struct zframe_file *zf)
+{
+	int ret = 0;
+
+	if (zf->writing) {
+		char buf[ZFRAME_TRAILER_LEN];
+		int32 i;
+
+		if (flush_frame(zf) < 0)
+			ret = -1;
+		for (i = 0; ret == 0 && i < zf->count; i++) {
+			SIVAL64(buf, 0, (int64)zf->index[i].offset);
+			SIVAL(buf, 8, zf->index[i].len);
+			SIVAL(buf, 12, zf->index[i].flags);
+			if (full_write(zf->fd, buf, ZFRAME_ENTRY_LEN) != ZFRAME_ENTRY_LEN)
+				ret = -1;
+		}
+		SIVAL64(buf, 0, (int64)zf->pos);
+		SIVAL64(buf, 8, (int64)zf->size);
+		SIVAL(buf, 16, zf->count);
+		memcpy(buf + 20, ZFRAME_INDEX_MAGIC, 4);
+		if (ret == 0 && full_write(zf->fd, buf, sizeof buf) != sizeof buf)
+			ret = -1;
+		deflateEnd(zf->zs);
+	} else if (zf->zs)
+		inflateEnd(zf->zs);
+
+	if (zf->zs)
+		free(zf->zs);
+	if (zf->index)
+		free(zf->index);
+	if (zf->frame)
+		free(zf->frame);
+	if (zf->zbuf)
+		free(zf->zbuf);
+	free(zf);
+
+	return ret;
+}
+
+/* Check whether the file open on fd is compressed and, if it is, read
+ * its index into *zfp.  Returns 1 if it is, 0 if it is a plain file, and
+ * -1 (after reporting the problem) if it is damaged. */
+int zframe_open(const char *fname, int fd, struct zframe_file **zfp)
+{
+	char buf[ZFRAME_TRAILER_LEN];
+	struct zframe_file *zf;
+	OFF_T index_offset, size, end = ZFRAME_HEADER_LEN;
+	int32 frame_size, count, i;
+	STRUCT_STAT st;
+
+	if (do_fstat(fd, &st) < 0) {
+		rsyserr(FERROR_XFER, errno, "fstat %s", full_fname(fname));
+		return -1;
+	}
+	if (st.st_size < ZFRAME_HEADER_LEN + ZFRAME_TRAILER_LEN
+	 || read_at(fd, 0, buf, ZFRAME_HEADER_LEN) < 0
+	 || memcmp(buf, ZFRAME_MAGIC, 4) != 0)
+		return 0;
+
+	if (CVAL(buf, 4) > ZFRAME_VERSION) {
+		rprintf(FERROR_XFER, "%s: compressed file version %d is newer than this rsync supports\n",
+			full_fname(fname), CVAL(buf, 4));
+		return -1;
+	}
+	frame_size = IVAL(buf, 8);
+
+	if (read_at(fd, st.st_size - ZFRAME_TRAILER_LEN, buf, ZFRAME_TRAILER_LEN) < 0)
+		goto damaged;
+	index_offset = (OFF_T)IVAL64(buf, 0);
+	size = (OFF_T)IVAL64(buf, 8);
+	count = IVAL(buf, 16);
+	if (memcmp(buf + 20, ZFRAME_INDEX_MAGIC, 4) != 0
+	 || frame_size <= 0 || frame_size > ZFRAME_SIZE_MAX || size < 0 || count < 0
+	 || (OFF_T)count != (size + frame_size - 1) / frame_size
+	 || index_offset + (OFF_T)count * ZFRAME_ENTRY_LEN + ZFRAME_TRAILER_LEN != st.st_size)
+		goto damaged;
+
+	if (!(zf = new0(struct zframe_file)))
+		out_of_memory("zframe_open");
+	zf->fd = fd;
+	zf->size = size;
+	zf->frame_size = frame_size;
+	zf->cur = -1;
+	for (i = 0; i < count; i++) {
+		int32 len, flags, raw_len = i < count - 1 ? frame_size : (int32)(size - (OFF_T)i * frame_size);
+		OFF_T offset;
+		if (read_at(fd, index_offset + (OFF_T)i * ZFRAME_ENTRY_LEN, buf, ZFRAME_ENTRY_LEN) < 0) {
+			zframe_close(zf);
+			goto damaged;
+		}
+		offset = (OFF_T)IVAL64(buf, 0);
+		len = IVAL(buf, 8);
+		flags = IVAL(buf, 12);
+		if (offset != end || len < 0 || len > raw_len
+		 || (flags & ZFRAME_STORED && len != raw_len)) {
+			zframe_close(zf);
+			goto damaged;
+		}
+		add_frame(zf, offset, len, flags);
+		end += len;
+	}
+	if (end != index_offset) {
+		zframe_close(zf);
+		goto damaged;
+	}
+	*zfp = zf;
+
+	return 1;
+
+  damaged:
+	rprintf(FERROR_XFER, "%s: damaged compressed file\n", full_fname(fname));
+	return -1;
+}
+
+/* Make frame i the one held uncompressed in zf->frame. */
+static int load_frame(struct zframe_file *zf, int32 i)
+{
+	struct zframe_entry *e = zf->index + i;
+	int32 raw_len = i < zf->count - 1 ? zf->frame_size : (int32)(zf->size - (OFF_T)i * zf->frame_size);
+	z_stream *zs;
+
+	if (!zf->frame) {
+		if (!(zf->frame = new_array(char, zf->frame_size))
+		 || !(zf->zbuf = new_array(char, zf->frame_size))
+		 || !(zs = new0(z_stream)))
+			out_of_memory("load_frame");
+		if (inflateInit2(zs, -15) != Z_OK)
+			out_of_memory("load_frame");
+		zf->zs = zs;
+	}
+	zf->cur = -1;
+
+	if (e->flags & ZFRAME_STORED) {
+		if (read_at(zf->fd, e->offset, zf->frame, raw_len) < 0)
+			return -1;
+	} else {
+		if (read_at(zf->fd, e->offset, zf->zbuf, e->len) < 0)
+			return -1;
+		zs = zf->zs;
+		inflateReset(zs);
+		zs->next_in = (Bytef *)zf->zbuf;
+		zs->avail_in = e->len;
+		zs->next_out = (Bytef *)zf->frame;
+		zs->avail_out = raw_len;
+		if (inflate(zs, Z_FINISH) != Z_STREAM_END || zs->total_out != (uLong)raw_len) {
+			errno = EIO;
+			return -1;
+		}
+	}
+	zf->frame_len = raw_len;
+	zf->cur = i;
+
+	return 0;
+}
+
+/* Read up to len bytes of the uncompressed data at offset.  Returns the
+ * number of bytes read (short only at the end) or -1 on error. */
+int32 zframe_read(struct zframe_file *zf, OFF_T offset, char *buf, int32 len)
+{
+	int32 done = 0;
+
+	while (done < len && offset < zf->size) {
+		int32 i = (int32)(offset / zf->frame_size);
+		int32 skip = (int32)(offset - (OFF_T)i * zf->frame_size);
+		int32 n;
+		if (i != zf->cur && load_frame(zf, i) < 0)
+			return -1;
+		n = MIN(zf->frame_len - skip, len - done);
+		memcpy(buf + done, zf->frame + skip, n);
+		done += n;
+		offset += n;
+	}
+
+	return done;
+}